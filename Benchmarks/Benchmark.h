@@ -0,0 +1,95 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ====
+#include <chrono>
+#include <string>
+#include <vector>
+//===============
+
+namespace Directus
+{
+	class Context;
+}
+
+namespace Benchmarks
+{
+	// Called with whatever followed the benchmark's name on the command line
+	typedef void(*BenchmarkFunction)(const std::vector<std::string>& arguments);
+
+	struct BenchmarkEntry
+	{
+		std::string name;
+		BenchmarkFunction function;
+	};
+
+	// Every benchmark linked into the executable, in registration order
+	std::vector<BenchmarkEntry>& GetBenchmarks();
+
+	// Creates and initializes the engine on the first call, against a hidden window, for the
+	// benchmarks which need the full set of subsystems (e.g. scenes and prefabs).
+	Directus::Context* GetEngineContext();
+
+	// Prints "  label: value unit"
+	void Report(const std::string& label, double value, const std::string& unit);
+
+	class Registrar
+	{
+	public:
+		Registrar(const char* name, BenchmarkFunction function) { GetBenchmarks().push_back({ name, function }); }
+	};
+
+	class Stopwatch
+	{
+	public:
+		Stopwatch() { Restart(); }
+		void Restart() { m_start = std::chrono::high_resolution_clock::now(); }
+		double GetMilliseconds() const { return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - m_start).count(); }
+		double GetNanoseconds() const { return std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - m_start).count(); }
+
+	private:
+		std::chrono::high_resolution_clock::time_point m_start;
+	};
+
+	// Runs the function a few times and returns the fastest run, in milliseconds
+	template <typename Function>
+	double Measure(int runs, Function&& function)
+	{
+		double fastest = 0.0;
+		for (int i = 0; i < runs; i++)
+		{
+			Stopwatch stopwatch;
+			function();
+			double elapsed = stopwatch.GetMilliseconds();
+			fastest = (i == 0 || elapsed < fastest) ? elapsed : fastest;
+		}
+
+		return fastest;
+	}
+}
+
+// Defines and registers a benchmark, e.g. BENCHMARK(TaskThroughput) { ... }
+#define BENCHMARK(name)																		\
+	static void Benchmark_##name(const std::vector<std::string>& arguments);				\
+	static Benchmarks::Registrar g_registrar_##name(#name, &Benchmark_##name);				\
+	static void Benchmark_##name(const std::vector<std::string>& arguments)
\ No newline at end of file
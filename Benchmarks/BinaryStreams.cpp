@@ -0,0 +1,221 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ====================
+#include "Benchmark.h"
+#include <fstream>
+#include "IO/BinaryWriter.h"
+#include "IO/BinaryReader.h"
+#include "Graphics/Vertex.h"
+#include "FileSystem/FileSystem.h"
+//===============================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+namespace
+{
+	// How files used to be written and read, one stream call per field
+	class LegacyWriter
+	{
+	public:
+		LegacyWriter(const string& filePath) { m_out.open(filePath, ios::out | ios::binary); }
+		void WriteBool(bool value) { m_out.write(reinterpret_cast<char*>(&value), sizeof(value)); }
+		void WriteInt(int value) { m_out.write(reinterpret_cast<char*>(&value), sizeof(value)); }
+		void WriteFloat(float value) { m_out.write(reinterpret_cast<char*>(&value), sizeof(value)); }
+		void WriteSTR(const string& value)
+		{
+			WriteInt((int)value.size());
+			m_out.write(value.c_str(), value.size());
+		}
+
+	private:
+		ofstream m_out;
+	};
+
+	class LegacyReader
+	{
+	public:
+		LegacyReader(const string& filePath) { m_in.open(filePath, ios::in | ios::binary); }
+		bool ReadBool() { bool value = false; m_in.read(reinterpret_cast<char*>(&value), sizeof(value)); return value; }
+		int ReadInt() { int value = 0; m_in.read(reinterpret_cast<char*>(&value), sizeof(value)); return value; }
+		float ReadFloat() { float value = 0.0f; m_in.read(reinterpret_cast<char*>(&value), sizeof(value)); return value; }
+		string ReadSTR()
+		{
+			string value;
+			value.resize(ReadInt());
+			m_in.read(&value[0], value.size());
+			return value;
+		}
+
+	private:
+		ifstream m_in;
+	};
+
+	const int OBJECT_COUNT = 200000;
+	const int VERTEX_COUNT = 1000000;
+	const int INDEX_COUNT = 3000000;
+
+	// Roughly what a GameObject and its transform write
+	template <class Writer>
+	void WriteObjects(Writer& writer)
+	{
+		string name = "GameObject_name";
+		for (int i = 0; i < OBJECT_COUNT; i++)
+		{
+			writer.WriteBool(true);
+			writer.WriteBool(true);
+			writer.WriteSTR(name);
+			writer.WriteInt(i);
+			for (int j = 0; j < 10; j++)
+			{
+				writer.WriteFloat(1.0f);
+			}
+			writer.WriteSTR(name);
+		}
+	}
+
+	template <class Reader>
+	double ReadObjects(Reader& reader)
+	{
+		double sum = 0.0;
+		for (int i = 0; i < OBJECT_COUNT; i++)
+		{
+			sum += reader.ReadBool();
+			sum += reader.ReadBool();
+			sum += reader.ReadSTR().size();
+			sum += reader.ReadInt();
+			for (int j = 0; j < 10; j++)
+			{
+				sum += reader.ReadFloat();
+			}
+			sum += reader.ReadSTR().size();
+		}
+
+		return sum;
+	}
+}
+
+BENCHMARK(BinaryStreams)
+{
+	string filePath = "Benchmark_BinaryStreams.bin";
+	Benchmarks::Stopwatch stopwatch;
+	double sum = 0.0;
+
+	// Many small fields
+	{
+		LegacyWriter writer(filePath);
+		WriteObjects(writer);
+	}
+	Benchmarks::Report("objects, write, per field", stopwatch.GetMilliseconds(), "ms");
+
+	stopwatch.Restart();
+	{
+		LegacyReader reader(filePath);
+		sum += ReadObjects(reader);
+	}
+	Benchmarks::Report("objects, read, per field", stopwatch.GetMilliseconds(), "ms");
+
+	stopwatch.Restart();
+	{
+		BinaryWriter writer;
+		WriteObjects(writer);
+		writer.SaveToFile(filePath);
+	}
+	Benchmarks::Report("objects, write, buffered", stopwatch.GetMilliseconds(), "ms");
+
+	stopwatch.Restart();
+	{
+		BinaryReader reader;
+		reader.LoadFromFile(filePath);
+		sum += ReadObjects(reader);
+	}
+	Benchmarks::Report("objects, read, buffered", stopwatch.GetMilliseconds(), "ms");
+
+	// A large mesh
+	vector<VertexPosTexNorTan> vertices(VERTEX_COUNT);
+	vector<unsigned int> indices(INDEX_COUNT, 7);
+
+	stopwatch.Restart();
+	{
+		LegacyWriter writer(filePath);
+		for (const auto& vertex : vertices)
+		{
+			const float* floats = &vertex.position.x;
+			for (size_t i = 0; i < sizeof(VertexPosTexNorTan) / sizeof(float); i++)
+			{
+				writer.WriteFloat(floats[i]);
+			}
+		}
+		for (auto index : indices)
+		{
+			writer.WriteInt(index);
+		}
+	}
+	Benchmarks::Report("mesh, write, per field", stopwatch.GetMilliseconds(), "ms");
+
+	stopwatch.Restart();
+	{
+		LegacyReader reader(filePath);
+		vector<VertexPosTexNorTan> readVertices(VERTEX_COUNT);
+		vector<unsigned int> readIndices(INDEX_COUNT);
+		for (auto& vertex : readVertices)
+		{
+			float* floats = &vertex.position.x;
+			for (size_t i = 0; i < sizeof(VertexPosTexNorTan) / sizeof(float); i++)
+			{
+				floats[i] = reader.ReadFloat();
+			}
+		}
+		for (auto& index : readIndices)
+		{
+			index = reader.ReadInt();
+		}
+		sum += readIndices.back();
+	}
+	Benchmarks::Report("mesh, read, per field", stopwatch.GetMilliseconds(), "ms");
+
+	stopwatch.Restart();
+	{
+		BinaryWriter writer;
+		writer.WriteArray(vertices.data(), vertices.size());
+		writer.WriteArray(indices.data(), indices.size());
+		writer.SaveToFile(filePath);
+	}
+	Benchmarks::Report("mesh, write, WriteArray", stopwatch.GetMilliseconds(), "ms");
+
+	stopwatch.Restart();
+	{
+		BinaryReader reader;
+		reader.LoadFromFile(filePath);
+		vector<VertexPosTexNorTan> readVertices(VERTEX_COUNT);
+		vector<unsigned int> readIndices(INDEX_COUNT);
+		reader.ReadArray(readVertices.data(), readVertices.size());
+		reader.ReadArray(readIndices.data(), readIndices.size());
+		sum += readIndices.back();
+	}
+	Benchmarks::Report("mesh, read, ReadArray", stopwatch.GetMilliseconds(), "ms");
+
+	Benchmarks::Report("checksum", sum, "");
+	FileSystem::DeleteFile_(filePath);
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ========================
+#include "Benchmark.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include "IO/BinaryWriter.h"
+#include "IO/BinaryReader.h"
+#include "IO/BlockCompression.h"
+#include "Graphics/Vertex.h"
+#include "Math/Quaternion.h"
+#include "Threading/Threading.h"
+#include "FileSystem/FileSystem.h"
+//===================================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Directus;
+using namespace Directus::Math;
+//============================
+
+namespace
+{
+	struct Asset
+	{
+		string name;
+		vector<char> data; // uncompressed
+	};
+
+	// A 512x512 terrain, smooth positions and normals like most meshes
+	Asset GenerateMesh()
+	{
+		const int size = 512;
+		vector<VertexPosTexNorTan> vertices;
+		vertices.reserve(size * size);
+		for (int z = 0; z < size; z++)
+		{
+			for (int x = 0; x < size; x++)
+			{
+				float height = sinf(x * 0.05f) * cosf(z * 0.05f) * 10.0f;
+				VertexPosTexNorTan vertex;
+				vertex.position = Vector3((float)x, height, (float)z);
+				vertex.uv = Vector2(x / float(size), z / float(size));
+				vertex.normal = Vector3(0.0f, 1.0f, 0.0f);
+				vertex.tangent = Vector3(1.0f, 0.0f, 0.0f);
+				vertices.push_back(vertex);
+			}
+		}
+
+		vector<unsigned int> indices;
+		indices.reserve((size - 1) * (size - 1) * 6);
+		for (int z = 0; z < size - 1; z++)
+		{
+			for (int x = 0; x < size - 1; x++)
+			{
+				unsigned int i = z * size + x;
+				unsigned int quad[6] = { i, i + size, i + 1, i + 1, i + size, i + size + 1 };
+				indices.insert(indices.end(), quad, quad + 6);
+			}
+		}
+
+		BinaryWriter writer;
+		writer.WriteArray(vertices.data(), vertices.size());
+		writer.WriteArray(indices.data(), indices.size());
+		return Asset{ "generated mesh", vector<char>(writer.GetData(), writer.GetData() + writer.GetSize()) };
+	}
+
+	// 50k GameObjects with a transform each, about what a scene file holds
+	Asset GenerateScene()
+	{
+		BinaryWriter writer;
+		for (int i = 0; i < 50000; i++)
+		{
+			writer.WriteBool(false);
+			writer.WriteBool(true);
+			writer.WriteBool(true);
+			writer.WriteSTR(to_string(1000 + i));
+			writer.WriteSTR("GameObject_" + to_string(i % 100));
+			writer.WriteInt(1);
+			writer.WriteSTR("Transform");
+			writer.WriteVector3(Vector3(float(i % 100), 0.0f, float(i / 100)));
+			writer.WriteQuaternion(Quaternion(0.0f, 0.0f, 0.0f, 1.0f));
+			writer.WriteVector3(Vector3(1.0f, 1.0f, 1.0f));
+			writer.WriteSTR(i % 10 ? to_string(1000 + i - i % 10) : string("-1"));
+		}
+
+		return Asset{ "generated scene", vector<char>(writer.GetData(), writer.GetData() + writer.GetSize()) };
+	}
+
+	bool WriteFile(const string& filePath, const vector<char>& data)
+	{
+		ofstream out(filePath, ios::out | ios::binary);
+		out.write(data.data(), data.size());
+		return !out.fail();
+	}
+
+	void Run(const Asset& asset, Threading& threading)
+	{
+		const int runs = 5;
+		vector<char> compressed;
+		vector<char> decompressed;
+
+		double compressSerial = Benchmarks::Measure(runs, [&] { BlockCompression::Compress(asset.data.data(), asset.data.size(), compressed); });
+		double compressParallel = Benchmarks::Measure(runs, [&] { BlockCompression::Compress(asset.data.data(), asset.data.size(), compressed, &threading); });
+		double decompressSerial = Benchmarks::Measure(runs, [&] { BlockCompression::Decompress(compressed.data(), compressed.size(), decompressed); });
+		double decompressParallel = Benchmarks::Measure(runs, [&] { BlockCompression::Decompress(compressed.data(), compressed.size(), decompressed, &threading); });
+		if (decompressed != asset.data)
+		{
+			printf("  %s: the data didn't survive a round trip\n", asset.name.c_str());
+			return;
+		}
+
+		// What a load costs, with the file in the OS cache
+		string rawPath = "Benchmark_Compression.raw";
+		string compressedPath = "Benchmark_Compression.compressed";
+		WriteFile(rawPath, asset.data);
+		WriteFile(compressedPath, compressed);
+		double loadRaw = Benchmarks::Measure(runs, [&] { BinaryReader reader; reader.LoadFromFile(rawPath, &threading); });
+		double loadCompressed = Benchmarks::Measure(runs, [&] { BinaryReader reader; reader.LoadFromFile(compressedPath, &threading); });
+		FileSystem::DeleteFile_(rawPath);
+		FileSystem::DeleteFile_(compressedPath);
+
+		string prefix = asset.name + ", ";
+		Benchmarks::Report(prefix + "size", asset.data.size() / 1024.0, "KB");
+		Benchmarks::Report(prefix + "compressed size", compressed.size() / 1024.0, "KB");
+		Benchmarks::Report(prefix + "ratio", double(asset.data.size()) / compressed.size(), ":1");
+		Benchmarks::Report(prefix + "compress, 1 thread", compressSerial, "ms");
+		Benchmarks::Report(prefix + "compress, all threads", compressParallel, "ms");
+		Benchmarks::Report(prefix + "decompress, 1 thread", decompressSerial, "ms");
+		Benchmarks::Report(prefix + "decompress, all threads", decompressParallel, "ms");
+		Benchmarks::Report(prefix + "load, uncompressed", loadRaw, "ms");
+		Benchmarks::Report(prefix + "load, compressed", loadCompressed, "ms");
+	}
+}
+
+// Usage: Compression [files...], the files (e.g. scenes, models and prefabs) are measured uncompressed,
+// whether they were saved compressed or not. Generated data is used if no file is given.
+BENCHMARK(Compression)
+{
+	vector<Asset> assets;
+	for (const auto& filePath : arguments)
+	{
+		BinaryReader reader;
+		if (!reader.LoadFromFile(filePath))
+		{
+			printf("  Failed to load %s\n", filePath.c_str());
+			continue;
+		}
+		assets.push_back(Asset{ FileSystem::GetFileNameFromFilePath(filePath), vector<char>(reader.GetData(), reader.GetData() + reader.GetSize()) });
+	}
+
+	if (arguments.empty())
+	{
+		assets.push_back(GenerateMesh());
+		assets.push_back(GenerateScene());
+	}
+
+	Threading threading(nullptr);
+	threading.Initialize();
+
+	size_t totalSize = 0;
+	size_t totalCompressed = 0;
+	for (const auto& asset : assets)
+	{
+		Run(asset, threading);
+
+		vector<char> compressed;
+		BlockCompression::Compress(asset.data.data(), asset.data.size(), compressed, &threading);
+		totalSize += asset.data.size();
+		totalCompressed += compressed.size();
+	}
+
+	if (totalCompressed > 0)
+	{
+		Benchmarks::Report("all assets, ratio", double(totalSize) / totalCompressed, ":1");
+	}
+}
\ No newline at end of file
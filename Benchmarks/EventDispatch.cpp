@@ -0,0 +1,147 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========================
+#include "Benchmark.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include "EventSystem/EventSystem.h"
+//=====================================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+namespace
+{
+	// How events used to be delivered, every fire walked every subscriber of every event
+	class LegacyEventSystem
+	{
+	public:
+		void Subscribe(int eventID, function<void()>&& function)
+		{
+			m_subscribers.push_back(make_shared<pair<int, std::function<void()>>>(eventID, move(function)));
+		}
+
+		void Fire(int eventID)
+		{
+			for (const auto& subscriber : m_subscribers)
+			{
+				if (subscriber->first == eventID)
+				{
+					subscriber->second();
+				}
+			}
+		}
+
+	private:
+		vector<shared_ptr<pair<int, function<void()>>>> m_subscribers;
+	};
+
+	struct BenchmarkEvent
+	{
+		int value;
+	};
+
+	// Past the engine's own events, below the typed ones
+	const int FIRST_EVENT = 16;
+	const int EVENT_COUNT = 48;
+	const int SUBSCRIBERS_PER_EVENT = 100;
+	const int FIRE_COUNT = 20000;
+}
+
+BENCHMARK(EventDispatch)
+{
+	long long calls = 0;
+	Benchmarks::Report("subscribers", EVENT_COUNT * SUBSCRIBERS_PER_EVENT, "");
+
+	// Fire, legacy
+	{
+		LegacyEventSystem eventSystem;
+		for (int i = 0; i < EVENT_COUNT * SUBSCRIBERS_PER_EVENT; i++)
+		{
+			eventSystem.Subscribe(FIRST_EVENT + i % EVENT_COUNT, [&calls] { calls++; });
+		}
+
+		Benchmarks::Stopwatch stopwatch;
+		for (int i = 0; i < FIRE_COUNT; i++)
+		{
+			eventSystem.Fire(FIRST_EVENT + i % EVENT_COUNT);
+		}
+		Benchmarks::Report("fire, single list", stopwatch.GetNanoseconds() / 1000.0 / FIRE_COUNT, "us");
+	}
+
+	// Fire, bucketed
+	vector<pair<int, SubscriptionID>> subscriptions;
+	for (int i = 0; i < EVENT_COUNT * SUBSCRIBERS_PER_EVENT; i++)
+	{
+		int eventID = FIRST_EVENT + i % EVENT_COUNT;
+		subscriptions.emplace_back(eventID, EventSystem::Subscribe(eventID, [&calls] { calls++; }));
+	}
+
+	Benchmarks::Stopwatch stopwatch;
+	for (int i = 0; i < FIRE_COUNT; i++)
+	{
+		EventSystem::Fire(FIRST_EVENT + i % EVENT_COUNT);
+	}
+	Benchmarks::Report("fire, bucketed", stopwatch.GetNanoseconds() / 1000.0 / FIRE_COUNT, "us");
+
+	for (const auto& subscription : subscriptions)
+	{
+		EventSystem::Unsubscribe(subscription.first, subscription.second);
+	}
+
+	// Typed events posted from several threads at once and dispatched on this one
+	const int producerCount = 4;
+	const int postsPerProducer = 200000;
+	long long received = 0;
+	SubscriptionID subscription = EventSystem::Subscribe<BenchmarkEvent>([&received](const BenchmarkEvent& event) { received += event.value; });
+
+	stopwatch.Restart();
+	vector<thread> producers;
+	for (int i = 0; i < producerCount; i++)
+	{
+		producers.emplace_back([]
+		{
+			for (int j = 0; j < postsPerProducer; j++)
+			{
+				EventSystem::Post(BenchmarkEvent{ 1 });
+			}
+		});
+	}
+
+	while (received < producerCount * postsPerProducer)
+	{
+		EventSystem::Dispatch();
+	}
+	for (auto& producer : producers)
+	{
+		producer.join();
+	}
+	Benchmarks::Report("post and dispatch, 4 threads", stopwatch.GetNanoseconds() / received, "ns per event");
+
+	EventSystem::Unsubscribe<BenchmarkEvent>(subscription);
+	Benchmarks::Report("calls", (double)calls, "");
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==============
+#include "Benchmark.h"
+#include <cstdio>
+#include <cstdlib>
+#include <Windows.h>
+#include "Core/Engine.h"
+#include "Core/Context.h"
+//=========================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+namespace Benchmarks
+{
+	static Engine* g_engine = nullptr;
+	static HWND g_window = nullptr;
+
+	vector<BenchmarkEntry>& GetBenchmarks()
+	{
+		static vector<BenchmarkEntry> benchmarks;
+		return benchmarks;
+	}
+
+	Context* GetEngineContext()
+	{
+		if (g_engine)
+			return g_engine->GetContext();
+
+		// Never shown, it's only there because input and graphics need a window to initialize
+		HINSTANCE instance = GetModuleHandle(nullptr);
+		g_window = CreateWindowExA(0, "STATIC", "Benchmarks", WS_OVERLAPPEDWINDOW, 0, 0, 1280, 720, nullptr, nullptr, instance, nullptr);
+
+		g_engine = new Engine(new Context());
+		g_engine->SetHandles(instance, g_window, g_window);
+		if (!g_engine->Initialize())
+		{
+			printf("Failed to initialize the engine\n");
+			exit(1);
+		}
+
+		return g_engine->GetContext();
+	}
+
+	void Report(const string& label, double value, const string& unit)
+	{
+		printf("  %-48s %12.3f %s\n", (label + ":").c_str(), value, unit.c_str());
+	}
+}
+
+// Usage: Benchmarks [name [arguments...]], runs every benchmark if no name is given
+int main(int argc, char** argv)
+{
+	string filter = argc > 1 ? argv[1] : string();
+	vector<string> arguments;
+	for (int i = 2; i < argc; i++)
+	{
+		arguments.push_back(argv[i]);
+	}
+
+	int ran = 0;
+	for (const auto& benchmark : Benchmarks::GetBenchmarks())
+	{
+		if (!filter.empty() && benchmark.name != filter)
+			continue;
+
+		printf("%s\n", benchmark.name.c_str());
+		benchmark.function(arguments);
+		ran++;
+	}
+
+	if (ran == 0)
+	{
+		printf("No benchmark named \"%s\", available ones:\n", filter.c_str());
+		for (const auto& benchmark : Benchmarks::GetBenchmarks())
+		{
+			printf("  %s\n", benchmark.name.c_str());
+		}
+	}
+
+	if (Benchmarks::g_engine)
+	{
+		Benchmarks::g_engine->Shutdown();
+		delete Benchmarks::g_engine;
+		DestroyWindow(Benchmarks::g_window);
+	}
+
+	return ran == 0 ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "Benchmark.h"
+#include <cmath>
+#include <thread>
+#include <algorithm>
+#include "Threading/Threading.h"
+//=================================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+namespace
+{
+	struct Sphere { float x, y, z, radius; };
+	struct Plane { float a, b, c, d; };
+
+	// Roughly what culling costs per renderable, a sphere against the six frustum planes
+	bool IsVisible(const Sphere& sphere, const Plane* planes)
+	{
+		for (int i = 0; i < 6; i++)
+		{
+			const Plane& plane = planes[i];
+			if (plane.a * sphere.x + plane.b * sphere.y + plane.c * sphere.z + plane.d < -sphere.radius)
+				return false;
+		}
+
+		return true;
+	}
+
+	// Stands in for a transform update, a few dozen flops per element
+	float Transform(float value)
+	{
+		float result = value;
+		for (int i = 0; i < 16; i++)
+		{
+			result = result * 0.5f + sqrtf(result + 1.0f);
+		}
+
+		return result;
+	}
+}
+
+BENCHMARK(ParallelFor)
+{
+	const size_t count = 1000000;
+	const int runs = 5;
+
+	vector<Sphere> spheres(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		spheres[i] = { float(i % 1000), float((i / 1000) % 1000), float(i % 7), 1.0f };
+	}
+	Plane planes[6] = { { 1, 0, 0, 0 }, { -1, 0, 0, 800 }, { 0, 1, 0, 0 }, { 0, -1, 0, 800 }, { 0, 0, 1, 0 }, { 0, 0, -1, 1000 } };
+	vector<char> visible(count);
+	vector<float> values(count, 1.0f);
+
+	// One thread means a plain loop, N threads means N - 1 workers plus the calling thread
+	double serialCulling = Benchmarks::Measure(runs, [&]
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			visible[i] = IsVisible(spheres[i], planes);
+		}
+	});
+	double serialUpdate = Benchmarks::Measure(runs, [&]
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			values[i] = Transform(values[i]);
+		}
+	});
+	double serialReduce = Benchmarks::Measure(runs, [&]
+	{
+		size_t visibleCount = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			visibleCount += IsVisible(spheres[i], planes) ? 1 : 0;
+		}
+		visible[0] = visibleCount > 0;
+	});
+	Benchmarks::Report("1 thread, culling", serialCulling, "ms");
+	Benchmarks::Report("1 thread, update", serialUpdate, "ms");
+	Benchmarks::Report("1 thread, reduce", serialReduce, "ms");
+
+	int maxThreads = max((int)thread::hardware_concurrency(), 2);
+	vector<int> threadCounts;
+	for (int threads = 2; threads < maxThreads; threads *= 2)
+	{
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(maxThreads);
+
+	for (int threads : threadCounts)
+	{
+		Threading threading(nullptr, threads - 1);
+		threading.Initialize();
+
+		double culling = Benchmarks::Measure(runs, [&]
+		{
+			threading.ParallelFor(0, count, 128, [&](size_t i)
+			{
+				visible[i] = IsVisible(spheres[i], planes);
+			});
+		});
+		double update = Benchmarks::Measure(runs, [&]
+		{
+			threading.ParallelFor(0, count, 128, [&](size_t i)
+			{
+				values[i] = Transform(values[i]);
+			});
+		});
+		double reduce = Benchmarks::Measure(runs, [&]
+		{
+			size_t visibleCount = threading.ParallelReduce(0, count, 1024, size_t(0), [&](size_t begin, size_t end)
+			{
+				size_t chunkCount = 0;
+				for (size_t i = begin; i < end; i++)
+				{
+					chunkCount += IsVisible(spheres[i], planes) ? 1 : 0;
+				}
+				return chunkCount;
+			}, [](size_t a, size_t b) { return a + b; });
+			visible[0] = visibleCount > 0;
+		});
+
+		string prefix = to_string(threads) + " threads, ";
+		Benchmarks::Report(prefix + "culling", culling, "ms");
+		Benchmarks::Report(prefix + "update", update, "ms");
+		Benchmarks::Report(prefix + "reduce", reduce, "ms");
+		Benchmarks::Report(prefix + "culling speedup", serialCulling / culling, "x");
+		Benchmarks::Report(prefix + "update speedup", serialUpdate / update, "x");
+		Benchmarks::Report(prefix + "reduce speedup", serialReduce / reduce, "x");
+	}
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "Benchmark.h"
+#include <cstdio>
+#include "Core/Context.h"
+#include "Core/Scene.h"
+#include "Core/GameObject.h"
+#include "Core/Prefab.h"
+#include "Components/Transform.h"
+#include "Components/MeshFilter.h"
+#include "Components/MeshRenderer.h"
+#include "FileSystem/FileSystem.h"
+//=================================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+namespace
+{
+	const int INSTANCE_COUNT = 10000;
+	const int CHILD_COUNT = 7;
+
+	// A prop made of a few cubes, each with a mesh and a material
+	GameObject* CreateProp(Scene* scene)
+	{
+		auto root = scene->CreateGameObject().lock();
+		root->SetName("Prop");
+		root->AddComponent<MeshFilter>()->SetMesh(MeshFilter::Cube);
+		root->AddComponent<MeshRenderer>()->SetMaterialByType(Material_Basic);
+
+		for (int i = 0; i < CHILD_COUNT; i++)
+		{
+			auto child = scene->CreateGameObject().lock();
+			child->SetName("Part_" + to_string(i));
+			child->AddComponent<MeshFilter>()->SetMesh(MeshFilter::Cube);
+			child->AddComponent<MeshRenderer>()->SetMaterialByType(Material_Basic);
+			child->GetTransform()->SetParent(root->GetTransform());
+		}
+
+		return root.get();
+	}
+}
+
+BENCHMARK(PrefabInstancing)
+{
+	Context* context = Benchmarks::GetEngineContext();
+	Scene* scene = context->GetSubsystem<Scene>();
+	scene->Clear();
+
+	string filePath = "Benchmark_Prop";
+	string prefabFilePath = filePath + PREFAB_EXTENSION;
+	if (!CreateProp(scene)->SaveAsPrefab(filePath))
+	{
+		printf("  Failed to save %s\n", prefabFilePath.c_str());
+		return;
+	}
+	scene->Clear();
+
+	// How instancing used to work, the file gets opened and parsed for every instance
+	const int parsingCount = INSTANCE_COUNT / 10;
+	Benchmarks::Stopwatch stopwatch;
+	for (int i = 0; i < parsingCount; i++)
+	{
+		Prefab prefab(context);
+		prefab.LoadFromFile(prefabFilePath);
+		prefab.Instantiate(scene->CreateGameObject().lock().get());
+	}
+	Benchmarks::Report("parse per instance", stopwatch.GetNanoseconds() / 1000.0 / parsingCount, "us per instance");
+	scene->Clear();
+
+	stopwatch.Restart();
+	for (int i = 0; i < INSTANCE_COUNT; i++)
+	{
+		scene->CreateGameObject().lock()->LoadFromPrefab(prefabFilePath);
+	}
+	double elapsed = stopwatch.GetMilliseconds();
+	Benchmarks::Report("template, 10k instances", elapsed, "ms");
+	Benchmarks::Report("template", elapsed * 1000.0 / INSTANCE_COUNT, "us per instance");
+	Benchmarks::Report("GameObjects", scene->GetGameObjectCount(), "");
+
+	scene->Clear();
+	FileSystem::DeleteFile_(prefabFilePath);
+}
\ No newline at end of file
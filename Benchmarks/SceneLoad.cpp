@@ -0,0 +1,164 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ====================
+#include "Benchmark.h"
+#include <cstdio>
+#include "Core/Context.h"
+#include "Core/Scene.h"
+#include "Core/GameObject.h"
+#include "Components/Transform.h"
+#include "FileSystem/FileSystem.h"
+//===============================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+namespace
+{
+	const int ROOT_COUNT = 5000;
+	const int CHILDREN_PER_ROOT = 9;
+
+	// How GameObjects used to be found, a scan over the whole scene
+	GameObject* FindByIDScanning(Scene* scene, unsigned long long ID)
+	{
+		for (const auto& gameObject : scene->GetAllGameObjects())
+		{
+			if (gameObject->GetID() == ID)
+				return gameObject.get();
+		}
+
+		return nullptr;
+	}
+
+	GameObject* FindByNameScanning(Scene* scene, const string& name)
+	{
+		for (const auto& gameObject : scene->GetAllGameObjects())
+		{
+			if (gameObject->GetName() == name)
+				return gameObject.get();
+		}
+
+		return nullptr;
+	}
+
+	void BuildScene(Scene* scene)
+	{
+		scene->Clear();
+		for (int i = 0; i < ROOT_COUNT; i++)
+		{
+			auto root = scene->CreateGameObject().lock();
+			root->SetName("Root_" + to_string(i));
+
+			for (int j = 0; j < CHILDREN_PER_ROOT; j++)
+			{
+				auto child = scene->CreateGameObject().lock();
+				child->SetName("Child_" + to_string(i) + "_" + to_string(j));
+				child->GetTransform()->SetParent(root->GetTransform());
+			}
+		}
+		scene->UpdateTransforms();
+	}
+}
+
+// Usage: SceneLoad [scene file], saves and loads a generated scene of 50k GameObjects if no file is given
+BENCHMARK(SceneLoad)
+{
+	Scene* scene = Benchmarks::GetEngineContext()->GetSubsystem<Scene>();
+
+	string filePath = arguments.empty() ? string("Benchmark_SceneLoad") + SCENE_EXTENSION : arguments[0];
+	if (arguments.empty())
+	{
+		Benchmarks::Stopwatch stopwatch;
+		BuildScene(scene);
+		Benchmarks::Report("build", stopwatch.GetMilliseconds(), "ms");
+
+		stopwatch.Restart();
+		scene->SaveToFile(filePath);
+		Benchmarks::Report("save", stopwatch.GetMilliseconds(), "ms");
+	}
+
+	Benchmarks::Stopwatch stopwatch;
+	if (!scene->LoadFromFile(filePath))
+	{
+		printf("  Failed to load %s\n", filePath.c_str());
+		return;
+	}
+	Benchmarks::Report("load", stopwatch.GetMilliseconds(), "ms");
+	Benchmarks::Report("GameObjects", scene->GetGameObjectCount(), "");
+
+	// Every GameObject is looked up once, by ID and by name
+	vector<unsigned long long> IDs;
+	vector<string> names;
+	for (const auto& gameObject : scene->GetAllGameObjects())
+	{
+		IDs.push_back(gameObject->GetID());
+		names.push_back(gameObject->GetName());
+	}
+
+	size_t found = 0;
+	stopwatch.Restart();
+	for (auto ID : IDs)
+	{
+		found += scene->GetGameObjectByID(ID).expired() ? 0 : 1;
+	}
+	Benchmarks::Report("lookup by ID, index", stopwatch.GetNanoseconds() / IDs.size(), "ns");
+
+	stopwatch.Restart();
+	for (const auto& name : names)
+	{
+		found += scene->GetGameObjectByName(name).expired() ? 0 : 1;
+	}
+	Benchmarks::Report("lookup by name, index", stopwatch.GetNanoseconds() / names.size(), "ns");
+
+	// The scans are quadratic over the whole scene, a sample is enough
+	const size_t sampleStride = 100;
+	size_t sampleCount = 0;
+	stopwatch.Restart();
+	for (size_t i = 0; i < IDs.size(); i += sampleStride, sampleCount++)
+	{
+		found += FindByIDScanning(scene, IDs[i]) ? 1 : 0;
+	}
+	Benchmarks::Report("lookup by ID, scan", stopwatch.GetNanoseconds() / sampleCount, "ns");
+
+	stopwatch.Restart();
+	for (size_t i = 0; i < names.size(); i += sampleStride)
+	{
+		found += FindByNameScanning(scene, names[i]) ? 1 : 0;
+	}
+	Benchmarks::Report("lookup by name, scan", stopwatch.GetNanoseconds() / sampleCount, "ns");
+	Benchmarks::Report("found", (double)found, "");
+
+	// Half of the roots, with their children, in one go
+	vector<weakGameObj> roots = scene->GetRootGameObjects();
+	roots.resize(roots.size() / 2);
+	stopwatch.Restart();
+	scene->RemoveGameObjects(roots);
+	Benchmarks::Report("remove half", stopwatch.GetMilliseconds(), "ms");
+
+	scene->Clear();
+	if (arguments.empty())
+	{
+		FileSystem::DeleteFile_(filePath);
+	}
+}
\ No newline at end of file
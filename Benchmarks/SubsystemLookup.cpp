@@ -0,0 +1,107 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==============
+#include "Benchmark.h"
+#include <typeinfo>
+#include "Core/Context.h"
+//=========================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+namespace
+{
+	// As many as the engine registers, each one a distinct type
+	template <int Index>
+	class DummySubsystem : public Subsystem
+	{
+	public:
+		DummySubsystem(Context* context) : Subsystem(context) {}
+		virtual bool Initialize() { return true; }
+	};
+
+	// How Context::GetSubsystem() used to find a subsystem, a scan comparing RTTI
+	class ScanningContext
+	{
+	public:
+		void RegisterSubsystem(Subsystem* subsystem) { m_subsystems.push_back(subsystem); }
+
+		template <class T>
+		T* GetSubsystem()
+		{
+			for (const auto& subsystem : m_subsystems)
+			{
+				if (typeid(T) == typeid(*subsystem))
+					return static_cast<T*>(subsystem);
+			}
+
+			return nullptr;
+		}
+
+	private:
+		vector<Subsystem*> m_subsystems;
+	};
+
+	template <typename Function>
+	double NanosecondsPerCall(Function&& function)
+	{
+		const int calls = 10000000;
+		return Benchmarks::Measure(3, [&]
+		{
+			for (int i = 0; i < calls; i++)
+			{
+				function();
+			}
+		}) * 1000000.0 / calls;
+	}
+}
+
+BENCHMARK(SubsystemLookup)
+{
+	Context context;
+	ScanningContext scanningContext;
+	vector<Subsystem*> subsystems =
+	{
+		new DummySubsystem<0>(&context), new DummySubsystem<1>(&context), new DummySubsystem<2>(&context),
+		new DummySubsystem<3>(&context), new DummySubsystem<4>(&context), new DummySubsystem<5>(&context),
+		new DummySubsystem<6>(&context), new DummySubsystem<7>(&context), new DummySubsystem<8>(&context),
+		new DummySubsystem<9>(&context), new DummySubsystem<10>(&context), new DummySubsystem<11>(&context)
+	};
+	for (auto subsystem : subsystems)
+	{
+		context.RegisterSubsystem(subsystem);
+		scanningContext.RegisterSubsystem(subsystem);
+	}
+
+	volatile Subsystem* sink = nullptr;
+	Benchmarks::Report("RTTI scan, first subsystem", NanosecondsPerCall([&] { sink = scanningContext.GetSubsystem<DummySubsystem<0>>(); }), "ns");
+	Benchmarks::Report("RTTI scan, middle subsystem", NanosecondsPerCall([&] { sink = scanningContext.GetSubsystem<DummySubsystem<6>>(); }), "ns");
+	Benchmarks::Report("RTTI scan, last subsystem", NanosecondsPerCall([&] { sink = scanningContext.GetSubsystem<DummySubsystem<11>>(); }), "ns");
+	Benchmarks::Report("slot, first subsystem", NanosecondsPerCall([&] { sink = context.GetSubsystem<DummySubsystem<0>>(); }), "ns");
+	Benchmarks::Report("slot, middle subsystem", NanosecondsPerCall([&] { sink = context.GetSubsystem<DummySubsystem<6>>(); }), "ns");
+	Benchmarks::Report("slot, last subsystem", NanosecondsPerCall([&] { sink = context.GetSubsystem<DummySubsystem<11>>(); }), "ns");
+
+	// The context deletes all but the first one, which is normally the engine
+	delete subsystems[0];
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "Benchmark.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "Threading/Threading.h"
+//=================================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+// Counts every allocation made through operator new by this executable, which includes the
+// AddTask() templates as they are instantiated here. Runtime.dll allocates through its own
+// operator new, there that's only the pool growing by a block of tasks, which the warm-up
+// takes care of before anything is measured.
+static atomic<long long> g_allocationCount(0);
+
+void* operator new(size_t size)
+{
+	g_allocationCount.fetch_add(1, memory_order_relaxed);
+	void* memory = malloc(size ? size : 1);
+	if (!memory)
+		throw bad_alloc();
+	return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+namespace
+{
+	// Adds taskCount tasks made by makeTask(), in batches which are waited for, and reports
+	// nanoseconds and allocations per task.
+	template <typename MakeTask>
+	void Run(const string& label, Threading& threading, int taskCount, MakeTask makeTask)
+	{
+		const int batchSize = 1000;
+		vector<TaskHandle> handles;
+		handles.reserve(batchSize);
+
+		auto runBatches = [&](int batches)
+		{
+			for (int i = 0; i < batches; i++)
+			{
+				for (int j = 0; j < batchSize; j++)
+				{
+					handles.push_back(threading.AddTask(makeTask()));
+				}
+				threading.WaitAll(handles);
+				handles.clear();
+			}
+		};
+
+		// Fills the task pool and the per-thread caches
+		runBatches(taskCount / batchSize / 10);
+
+		long long allocationsBefore = g_allocationCount.load();
+		Benchmarks::Stopwatch stopwatch;
+		runBatches(taskCount / batchSize);
+		double nanoseconds = stopwatch.GetNanoseconds();
+		long long allocations = g_allocationCount.load() - allocationsBefore;
+
+		Benchmarks::Report(label + ", time per task", nanoseconds / taskCount, "ns");
+		Benchmarks::Report(label + ", allocations per task", double(allocations) / taskCount, "");
+	}
+}
+
+BENCHMARK(TaskAllocation)
+{
+	const int taskCount = 1000000;
+
+	Threading threading(nullptr);
+	threading.Initialize();
+
+	Run("empty tasks", threading, taskCount, [] { return [] {}; });
+
+	// Captures which fit in the task's inline storage
+	int value = 0;
+	int* pointer = &value;
+	Run("small captures", threading, taskCount, [pointer] { return [pointer] { (void)pointer; }; });
+
+	// Captures which don't fit, and so go to the heap, for comparison
+	struct Large { char bytes[Task::INLINE_SIZE * 2]; };
+	Large large = {};
+	Run("large captures", threading, taskCount, [large] { return [large] { (void)large; }; });
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "Benchmark.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include "Threading/Threading.h"
+//=================================
+
+//= NAMESPACES ==========
+using namespace std;
+using namespace Directus;
+//=======================
+
+namespace
+{
+	// The pool the work-stealing one replaced, kept here as the baseline: five threads
+	// sharing one mutex protected FIFO of heap allocated std::function tasks.
+	class MutexPool
+	{
+	public:
+		MutexPool()
+		{
+			for (int i = 0; i < 5; i++)
+			{
+				m_threads.emplace_back(thread(&MutexPool::Invoke, this));
+			}
+		}
+
+		~MutexPool()
+		{
+			unique_lock<mutex> lock(m_tasksMutex);
+			m_stopping = true;
+			lock.unlock();
+			m_conditionVar.notify_all();
+
+			for (auto& thread : m_threads)
+			{
+				thread.join();
+			}
+		}
+
+		template <typename Function>
+		void AddTask(Function&& task)
+		{
+			unique_lock<mutex> lock(m_tasksMutex);
+			m_tasks.push(make_shared<function<void()>>(std::forward<Function>(task)));
+			lock.unlock();
+			m_conditionVar.notify_one();
+		}
+
+	private:
+		void Invoke()
+		{
+			while (true)
+			{
+				unique_lock<mutex> lock(m_tasksMutex);
+				m_conditionVar.wait(lock, [this] { return !m_tasks.empty() || m_stopping; });
+				if (m_stopping && m_tasks.empty())
+					return;
+
+				auto task = m_tasks.front();
+				m_tasks.pop();
+				lock.unlock();
+
+				(*task)();
+			}
+		}
+
+		vector<thread> m_threads;
+		queue<shared_ptr<function<void()>>> m_tasks;
+		mutex m_tasksMutex;
+		condition_variable m_conditionVar;
+		bool m_stopping = false;
+	};
+
+	// Submits independent tasks from the calling thread, reports tasks per second and the average
+	// time from submission to the start of execution.
+	template <class Pool>
+	void RunFlat(const string& label, Pool& pool, int taskCount)
+	{
+		atomic<int> done(0);
+		atomic<long long> latency(0);
+
+		Benchmarks::Stopwatch stopwatch;
+		for (int i = 0; i < taskCount; i++)
+		{
+			auto submitted = chrono::high_resolution_clock::now();
+			pool.AddTask([&done, &latency, submitted]
+			{
+				latency += chrono::duration_cast<chrono::nanoseconds>(chrono::high_resolution_clock::now() - submitted).count();
+				done++;
+			});
+		}
+
+		while (done < taskCount)
+		{
+			this_thread::yield();
+		}
+		double seconds = stopwatch.GetMilliseconds() / 1000.0;
+
+		Benchmarks::Report(label + " throughput", taskCount / seconds, "tasks/s");
+		Benchmarks::Report(label + " latency", latency.load() / 1000.0 / taskCount, "us");
+	}
+
+	// Every task submits more tasks, the way import and load tasks fan out
+	template <class Pool>
+	void RunNested(const string& label, Pool& pool, int outer, int inner)
+	{
+		atomic<int> done(0);
+
+		Benchmarks::Stopwatch stopwatch;
+		for (int i = 0; i < outer; i++)
+		{
+			pool.AddTask([&pool, &done, inner]
+			{
+				for (int j = 0; j < inner; j++)
+				{
+					pool.AddTask([&done] { done++; });
+				}
+			});
+		}
+
+		while (done < outer * inner)
+		{
+			this_thread::yield();
+		}
+		double seconds = stopwatch.GetMilliseconds() / 1000.0;
+
+		Benchmarks::Report(label + " nested throughput", outer * inner / seconds, "tasks/s");
+	}
+}
+
+BENCHMARK(TaskThroughput)
+{
+	const int taskCount = 1000000;
+
+	{
+		MutexPool pool;
+		RunFlat("mutex pool", pool, taskCount);
+		RunNested("mutex pool", pool, 1000, 1000);
+	}
+
+	{
+		Threading threading(nullptr);
+		threading.Initialize();
+		Benchmarks::Report("work-stealing workers", threading.GetThreadCount(), "threads");
+		RunFlat("work-stealing", threading, taskCount);
+		RunNested("work-stealing", threading, 1000, 1000);
+	}
+}
\ No newline at end of file
@@ -195,7 +195,7 @@ void DirectusFileExplorer::dropEvent(QDropEvent* event)
     const QMimeData* mimeData = event->mimeData();
 
     //= DROP CASE: GAMEOBJECT ===========================================================================
-    std::string gameObjectID = mimeData->text().toStdString();
+    unsigned long long gameObjectID = mimeData->text().toULongLong();
     auto gameObject = m_directusCore->GetEngineSocket()->GetGameObjectByID(gameObjectID);
     if (!gameObject.expired())
     {
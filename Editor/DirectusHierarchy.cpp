@@ -135,7 +135,7 @@ void DirectusHierarchy::mouseMoveEvent(QMouseEvent* event)
     QDrag* drag = new QDrag(this);
     QMimeData* mimeData = new QMimeData;
 
-    QString gameObjectID = QString::fromStdString(draggedGameObject.lock()->GetID());
+    QString gameObjectID = QString::number(draggedGameObject.lock()->GetID());
     mimeData->setText(gameObjectID);
     drag->setMimeData(mimeData);
 
@@ -202,7 +202,7 @@ void DirectusHierarchy::dropEvent(QDropEvent* event)
     //================================================================
 
     //= DROP CASE: GAMEOBJECT (Assume text is a GameObject ID) =======
-    auto draggedGameObj = m_socket->GetGameObjectByID(text).lock();
+    auto draggedGameObj = m_socket->GetGameObjectByID(mime->text().toULongLong()).lock();
     QTreeWidgetItem* hoveredItem = this->itemAt(event->pos());
     auto dropTargetGameObj = ToGameObject(hoveredItem).lock();
 
@@ -286,7 +286,7 @@ weak_ptr<GameObject> DirectusHierarchy::ToGameObject(QTreeWidgetItem* treeItem)
         return weak_ptr<GameObject>();
 
     QVariant data = treeItem->data(0, Qt::UserRole);
-    string gameObjID = data.value<QString>().toStdString();
+    unsigned long long gameObjID = data.value<QString>().toULongLong();
     auto gameObj = m_socket->GetContext()->GetSubsystem<Scene>()->GetGameObjectByID(gameObjID);
 
     return gameObj;
@@ -305,7 +305,7 @@ QTreeWidgetItem* DirectusHierarchy::ToQTreeWidgetItem(weak_ptr<GameObject> gameO
     // Create a tree item
     QTreeWidgetItem* item = isRoot ? new QTreeWidgetItem(this) : new QTreeWidgetItem();
     item->setText(0, name);
-    item->setData(0, Qt::UserRole, QVariant(QString::fromStdString(gameObj.lock()->GetID())));
+    item->setData(0, Qt::UserRole, QVariant(QString::number(gameObj.lock()->GetID())));
 
     //= About Qt::UserRole ==============================================================
     // Constant     -> Qt::UserRole
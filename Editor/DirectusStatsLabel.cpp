@@ -22,8 +22,9 @@ void DirectusStatsLabel::UpdateStats(DirectusViewport* directusCore)
     string frame = "Frame: " + FormatFloat(socket->GetDeltaTime(), 2) + (" ms");
     string render = "Render: " + FormatFloat(socket->GetRenderTime(), 2) + (" ms");
     string meshes = "Meshes Rendered: " + to_string(socket->GetRenderedMeshesCount());
+    string workers = "Workers: " + FormatFloat(socket->GetWorkerUtilization() * 100.0f, 0) + ("%");
 
-    string finalText = fps + ", " + frame + ", " + render + ", " + meshes;
+    string finalText = fps + ", " + frame + ", " + render + ", " + meshes + ", " + workers;
     this->setText(QString::fromStdString(finalText));
 }
 
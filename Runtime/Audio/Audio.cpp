@@ -23,7 +23,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Audio.h"
 #include "fmod_errors.h"
 #include "../Logging/Log.h"
-#include "../EventSystem/EventSystem.h"
+#include "../Core/Context.h"
+#include "../Core/Scheduler.h"
 //=====================================
 
 //= NAMESPACES ======
@@ -47,8 +48,10 @@ namespace Directus
 		m_for = { 0, 0, -1 };
 		m_up = { 0, 1, 0 };
 
-		// Subscribe to update event
-		SUBSCRIBE_TO_EVENT(EVENT_UPDATE, this, Audio::Update);
+		// Reads the listener's transform, so it can't overlap with physics
+		m_context->GetSubsystem<Scheduler>()->AddJob("Audio", Stage_Update,
+			Frame_Transforms, Frame_Audio, false,
+			bind(&Audio::Update, this));
 	}
 
 	Audio::~Audio()
@@ -67,12 +67,12 @@ namespace Directus
 		m_audio->SetListenerTransform(g_transform);
 	}
 
-	void AudioListener::Serialize()
+	void AudioListener::Serialize(BinaryWriter* writer)
 	{
 
 	}
 
-	void AudioListener::Deserialize()
+	void AudioListener::Deserialize(BinaryReader* reader)
 	{
 
 	}
@@ -26,7 +26,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Core/Context.h"
 #include "../Audio/Audio.h"
 #include "../FileSystem/FileSystem.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
 //===================================
 
 //= NAMESPACES ================
@@ -105,28 +106,28 @@ namespace Directus
 		m_audioClip._Get()->Update();
 	}
 	
-	void AudioSource::Serialize()
+	void AudioSource::Serialize(BinaryWriter* writer)
 	{
-		StreamIO::WriteSTR(m_filePath);
-		StreamIO::WriteBool(m_mute);
-		StreamIO::WriteBool(m_playOnAwake);
-		StreamIO::WriteBool(m_loop);
-		StreamIO::WriteInt(m_priority);
-		StreamIO::WriteFloat(m_volume);
-		StreamIO::WriteFloat(m_pitch);
-		StreamIO::WriteFloat(m_pan);
+		writer->WriteSTR(m_filePath);
+		writer->WriteBool(m_mute);
+		writer->WriteBool(m_playOnAwake);
+		writer->WriteBool(m_loop);
+		writer->WriteInt(m_priority);
+		writer->WriteFloat(m_volume);
+		writer->WriteFloat(m_pitch);
+		writer->WriteFloat(m_pan);
 	}
 	
-	void AudioSource::Deserialize()
+	void AudioSource::Deserialize(BinaryReader* reader)
 	{
-		m_filePath = StreamIO::ReadSTR();
-		m_mute = StreamIO::ReadBool();
-		m_playOnAwake = StreamIO::ReadBool();
-		m_loop = StreamIO::ReadBool();
-		m_priority = StreamIO::ReadInt();
-		m_volume = StreamIO::ReadFloat();
-		m_pitch = StreamIO::ReadFloat();
-		m_pan = StreamIO::ReadFloat();
+		m_filePath = reader->ReadSTR();
+		m_mute = reader->ReadBool();
+		m_playOnAwake = reader->ReadBool();
+		m_loop = reader->ReadBool();
+		m_priority = reader->ReadInt();
+		m_volume = reader->ReadFloat();
+		m_pitch = reader->ReadFloat();
+		m_pan = reader->ReadFloat();
 	
 		LoadAudioClip(m_filePath);
 	}
@@ -43,8 +43,8 @@ namespace Directus
 		virtual void OnDisable();
 		virtual void Remove();
 		virtual void Update();
-		virtual void Serialize();
-		virtual void Deserialize();
+		virtual void Serialize(BinaryWriter* writer);
+		virtual void Deserialize(BinaryReader* reader);
 		//=========================
 
 		//= PROPERTIES ======================================================================
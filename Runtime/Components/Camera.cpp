@@ -22,7 +22,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ========================
 #include "Camera.h"
 #include "Transform.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
 #include "../Core/Settings.h"
 #include "../Components/MeshFilter.h"
 #include "../Components/Skybox.h"
@@ -110,22 +111,22 @@ namespace Directus
 		m_isDirty = false;
 	}
 
-	void Camera::Serialize()
+	void Camera::Serialize(BinaryWriter* writer)
 	{
-		StreamIO::WriteVector4(m_clearColor);
-		StreamIO::WriteInt(int(m_projection));
-		StreamIO::WriteFloat(m_fovHorizontal);
-		StreamIO::WriteFloat(m_nearPlane);
-		StreamIO::WriteFloat(m_farPlane);
+		writer->WriteVector4(m_clearColor);
+		writer->WriteInt(int(m_projection));
+		writer->WriteFloat(m_fovHorizontal);
+		writer->WriteFloat(m_nearPlane);
+		writer->WriteFloat(m_farPlane);
 	}
 
-	void Camera::Deserialize()
+	void Camera::Deserialize(BinaryReader* reader)
 	{
-		m_clearColor = StreamIO::ReadVector4();
-		m_projection = Projection(StreamIO::ReadInt());
-		m_fovHorizontal = StreamIO::ReadFloat();
-		m_nearPlane = StreamIO::ReadFloat();
-		m_farPlane = StreamIO::ReadFloat();
+		m_clearColor = reader->ReadVector4();
+		m_projection = Projection(reader->ReadInt());
+		m_fovHorizontal = reader->ReadFloat();
+		m_nearPlane = reader->ReadFloat();
+		m_farPlane = reader->ReadFloat();
 
 		CalculateBaseView();
 		CalculateViewMatrix();
@@ -32,7 +32,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "MeshFilter.h"
 #include "RigidBody.h"
 #include "../Core/GameObject.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
 #include "../Physics/BulletPhysicsHelper.h"
 #include "../Graphics/Mesh.h"
 //===========================================================
@@ -99,18 +100,18 @@ namespace Directus
 		}
 	}
 
-	void Collider::Serialize()
+	void Collider::Serialize(BinaryWriter* writer)
 	{
-		StreamIO::WriteInt(int(m_shapeType));
-		StreamIO::WriteVector3(m_extents);
-		StreamIO::WriteVector3(m_center);
+		writer->WriteInt(int(m_shapeType));
+		writer->WriteVector3(m_extents);
+		writer->WriteVector3(m_center);
 	}
 
-	void Collider::Deserialize()
+	void Collider::Deserialize(BinaryReader* reader)
 	{
-		m_shapeType = ColliderShape(StreamIO::ReadInt());
-		m_extents = StreamIO::ReadVector3();
-		m_center = StreamIO::ReadVector3();
+		m_shapeType = ColliderShape(reader->ReadInt());
+		m_extents = reader->ReadVector3();
+		m_center = reader->ReadVector3();
 
 		UpdateShape();
 	}
@@ -43,6 +43,9 @@ namespace Directus
 	class TexturePool;
 	class ShaderPool;
 	class Context;
+	class ComponentPoolBase;
+	class BinaryWriter;
+	class BinaryReader;
 
 	class DLL_API Component
 	{
@@ -68,10 +71,10 @@ namespace Directus
 		virtual void Update() = 0;
 
 		// Runs when the GameObject is being saved
-		virtual void Serialize() = 0;
+		virtual void Serialize(BinaryWriter* writer) = 0;
 
 		// Runs when the GameObject is being loaded
-		virtual void Deserialize() = 0;
+		virtual void Deserialize(BinaryReader* reader) = 0;
 
 		// Should be called by the derived component to register it's type
 		void Register()
@@ -95,5 +98,12 @@ namespace Directus
 		// The engine context
 		Context* g_context;	
 		//=============================================
+
+	private:
+		// Where the component lives, see ComponentPool
+		friend class GameObject;
+		template <class T> friend class ComponentPool;
+		ComponentPoolBase* m_pool = nullptr;
+		int m_poolIndex = 0;
 	};
 }
\ No newline at end of file
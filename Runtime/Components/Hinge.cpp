@@ -22,7 +22,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =================================================
 #include "Hinge.h"
 #include "RigidBody.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
 #include "../Core/Scene.h"
 #include "../Core/GameObject.h"
 #include "../Physics/Physics.h"
@@ -88,37 +89,37 @@ namespace Directus
 		m_isDirty = false;
 	}
 
-	void Hinge::Serialize()
+	void Hinge::Serialize(BinaryWriter* writer)
 	{
-		StreamIO::WriteBool(m_isConnected);
+		writer->WriteBool(m_isConnected);
 		if (m_isConnected)
 		{
 			if (!m_connectedGameObject.expired())
 			{
-				StreamIO::WriteSTR(m_connectedGameObject._Get()->GetID());
+				writer->WriteSTR(std::to_string(m_connectedGameObject._Get()->GetID()));
 			}
 		}
 
-		StreamIO::WriteVector3(m_axisA);
-		StreamIO::WriteVector3(m_axisB);
-		StreamIO::WriteVector3(m_pivotA);
-		StreamIO::WriteVector3(m_pivotB);
+		writer->WriteVector3(m_axisA);
+		writer->WriteVector3(m_axisB);
+		writer->WriteVector3(m_pivotA);
+		writer->WriteVector3(m_pivotB);
 	}
 
-	void Hinge::Deserialize()
+	void Hinge::Deserialize(BinaryReader* reader)
 	{
-		m_isConnected = StreamIO::ReadBool();
+		m_isConnected = reader->ReadBool();
 		if (m_isConnected)
 		{
 			// load gameobject
-			std::string gameObjectID = StreamIO::ReadSTR();
-			m_connectedGameObject = g_context->GetSubsystem<Scene>()->GetGameObjectByID(gameObjectID);
+			std::string gameObjectID = reader->ReadSTR();
+			m_connectedGameObject = g_context->GetSubsystem<Scene>()->GetGameObjectByID(GUIDGenerator::IDFromString(gameObjectID));
 		}
 
-		m_axisA = StreamIO::ReadVector3();
-		m_axisB = StreamIO::ReadVector3();
-		m_pivotA = StreamIO::ReadVector3();
-		m_pivotB = StreamIO::ReadVector3();
+		m_axisA = reader->ReadVector3();
+		m_axisB = reader->ReadVector3();
+		m_pivotA = reader->ReadVector3();
+		m_pivotB = reader->ReadVector3();
 
 		m_isDirty = true;
 	}
@@ -23,7 +23,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Light.h"
 #include "Transform.h"
 #include "Camera.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
 #include "../Core/Scene.h"
 #include "../Core/Settings.h"
 #include "../Core/Context.h"
@@ -147,26 +148,26 @@ namespace Directus
 
 	}
 
-	void Light::Serialize()
+	void Light::Serialize(BinaryWriter* writer)
 	{
-		StreamIO::WriteInt(int(m_lightType));
-		StreamIO::WriteInt(int(m_shadowType));
-		StreamIO::WriteVector4(m_color);
-		StreamIO::WriteFloat(m_range);
-		StreamIO::WriteFloat(m_intensity);
-		StreamIO::WriteFloat(m_angle);
-		StreamIO::WriteFloat(m_bias);
+		writer->WriteInt(int(m_lightType));
+		writer->WriteInt(int(m_shadowType));
+		writer->WriteVector4(m_color);
+		writer->WriteFloat(m_range);
+		writer->WriteFloat(m_intensity);
+		writer->WriteFloat(m_angle);
+		writer->WriteFloat(m_bias);
 	}
 
-	void Light::Deserialize()
+	void Light::Deserialize(BinaryReader* reader)
 	{
-		m_lightType = LightType(StreamIO::ReadInt());
-		m_shadowType = ShadowType(StreamIO::ReadInt());
-		m_color = StreamIO::ReadVector4();
-		m_range = StreamIO::ReadFloat();
-		m_intensity = StreamIO::ReadFloat();
-		m_angle = StreamIO::ReadFloat();
-		m_bias = StreamIO::ReadFloat();
+		m_lightType = LightType(reader->ReadInt());
+		m_shadowType = ShadowType(reader->ReadInt());
+		m_color = reader->ReadVector4();
+		m_range = reader->ReadFloat();
+		m_intensity = reader->ReadFloat();
+		m_angle = reader->ReadFloat();
+		m_bias = reader->ReadFloat();
 	}
 
 	void Light::SetLightType(LightType type)
@@ -47,12 +47,12 @@ namespace Directus
 
 	}
 
-	void LineRenderer::Serialize()
+	void LineRenderer::Serialize(BinaryWriter* writer)
 	{
 
 	}
 
-	void LineRenderer::Deserialize()
+	void LineRenderer::Deserialize(BinaryReader* reader)
 	{
 
 	}
@@ -27,7 +27,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <BulletCollision/CollisionShapes/btTriangleMesh.h>
 #include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
 #include <BulletCollision/CollisionShapes/btConvexHullShape.h>
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
 #include "../Core/GameObject.h"
 #include "../Logging/Log.h"
 #include "../Physics/BulletPhysicsHelper.h"
@@ -80,21 +81,21 @@ namespace Directus
 
 	}
 
-	void MeshCollider::Serialize()
+	void MeshCollider::Serialize(BinaryWriter* writer)
 	{
-		StreamIO::WriteBool(m_isConvex);
-		StreamIO::WriteSTR(!m_mesh.expired() ? m_mesh.lock()->GetID() : (string)DATA_NOT_ASSIGNED);
+		writer->WriteBool(m_isConvex);
+		writer->WriteSTR(!m_mesh.expired() ? m_mesh.lock()->GetID() : (string)DATA_NOT_ASSIGNED);
 	}
 
-	void MeshCollider::Deserialize()
+	void MeshCollider::Deserialize(BinaryReader* reader)
 	{
-		m_isConvex = StreamIO::ReadBool();
-		string meshID = StreamIO::ReadSTR();
+		m_isConvex = reader->ReadBool();
+		string meshID = reader->ReadSTR();
 
 		auto models = g_context->GetSubsystem<ResourceManager>()->GetResourcesByType<Model>();
 		for (const auto& model : models)
 		{
-			auto mesh = model.lock()->GetMeshByID(meshID);
+			auto mesh = model->GetMeshByID(meshID);
 			if (!mesh.expired())
 			{
 				m_mesh = mesh;
@@ -120,20 +121,23 @@ namespace Directus
 		//= contruct collider ========================================================================================
 		btTriangleMesh* trimesh = new btTriangleMesh();
 		vector<Vector3> vertices;
-		for (unsigned int i = 0; i < m_mesh.lock()->GetTriangleCount(); i++)
+		auto mesh = m_mesh.lock();
+		const VertexPosTexNorTan* meshVertices = mesh->GetVertexData();
+		const unsigned int* meshIndices = mesh->GetIndexData();
+		for (unsigned int i = 0; i < mesh->GetTriangleCount(); i++)
 		{
 
-			int index0 = m_mesh.lock()->GetIndices()[i * 3];
-			int index1 = m_mesh.lock()->GetIndices()[i * 3 + 1];
-			int index2 = m_mesh.lock()->GetIndices()[i * 3 + 2];
+			int index0 = meshIndices[i * 3];
+			int index1 = meshIndices[i * 3 + 1];
+			int index2 = meshIndices[i * 3 + 2];
 
-			vertices.push_back(m_mesh.lock()->GetVertices()[index0].position);
-			vertices.push_back(m_mesh.lock()->GetVertices()[index0].position);
-			vertices.push_back(m_mesh.lock()->GetVertices()[index0].position);
+			vertices.push_back(meshVertices[index0].position);
+			vertices.push_back(meshVertices[index0].position);
+			vertices.push_back(meshVertices[index0].position);
 
-			btVector3 vertex0 = ToBtVector3(m_mesh.lock()->GetVertices()[index0].position);
-			btVector3 vertex1 = ToBtVector3(m_mesh.lock()->GetVertices()[index1].position);
-			btVector3 vertex2 = ToBtVector3(m_mesh.lock()->GetVertices()[index2].position);
+			btVector3 vertex0 = ToBtVector3(meshVertices[index0].position);
+			btVector3 vertex1 = ToBtVector3(meshVertices[index1].position);
+			btVector3 vertex2 = ToBtVector3(meshVertices[index2].position);
 
 			trimesh->addTriangle(vertex0, vertex1, vertex2);
 		}
@@ -22,7 +22,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ===================================
 #include "MeshFilter.h"
 #include "Transform.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
 #include "../Core/GameObject.h"
 #include "../Logging/Log.h"
 #include "../FileSystem/FileSystem.h"
@@ -79,20 +80,20 @@ namespace Directus
 
 	}
 
-	void MeshFilter::Serialize()
+	void MeshFilter::Serialize(BinaryWriter* writer)
 	{
-		StreamIO::WriteInt((int)m_meshType);
-		StreamIO::WriteSTR(!m_mesh.expired() ? m_mesh._Get()->GetName() : (string)DATA_NOT_ASSIGNED);
-		StreamIO::WriteSTR(!m_mesh.expired() ? m_mesh._Get()->GetID() : (string)DATA_NOT_ASSIGNED);
-		StreamIO::WriteSTR(!m_mesh.expired() ? m_mesh._Get()->GetModelID() : (string)DATA_NOT_ASSIGNED);
+		writer->WriteInt((int)m_meshType);
+		writer->WriteSTR(!m_mesh.expired() ? m_mesh._Get()->GetName() : (string)DATA_NOT_ASSIGNED);
+		writer->WriteSTR(!m_mesh.expired() ? m_mesh._Get()->GetID() : (string)DATA_NOT_ASSIGNED);
+		writer->WriteSTR(!m_mesh.expired() ? m_mesh._Get()->GetModelID() : (string)DATA_NOT_ASSIGNED);
 	}
 
-	void MeshFilter::Deserialize()
+	void MeshFilter::Deserialize(BinaryReader* reader)
 	{
-		m_meshType = (MeshType)StreamIO::ReadInt();
-		string meshName = StreamIO::ReadSTR();
-		string meshID = StreamIO::ReadSTR();
-		string modelID = StreamIO::ReadSTR();
+		m_meshType = (MeshType)reader->ReadInt();
+		string meshName = reader->ReadSTR();
+		string meshID = reader->ReadSTR();
+		string modelID = reader->ReadSTR();
 
 		// If the mesh is a engine constructed primitive
 		if (m_meshType != Imported)
@@ -167,7 +168,7 @@ namespace Directus
 		shared_ptr<Model> modelShared = make_shared<Model>(g_context);
 		modelShared->SetRootGameObject(g_gameObject);
 		modelShared->SetResourceName(resourceName);
-		modelShared->AddMesh(g_gameObject._Get()->GetID(), meshName, vertices, indices);
+		modelShared->AddMesh(to_string(g_gameObject._Get()->GetID()), meshName, vertices, indices);
 
 		// Add the model to the resource manager and get it as a weak reference. It's important to do that
 		// because the resource manager will maintain it's own copy, thus any external references like
@@ -178,6 +179,23 @@ namespace Directus
 		return SetMesh(mesh);
 	}
 
+	bool MeshFilter::SetMeshShared(MeshType meshType, weak_ptr<Mesh> mesh, shared_ptr<D3D11VertexBuffer> vertexBuffer, shared_ptr<D3D11IndexBuffer> indexBuffer, const BoundingBox& boundingBox)
+	{
+		if (mesh.expired() || !vertexBuffer || !indexBuffer)
+			return false;
+
+		m_meshType = meshType;
+		m_mesh = mesh;
+		m_vertexBuffer = vertexBuffer;
+		m_indexBuffer = indexBuffer;
+		m_boundingBox = boundingBox;
+
+		// Get buffers of its own if the mesh ever updates
+		m_mesh._Get()->SubscribeToUpdate(bind(&MeshFilter::CreateBuffers, this));
+
+		return true;
+	}
+
 	// Set the buffers to active in the input assembler so they can be rendered.
 	bool MeshFilter::SetBuffers()
 	{
@@ -237,14 +255,14 @@ namespace Directus
 		m_indexBuffer.reset();
 
 		m_vertexBuffer = make_shared<D3D11VertexBuffer>(graphicsDevice);
-		if (!m_vertexBuffer->Create(m_mesh._Get()->GetVertices()))
+		if (!m_vertexBuffer->Create(m_mesh._Get()->GetVertexData(), m_mesh._Get()->GetVertexCount()))
 		{
 			LOG_ERROR("Failed to create vertex buffer \"" + GetGameObjectName() + "\".");
 			return false;
 		}
 
 		m_indexBuffer = make_shared<D3D11IndexBuffer>(graphicsDevice);
-		if (!m_indexBuffer->Create(m_mesh._Get()->GetIndices()))
+		if (!m_indexBuffer->Create(m_mesh._Get()->GetIndexData(), m_mesh._Get()->GetIndexCount()))
 		{
 			LOG_ERROR("Failed to create index buffer \"" + GetGameObjectName() + "\".");
 			return false;
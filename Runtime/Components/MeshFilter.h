@@ -55,8 +55,8 @@ namespace Directus
 		virtual void OnDisable();
 		virtual void Remove();
 		virtual void Update();
-		virtual void Serialize();
-		virtual void Deserialize();
+		virtual void Serialize(BinaryWriter* writer);
+		virtual void Deserialize(BinaryReader* reader);
 		//=========================
 
 		// Sets a mesh from memory
@@ -65,6 +65,9 @@ namespace Directus
 		// Sets a default mesh (cube, quad)
 		bool SetMesh(MeshType defaultMesh);
 
+		// Uses the mesh and the buffers of another MeshFilter instead of creating its own (e.g. prefab instances)
+		bool SetMeshShared(MeshType meshType, std::weak_ptr<Mesh> mesh, std::shared_ptr<D3D11VertexBuffer> vertexBuffer, std::shared_ptr<D3D11IndexBuffer> indexBuffer, const Math::BoundingBox& boundingBox);
+
 		// Sets the meshe's buffers
 		bool SetBuffers();
 
@@ -77,6 +80,9 @@ namespace Directus
 		std::string GetMeshName();
 		const std::weak_ptr<Mesh>& GetMesh() { return m_mesh; }
 		bool HasMesh() { return m_mesh.expired() ? false : true; }
+		MeshType GetMeshType() { return m_meshType; }
+		const std::shared_ptr<D3D11VertexBuffer>& GetVertexBuffer() { return m_vertexBuffer; }
+		const std::shared_ptr<D3D11IndexBuffer>& GetIndexBuffer() { return m_indexBuffer; }
 		//========================================================
 
 	private:
@@ -22,7 +22,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ===================================
 #include "MeshRenderer.h"
 #include "Transform.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
 #include "../Logging/Log.h"
 #include "../Core/GameObject.h"
 #include "../Graphics/Shaders/ShaderVariation.h"
@@ -76,20 +77,20 @@ namespace Directus
 
 	}
 
-	void MeshRenderer::Serialize()
+	void MeshRenderer::Serialize(BinaryWriter* writer)
 	{
-		StreamIO::WriteInt((int)m_materialType);
-		StreamIO::WriteSTR(!m_material.expired() ? m_material._Get()->GetResourceFilePath() : (string)DATA_NOT_ASSIGNED);
-		StreamIO::WriteBool(m_castShadows);
-		StreamIO::WriteBool(m_receiveShadows);
+		writer->WriteInt((int)m_materialType);
+		writer->WriteSTR(!m_material.expired() ? m_material._Get()->GetResourceFilePath() : (string)DATA_NOT_ASSIGNED);
+		writer->WriteBool(m_castShadows);
+		writer->WriteBool(m_receiveShadows);
 	}
 
-	void MeshRenderer::Deserialize()
+	void MeshRenderer::Deserialize(BinaryReader* reader)
 	{
-		m_materialType = (MaterialType)StreamIO::ReadInt();
-		string materialFilePath = StreamIO::ReadSTR();
-		m_castShadows = StreamIO::ReadBool();
-		m_receiveShadows = StreamIO::ReadBool();
+		m_materialType = (MaterialType)reader->ReadInt();
+		string materialFilePath = reader->ReadSTR();
+		m_castShadows = reader->ReadBool();
+		m_receiveShadows = reader->ReadBool();
 
 		// The Skybox material and texture is managed by the skybox component.
 		// No need to load anything as it will overwrite what the skybox component did.
@@ -178,6 +179,12 @@ namespace Directus
 		SetMaterialFromMemory(material);
 	}
 
+	void MeshRenderer::SetMaterialShared(weak_ptr<Material> material, MaterialType type)
+	{
+		m_material = material;
+		m_materialType = type;
+	}
+
 	weak_ptr<Material> MeshRenderer::SetMaterialByID(const string& ID)
 	{
 		// Get the material from the resource cache
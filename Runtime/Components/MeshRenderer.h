@@ -42,8 +42,8 @@ namespace Directus
 		virtual void OnDisable();
 		virtual void Remove();
 		virtual void Update();
-		virtual void Serialize();
-		virtual void Deserialize();
+		virtual void Serialize(BinaryWriter* writer);
+		virtual void Deserialize(BinaryReader* reader);
 
 		//= MISC ===================================
 		void Render(unsigned int indexCount);
@@ -64,6 +64,9 @@ namespace Directus
 		// Sets a default material (basic, skybox)
 		void SetMaterialByType(MaterialType type);
 
+		// Sets a material which is already in the resource cache, skips any lookups (e.g. prefab instances)
+		void SetMaterialShared(std::weak_ptr<Material> material, MaterialType type);
+
 		// Sets a material based on it's ID
 		std::weak_ptr<Material> SetMaterialByID(const std::string& ID);
 
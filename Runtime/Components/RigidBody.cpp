@@ -32,7 +32,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Physics/Physics.h"
 #include "../Physics/BulletPhysicsHelper.h"
 #include "../Math/Quaternion.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
 //===========================================================
 
 //= NAMESPACES ================
@@ -138,30 +139,30 @@ namespace Directus
 		}
 	}
 
-	void RigidBody::Serialize()
+	void RigidBody::Serialize(BinaryWriter* writer)
 	{
-		StreamIO::WriteFloat(m_mass);
-		StreamIO::WriteFloat(m_drag);
-		StreamIO::WriteFloat(m_angularDrag);
-		StreamIO::WriteFloat(m_restitution);
-		StreamIO::WriteBool(m_useGravity);
-		StreamIO::WriteVector3(m_gravity);
-		StreamIO::WriteBool(m_isKinematic);
-		StreamIO::WriteVector3(m_positionLock);
-		StreamIO::WriteVector3(m_rotationLock);
+		writer->WriteFloat(m_mass);
+		writer->WriteFloat(m_drag);
+		writer->WriteFloat(m_angularDrag);
+		writer->WriteFloat(m_restitution);
+		writer->WriteBool(m_useGravity);
+		writer->WriteVector3(m_gravity);
+		writer->WriteBool(m_isKinematic);
+		writer->WriteVector3(m_positionLock);
+		writer->WriteVector3(m_rotationLock);
 	}
 
-	void RigidBody::Deserialize()
+	void RigidBody::Deserialize(BinaryReader* reader)
 	{
-		m_mass = StreamIO::ReadFloat();
-		m_drag = StreamIO::ReadFloat();
-		m_angularDrag = StreamIO::ReadFloat();
-		m_restitution = StreamIO::ReadFloat();
-		m_useGravity = StreamIO::ReadBool();
-		m_gravity = StreamIO::ReadVector3();
-		m_isKinematic = StreamIO::ReadBool();
-		m_positionLock = StreamIO::ReadVector3();
-		m_rotationLock = StreamIO::ReadVector3();
+		m_mass = reader->ReadFloat();
+		m_drag = reader->ReadFloat();
+		m_angularDrag = reader->ReadFloat();
+		m_restitution = reader->ReadFloat();
+		m_useGravity = reader->ReadBool();
+		m_gravity = reader->ReadVector3();
+		m_isKinematic = reader->ReadBool();
+		m_positionLock = reader->ReadVector3();
+		m_rotationLock = reader->ReadVector3();
 
 		AddBodyToWorld();
 	}
@@ -21,7 +21,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ========================
 #include "Script.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
 #include "../FileSystem/FileSystem.h"
 #include "../Core/Context.h"
 //===================================
@@ -80,14 +81,14 @@ namespace Directus
 		m_scriptInstance->ExecuteUpdate();
 	}
 
-	void Script::Serialize()
+	void Script::Serialize(BinaryWriter* writer)
 	{
-		StreamIO::WriteSTR(m_scriptInstance ? m_scriptInstance->GetScriptPath() : (string)DATA_NOT_ASSIGNED);
+		writer->WriteSTR(m_scriptInstance ? m_scriptInstance->GetScriptPath() : (string)DATA_NOT_ASSIGNED);
 	}
 
-	void Script::Deserialize()
+	void Script::Deserialize(BinaryReader* reader)
 	{
-		string scriptPath = StreamIO::ReadSTR();
+		string scriptPath = reader->ReadSTR();
 
 		if (scriptPath != DATA_NOT_ASSIGNED)
 		{
@@ -113,12 +113,12 @@ namespace Directus
 		g_transform->SetPosition(m_anchorTrans->GetPosition());
 	}
 
-	void Skybox::Serialize()
+	void Skybox::Serialize(BinaryWriter* writer)
 	{
 
 	}
 
-	void Skybox::Deserialize()
+	void Skybox::Deserialize(BinaryReader* reader)
 	{
 
 	}
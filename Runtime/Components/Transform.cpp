@@ -21,11 +21,13 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ========================
 #include "Transform.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
 #include "../Core/Scene.h"
 #include "../Core/GameObject.h"
 #include "../Logging/Log.h"
 #include "../FileSystem/FileSystem.h"
+#include "../EventSystem/EventSystem.h"
 //===================================
 
 //= NAMESPACES ================
@@ -43,6 +45,8 @@ namespace Directus
 		m_worldTransform = Matrix::Identity;
 		m_localTransform = Matrix::Identity;
 		m_parent = nullptr;
+		m_isLocalDirty = true;
+		m_isDirty = true;
 	}
 
 	Transform::~Transform()
@@ -76,34 +80,40 @@ namespace Directus
 
 	}
 
-	void Transform::Serialize()
+	void Transform::Serialize(BinaryWriter* writer)
 	{
-		StreamIO::WriteVector3(m_positionLocal);
-		StreamIO::WriteQuaternion(m_rotationLocal);
-		StreamIO::WriteVector3(m_scaleLocal);
-		StreamIO::WriteVector3(m_lookAt);
-		StreamIO::WriteSTR(m_parent ? m_parent->GetGameObject()._Get()->GetID() : DATA_NOT_ASSIGNED);
+		writer->WriteVector3(m_positionLocal);
+		writer->WriteQuaternion(m_rotationLocal);
+		writer->WriteVector3(m_scaleLocal);
+		writer->WriteVector3(m_lookAt);
+		writer->WriteSTR(m_parent ? to_string(m_parent->GetGameObject()._Get()->GetID()) : DATA_NOT_ASSIGNED);
 	}
 
-	void Transform::Deserialize()
+	void Transform::Deserialize(BinaryReader* reader)
 	{
-		m_positionLocal = StreamIO::ReadVector3();
-		m_rotationLocal = StreamIO::ReadQuaternion();
-		m_scaleLocal = StreamIO::ReadVector3();
-		m_lookAt = StreamIO::ReadVector3();
+		DeserializeLocal(reader);
 
 		// get parent transform
-		string parentGameObjectID = StreamIO::ReadSTR();
+		string parentGameObjectID = reader->ReadSTR();
 		if (parentGameObjectID != DATA_NOT_ASSIGNED)
 		{
-			auto parent = g_context->GetSubsystem<Scene>()->GetGameObjectByID(parentGameObjectID);
+			auto parent = g_context->GetSubsystem<Scene>()->GetGameObjectByID(GUIDGenerator::IDFromString(parentGameObjectID));
 			if (!parent.expired())
 			{
 				parent._Get()->GetTransform()->AddChild(this);
 			}
 		}
+	}
 
-		UpdateTransform();
+	void Transform::DeserializeLocal(BinaryReader* reader)
+	{
+		m_positionLocal = reader->ReadVector3();
+		m_rotationLocal = reader->ReadQuaternion();
+		m_scaleLocal = reader->ReadVector3();
+		m_lookAt = reader->ReadVector3();
+
+		m_isLocalDirty = true;
+		MarkDirty();
 	}
 
 	//=====================
@@ -112,15 +122,36 @@ namespace Directus
 	void Transform::UpdateTransform()
 	{
 		// Calculate transform
-		m_localTransform = Matrix(m_positionLocal, m_rotationLocal, m_scaleLocal);
+		if (m_isLocalDirty)
+		{
+			m_localTransform = Matrix(m_positionLocal, m_rotationLocal, m_scaleLocal);
+			m_isLocalDirty = false;
+		}
 
-		// Calculate global transformation
+		// Calculate global transformation, this brings the parent up to date first (if needed)
 		m_worldTransform = HasParent() ? m_localTransform * GetParentTransformMatrix() : m_localTransform;
+		m_isDirty = false;
+	}
 
-		// update children
+	void Transform::MarkDirty()
+	{
+		// A dirty transform's descendants are dirty already
+		if (m_isDirty)
+			return;
+
+		m_isDirty = true;
 		for (const auto& child : m_children)
 		{
-			child->UpdateTransform();
+			child->MarkDirty();
+		}
+	}
+
+	void Transform::NotifyChanged()
+	{
+		// Setters also run on worker threads (e.g. physics), so the event is posted
+		if (EventSystem::HasSubscribers<TransformChangedEvent>())
+		{
+			EventSystem::Post(TransformChangedEvent{ g_gameObject });
 		}
 	}
 
@@ -136,7 +167,9 @@ namespace Directus
 			return;
 
 		m_positionLocal = position;
-		UpdateTransform();
+		m_isLocalDirty = true;
+		MarkDirty();
+		NotifyChanged();
 	}
 	//================================================================================================
 
@@ -152,7 +185,9 @@ namespace Directus
 			return;
 
 		m_rotationLocal = rotation;
-		UpdateTransform();
+		m_isLocalDirty = true;
+		MarkDirty();
+		NotifyChanged();
 	}
 	//================================================================================================
 
@@ -175,7 +210,9 @@ namespace Directus
 		m_scaleLocal.y = (m_scaleLocal.y == 0.0f) ? M_EPSILON : m_scaleLocal.y;
 		m_scaleLocal.z = (m_scaleLocal.z == 0.0f) ? M_EPSILON : m_scaleLocal.z;
 
-		UpdateTransform();
+		m_isLocalDirty = true;
+		MarkDirty();
+		NotifyChanged();
 	}
 	//================================================================================================
 
@@ -284,7 +321,8 @@ namespace Directus
 			m_parent->ResolveChildrenRecursively();
 		}
 
-		UpdateTransform();
+		MarkDirty();
+		NotifyChanged();
 	}
 
 	void Transform::AddChild(Transform* child)
@@ -298,6 +336,26 @@ namespace Directus
 		child->SetParent(this);
 	}
 
+	void Transform::AttachNewChild(Transform* child)
+	{
+		if (!child || g_ID == child->g_ID)
+			return;
+
+		// Anything else needs the full treatment
+		if (child->HasParent() || child->HasChildren())
+		{
+			AddChild(child);
+			return;
+		}
+
+		child->m_parent = this;
+		m_children.push_back(child);
+		g_context->GetSubsystem<Scene>()->MarkHierarchyDirty();
+
+		child->MarkDirty();
+		child->NotifyChanged();
+	}
+
 	// Returns a child with the given index
 	Transform* Transform::GetChildByIndex(int index)
 	{
@@ -335,6 +393,7 @@ namespace Directus
 	{
 		m_children.clear();
 		m_children.shrink_to_fit();
+		g_context->GetSubsystem<Scene>()->MarkHierarchyDirty();
 
 		auto gameObjects = g_context->GetSubsystem<Scene>()->GetAllGameObjects();
 		for (const auto& gameObject : gameObjects)
@@ -410,7 +469,8 @@ namespace Directus
 		m_parent = nullptr;
 
 		// Update the transform without the parent now
-		UpdateTransform();
+		MarkDirty();
+		NotifyChanged();
 
 		// make the parent search for children,
 		// that's indirect way of making tha parent "forget"
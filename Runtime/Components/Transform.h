@@ -45,25 +45,31 @@ namespace Directus
 		virtual void OnDisable();
 		virtual void Remove();
 		virtual void Update();
-		virtual void Serialize();
-		virtual void Deserialize();
-
+		virtual void Serialize(BinaryWriter* writer);
+		virtual void Deserialize(BinaryReader* reader);
+		// Reads the local position, rotation and scale but ignores the serialized parent
+		void DeserializeLocal(BinaryReader* reader);
+
+		// Transforms are updated lazily, setting the position, rotation, scale or parent only
+		// marks the transform and its descendants as dirty. The world matrix is rebuilt when it's
+		// read, or by the scene's batched pass once per frame, whichever comes first.
 		void UpdateTransform();
+		bool IsDirty() { return m_isDirty; }
 
 		//= POSITION ======================================================================
-		Math::Vector3 GetPosition() { return m_worldTransform.GetTranslation(); }
+		Math::Vector3 GetPosition() { return GetWorldTransform().GetTranslation(); }
 		const Math::Vector3& GetPositionLocal() { return m_positionLocal; }
 		void SetPosition(const Math::Vector3& position);
 		void SetPositionLocal(const Math::Vector3& position);
 
 		//= ROTATION ======================================================================
-		Math::Quaternion GetRotation() { return m_worldTransform.GetRotation(); }
+		Math::Quaternion GetRotation() { return GetWorldTransform().GetRotation(); }
 		const Math::Quaternion& GetRotationLocal() { return m_rotationLocal; }
 		void SetRotation(const Math::Quaternion& rotation);
 		void SetRotationLocal(const Math::Quaternion& rotation);
 
 		//= SCALE =========================================================================
-		Math::Vector3 GetScale() { return m_worldTransform.GetScale(); }
+		Math::Vector3 GetScale() { return GetWorldTransform().GetScale(); }
 		const Math::Vector3& GetScaleLocal() { return m_scaleLocal; }
 		void SetScale(const Math::Vector3& scale);
 		void SetScaleLocal(const Math::Vector3& scale);
@@ -85,6 +91,9 @@ namespace Directus
 		void BecomeOrphan();
 		bool HasChildren() { return GetChildrenCount() > 0 ? true : false; }
 		void AddChild(Transform* child);
+		// Cheaper than AddChild() as it doesn't resolve the hierarchy, only for a child which
+		// has neither a parent nor children of its own yet (e.g. while building a prefab instance)
+		void AttachNewChild(Transform* child);
 		Transform* GetRoot() { return HasParent() ? GetParent()->GetRoot() : this; }
 		Transform* GetParent() { return m_parent; }
 		Transform* GetChildByIndex(int index);
@@ -98,8 +107,8 @@ namespace Directus
 
 		//= ICOMPONENT ====================================================================
 		void LookAt(const Math::Vector3& v) { m_lookAt = v; }
-		Math::Matrix& GetWorldTransform() { return m_worldTransform; }
-		Math::Matrix& GetLocalTransform() { return m_localTransform; }
+		Math::Matrix& GetWorldTransform() { if (m_isDirty) UpdateTransform(); return m_worldTransform; }
+		Math::Matrix& GetLocalTransform() { if (m_isDirty) UpdateTransform(); return m_localTransform; }
 		weakGameObj& GetGameObject() { return g_gameObject; }		
 
 	private:
@@ -115,7 +124,12 @@ namespace Directus
 		Transform* m_parent; // the parent of this transform
 		std::vector<Transform*> m_children; // the children of this transform
 
+		bool m_isLocalDirty; // the local matrix is out of date
+		bool m_isDirty; // the world matrix is out of date
+
 		//= HELPER FUNCTIONS ================================================================
 		Math::Matrix GetParentTransformMatrix();
+		void MarkDirty();
+		void NotifyChanged();
 	};
 }
\ No newline at end of file
@@ -0,0 +1,199 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ======================
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <type_traits>
+#include "../Components/Component.h"
+//=================================
+
+namespace Directus
+{
+	// Type erased side of a pool, this is what a component keeps to get back to its pool.
+	// Pools are shared by the engine and any module linking against it (e.g. the editor),
+	// the first module to ask for the pool of a type creates it, the rest find it by name.
+	class DLL_API ComponentPoolBase
+	{
+	public:
+		virtual ~ComponentPoolBase() {}
+
+		// Destroys the component and returns its slot to the pool
+		virtual void Free(Component* component) = 0;
+
+		// Makes room for count more components, so that allocating them doesn't have to
+		virtual void Reserve(int count) = 0;
+
+	protected:
+		typedef ComponentPoolBase* (*createFunction)();
+		static ComponentPoolBase* GetOrCreate(const std::type_info& type, createFunction create);
+	};
+
+	// Components of one type, constructed in place in fixed size chunks. Chunks are never
+	// moved or freed, so a component's address is a stable handle for as long as it lives.
+	// Any thread may allocate (e.g. a loader building GameObjects in a staging list),
+	// freeing and iterating are meant for the main thread. Iteration doesn't lock, a slot
+	// only shows up once its component has been published.
+	template <class T>
+	class ComponentPool : public ComponentPoolBase
+	{
+		static const int CHUNK_SIZE = 256;
+		static const int MAX_CHUNKS = 4096;
+
+		struct Chunk
+		{
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type items[CHUNK_SIZE];
+			std::atomic<bool> alive[CHUNK_SIZE];
+		};
+
+	public:
+		ComponentPool()
+		{
+			m_chunks = std::make_unique<std::atomic<Chunk*>[]>(MAX_CHUNKS);
+			m_chunkCount = 0;
+			m_size = 0;
+			m_count = 0;
+		}
+
+		~ComponentPool()
+		{
+			for (int i = 0; i < m_chunkCount; i++)
+			{
+				delete m_chunks[i].load();
+			}
+		}
+
+		static ComponentPool<T>& Get()
+		{
+			static ComponentPool<T>* pool = static_cast<ComponentPool<T>*>(GetOrCreate(typeid(T), [] { return (ComponentPoolBase*)new ComponentPool<T>(); }));
+			return *pool;
+		}
+
+		T* Allocate()
+		{
+			int index;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (!m_freeSlots.empty())
+				{
+					index = m_freeSlots.back();
+					m_freeSlots.pop_back();
+				}
+				else
+				{
+					index = m_size++;
+					if (index / CHUNK_SIZE == m_chunkCount && !AddChunk())
+					{
+						m_size--;
+						return nullptr;
+					}
+				}
+			}
+
+			Chunk* chunk = m_chunks[index / CHUNK_SIZE].load(std::memory_order_acquire);
+			T* component = new (&chunk->items[index % CHUNK_SIZE]) T;
+			component->m_pool = this;
+			component->m_poolIndex = index;
+			m_count++;
+
+			return component;
+		}
+
+		// Makes an allocated component visible to ForEach(), to be called once it's fully set up
+		void Publish(T* component)
+		{
+			int index = component->m_poolIndex;
+			Chunk* chunk = m_chunks[index / CHUNK_SIZE].load(std::memory_order_acquire);
+			chunk->alive[index % CHUNK_SIZE].store(true, std::memory_order_release);
+		}
+
+		void Free(Component* component) override
+		{
+			int index = component->m_poolIndex;
+			Chunk* chunk = m_chunks[index / CHUNK_SIZE].load(std::memory_order_acquire);
+			chunk->alive[index % CHUNK_SIZE].store(false, std::memory_order_release);
+			static_cast<T*>(component)->~T();
+			m_count--;
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_freeSlots.push_back(index);
+		}
+
+		void Reserve(int count) override
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			int needed = m_size + count - (int)m_freeSlots.size();
+			while (m_chunkCount * CHUNK_SIZE < needed && AddChunk()) {}
+		}
+
+		// Calls function(T*) for every published component, in memory order
+		template <typename Function>
+		void ForEach(Function&& function)
+		{
+			int chunkCount = m_chunkCount.load(std::memory_order_acquire);
+			for (int c = 0; c < chunkCount; c++)
+			{
+				Chunk* chunk = m_chunks[c].load(std::memory_order_acquire);
+				for (int i = 0; i < CHUNK_SIZE; i++)
+				{
+					if (chunk->alive[i].load(std::memory_order_acquire))
+					{
+						function(reinterpret_cast<T*>(&chunk->items[i]));
+					}
+				}
+			}
+		}
+
+		// Number of allocated components
+		int GetCount() { return m_count; }
+
+	private:
+		// Called with the mutex locked
+		bool AddChunk()
+		{
+			if (m_chunkCount == MAX_CHUNKS)
+				return false;
+
+			Chunk* chunk = new Chunk();
+			for (auto& alive : chunk->alive)
+			{
+				alive.store(false, std::memory_order_relaxed);
+			}
+			m_chunks[m_chunkCount].store(chunk, std::memory_order_release);
+			m_chunkCount.store(m_chunkCount + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		std::unique_ptr<std::atomic<Chunk*>[]> m_chunks;
+		std::atomic<int> m_chunkCount;
+		int m_size; // Slots handed out so far, including freed ones
+		std::atomic<int> m_count;
+		std::vector<int> m_freeSlots;
+		std::mutex m_mutex;
+	};
+}
\ No newline at end of file
@@ -18,6 +18,13 @@ DEALINGS IN THE SOFTWARE. */
 
 //= INCLUDES =======
 #include "Context.h"
+#include <map>
+#include <mutex>
+#include <string>
+//==================
+
+//= NAMESPACES =====
+using namespace std;
 //==================
 
 namespace Directus
@@ -43,5 +50,27 @@ namespace Directus
 			return;
 
 		m_subsystems.push_back(subsystem);
+
+		int slot = GetTypeSlot(typeid(*subsystem));
+		if (slot >= (int)m_subsystemsBySlot.size())
+		{
+			m_subsystemsBySlot.resize(slot + 1, nullptr);
+		}
+		m_subsystemsBySlot[slot] = subsystem;
+	}
+
+	int Context::GetTypeSlot(const type_info& type)
+	{
+		static mutex slotsMutex;
+		static map<string, int> slots;
+
+		lock_guard<mutex> lock(slotsMutex);
+		auto it = slots.find(type.name());
+		if (it != slots.end())
+			return it->second;
+
+		int slot = (int)slots.size();
+		slots[type.name()] = slot;
+		return slot;
 	}
 }
\ No newline at end of file
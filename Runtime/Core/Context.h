@@ -19,6 +19,7 @@ DEALINGS IN THE SOFTWARE. */
 //= INCLUDES =========
 #include "Subsystem.h"
 #include <vector>
+#include <typeinfo>
 //====================
 
 namespace Directus
@@ -35,18 +36,27 @@ namespace Directus
 		// Get a subsystem
 		template <class T> T* GetSubsystem();
 	private:
+		// Returns the slot of a type, slots are handed out by name so that the engine
+		// and any module linking against it (e.g. the editor) agree on them.
+		static int GetTypeSlot(const std::type_info& type);
+
+		// Caches the slot of T in this module, after the first call it's a single load
+		template <class T>
+		static int GetTypeSlot()
+		{
+			static const int slot = GetTypeSlot(typeid(T));
+			return slot;
+		}
+
 		std::vector<Subsystem*> m_subsystems;
+		// Indexed by type slot, null where no subsystem of that type is registered
+		std::vector<Subsystem*> m_subsystemsBySlot;
 	};
 
 	template <class T>
 	T* Context::GetSubsystem()
 	{
-		for (const auto& subsystem : m_subsystems)
-		{
-			if (typeid(T) == typeid(*subsystem))
-				return static_cast<T*>(subsystem);
-		}
-
-		return nullptr;
+		int slot = GetTypeSlot<T>();
+		return slot < (int)m_subsystemsBySlot.size() ? static_cast<T*>(m_subsystemsBySlot[slot]) : nullptr;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==========
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+//=====================
+
+namespace Directus
+{
+	// Items packed in a vector for iteration, with O(1) insertion, update and
+	// removal by key. Removal moves the last item into the hole, so the order
+	// isn't preserved, but the vector itself can be handed out and iterated.
+	template <typename Key, typename T>
+	class DenseMap
+	{
+	public:
+		void Set(const Key& key, const T& item)
+		{
+			auto it = m_indices.find(key);
+			if (it != m_indices.end())
+			{
+				m_items[it->second] = item;
+				return;
+			}
+
+			m_indices[key] = m_items.size();
+			m_items.push_back(item);
+			m_keys.push_back(key);
+		}
+
+		void Remove(const Key& key)
+		{
+			auto it = m_indices.find(key);
+			if (it == m_indices.end())
+				return;
+
+			size_t index = it->second;
+			size_t last = m_items.size() - 1;
+			m_indices.erase(it);
+
+			if (index != last)
+			{
+				m_items[index] = std::move(m_items[last]);
+				m_keys[index] = m_keys[last];
+				m_indices[m_keys[index]] = index;
+			}
+
+			m_items.pop_back();
+			m_keys.pop_back();
+		}
+
+		bool Contains(const Key& key) { return m_indices.find(key) != m_indices.end(); }
+
+		void Clear()
+		{
+			m_items.clear();
+			m_items.shrink_to_fit();
+			m_keys.clear();
+			m_keys.shrink_to_fit();
+			m_indices.clear();
+		}
+
+		const std::vector<T>& Get() { return m_items; }
+
+	private:
+		std::vector<T> m_items;
+		std::vector<Key> m_keys;
+		std::unordered_map<Key, size_t> m_indices;
+	};
+}
\ No newline at end of file
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =================================
 #include "Engine.h"
 #include "Timer.h"
+#include "Scheduler.h"
 #include "Settings.h"
 #include "../Logging/Log.h"
 #include "../Threading/Threading.h"
@@ -34,6 +35,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../EventSystem/EventSystem.h"
 #include "../Input/Input.h"
 #include "../Physics/Physics.h"
+#include "../Profiling/Profiler.h"
 //===========================================
 
 //= NAMESPACES =====
@@ -51,9 +53,11 @@ namespace Directus
 		Log::Initialize();
 		FileSystem::Initialize();
 		Settings::Initialize();
+		Profiler::SetThreadName("Main");
 
 		// Register subsystems
 		m_context->RegisterSubsystem(new Timer(m_context));
+		m_context->RegisterSubsystem(new Scheduler(m_context)); // before anything that adds frame jobs
 		m_context->RegisterSubsystem(new Input(m_context));
 		m_context->RegisterSubsystem(new Threading(m_context));
 		m_context->RegisterSubsystem(new ResourceManager(m_context));
@@ -82,6 +86,13 @@ namespace Directus
 			return false;
 		}
 
+		// Scheduler
+		if (!m_context->GetSubsystem<Scheduler>()->Initialize())
+		{
+			LOG_ERROR("Failed to initialize Scheduler subsystem");
+			return false;
+		}
+
 		// Input
 		m_context->GetSubsystem<Input>()->SetHandle((HWND)m_windowHandle, (HINSTANCE)m_hinstance);
 		if (!m_context->GetSubsystem<Input>()->Initialize())
@@ -160,14 +171,41 @@ namespace Directus
 
 	void Engine::Update()
 	{
+		PROFILE_FRAME();
+		PROFILE_SCOPE("Engine::Update");
+
 		// TIMER UPDATE
 		m_context->GetSubsystem<Timer>()->Update();
 
+		// STRUCTURAL CHANGES (e.g. GameObjects loaded in the background)
+		{
+			PROFILE_SCOPE("Scene::ApplyCommands");
+			m_context->GetSubsystem<Scene>()->ApplyCommands();
+		}
+
+		// RESOURCES LOADED IN THE BACKGROUND
+		{
+			PROFILE_SCOPE("ResourceManager::FinalizeLoads");
+			m_context->GetSubsystem<ResourceManager>()->FinalizeLoads();
+		}
+
+		// EVENTS POSTED FROM OTHER THREADS
+		EventSystem::Dispatch();
+
+		// FRAME JOBS
+		m_context->GetSubsystem<Scheduler>()->Execute();
+
 		// LOGIC UPDATE
-		FIRE_EVENT(EVENT_UPDATE);
+		{
+			PROFILE_SCOPE("EVENT_UPDATE");
+			FIRE_EVENT(EVENT_UPDATE);
+		}
 
 		// RENDER UPDATE
-		FIRE_EVENT(EVENT_RENDER);
+		{
+			PROFILE_SCOPE("EVENT_RENDER");
+			FIRE_EVENT(EVENT_RENDER);
+		}
 	}
 
 	void Engine::Shutdown()
@@ -176,6 +214,9 @@ namespace Directus
 		// in the reverse order in which they were registered.
 		SafeDelete(m_context);
 
+		// Drop subscribers that point into the subsystems, and anything still queued
+		EventSystem::Clear();
+
 		// Release Log singleton
 		Log::Release();
 	}
@@ -28,6 +28,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <guiddef.h>
 #include "Objbase.h"
 #include <winerror.h>
+#include <atomic>
 //========================
 
 //= NAMESPACES =====
@@ -36,6 +37,10 @@ using namespace std;
 
 namespace Directus
 {
+	// 0 is never handed out, it's left as an invalid ID
+	static atomic<unsigned long long> s_nextID(1);
+	static const unsigned long long ID_HASHED_BIT = 1ull << 63;
+
 	string GUIDGenerator::Generate()
 	{
 		string guidString = "N/A";
@@ -61,4 +66,42 @@ namespace Directus
 
 		return guidString;
 	}
+
+	unsigned long long GUIDGenerator::GenerateID()
+	{
+		return s_nextID++;
+	}
+
+	unsigned long long GUIDGenerator::IDFromString(const string& str)
+	{
+		bool isNumeric = !str.empty() && str.size() <= 19;
+		unsigned long long id = 0;
+		for (const auto& c : str)
+		{
+			if (c < '0' || c > '9')
+			{
+				isNumeric = false;
+				break;
+			}
+			id = id * 10 + (c - '0');
+		}
+
+		if (isNumeric && !(id & ID_HASHED_BIT))
+		{
+			// Reserve it
+			unsigned long long next = s_nextID.load();
+			while (next <= id && !s_nextID.compare_exchange_weak(next, id + 1)) {}
+			return id;
+		}
+
+		// FNV-1a
+		unsigned long long hash = 14695981039346656037ull;
+		for (const auto& c : str)
+		{
+			hash ^= (unsigned char)c;
+			hash *= 1099511628211ull;
+		}
+
+		return hash | ID_HASHED_BIT;
+	}
 }
\ No newline at end of file
@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //=================
 
 #define GENERATE_GUID Directus::GUIDGenerator::Generate()
+#define GENERATE_ID Directus::GUIDGenerator::GenerateID()
 
 namespace Directus
 {
@@ -34,5 +35,14 @@ namespace Directus
 	{
 	public:
 		static std::string Generate();
+
+		// A 64-bit ID, unique for the lifetime of the process and never reused.
+		// Cheap to hash and compare, meant for objects which are looked up a lot.
+		static unsigned long long GenerateID();
+
+		// Converts an ID saved as text back to an ID. Numeric IDs are reserved,
+		// so GenerateID() won't hand them out again, anything else (e.g. a GUID
+		// saved by an older version) is hashed into the upper half of the range.
+		static unsigned long long IDFromString(const std::string& str);
 	};
 }
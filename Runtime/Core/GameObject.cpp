@@ -22,9 +22,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ============================
 #include "GameObject.h"
 #include "Scene.h"
+#include "Prefab.h"
 #include "GUIDGenerator.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
 #include "../Logging/Log.h"
+#include "../Resource/ResourceManager.h"
 #include "../Components/AudioSource.h"
 #include "../Components/AudioListener.h"
 #include "../Components/Camera.h"
@@ -50,11 +53,12 @@ namespace Directus
 	GameObject::GameObject(Context* context)
 	{
 		m_context = context;
-		m_ID = GENERATE_GUID;
+		m_ID = GENERATE_ID;
 		m_name = "GameObject";
 		m_isActive = true;
 		m_isPrefab = false;
 		m_hierarchyVisibility = true;
+		m_isStaged = false;
 		m_transform = nullptr;
 		m_meshFilter = nullptr;
 		m_meshRenderer = nullptr;
@@ -62,14 +66,17 @@ namespace Directus
 
 	GameObject::~GameObject()
 	{
+		// Leave the render lists while the components are still there
+		m_context->GetSubsystem<Scene>()->UpdateRenderLists(this);
+
 		// delete components
 		for (int i = 0; i < m_components.size(); i++)
 		{
-			delete m_components[i];
+			m_components[i]->m_pool->Free(m_components[i]);
 		}
 		m_components.clear();
 
-		m_ID.clear();
+		m_ID = 0;
 		m_name.clear();
 		m_isActive = true;
 		m_hierarchyVisibility = true;
@@ -110,19 +117,43 @@ namespace Directus
 		}
 	}
 
-	bool GameObject::SaveAsPrefab(const string& filePath)
+	void GameObject::SetActive(bool active)
 	{
-		// Try to create a prefab file
-		if (!StreamIO::StartWriting(filePath + PREFAB_EXTENSION))
-			return false;
+		if (m_isActive == active)
+			return;
+
+		m_isActive = active;
+		m_context->GetSubsystem<Scene>()->UpdateRenderLists(this);
+	}
+
+	void GameObject::SetName(const string& name)
+	{
+		string oldName = m_name;
+		m_name = name;
+		m_context->GetSubsystem<Scene>()->UpdateIndices(this, m_ID, oldName);
+	}
 
+	void GameObject::SetID(unsigned long long ID)
+	{
+		unsigned long long oldID = m_ID;
+		m_ID = ID;
+		m_context->GetSubsystem<Scene>()->UpdateIndices(this, oldID, m_name);
+	}
+
+	bool GameObject::SaveAsPrefab(const string& filePath)
+	{
 		m_isPrefab = true;
 
-		// Serialize as usual...
-		Serialize();
+		string prefabFilePath = filePath + PREFAB_EXTENSION;
+		if (!Prefab::Save(this, prefabFilePath))
+			return false;
 
-		// Close it
-		StreamIO::StopWriting();
+		// Instances made from now on should match what was just saved
+		weak_ptr<Prefab> prefab = m_context->GetSubsystem<ResourceManager>()->GetResourceByPath<Prefab>(prefabFilePath);
+		if (!prefab.expired())
+		{
+			prefab._Get()->LoadFromFile(prefabFilePath);
+		}
 
 		return true;
 	}
@@ -133,40 +164,35 @@ namespace Directus
 		if (!FileSystem::IsEnginePrefabFile(filePath))
 			return false;
 
-		// Try to open it
-		if (!StreamIO::StartReading(filePath))
+		// The file is parsed once, then every instance is built from memory
+		weak_ptr<Prefab> prefab = m_context->GetSubsystem<ResourceManager>()->Load<Prefab>(filePath);
+		if (prefab.expired())
 			return false;
 
-		// Deserialize as usual...
-		Deserialize(nullptr);
-
-		// Close it
-		StreamIO::StopReading();
-
-		return true;
+		return prefab._Get()->Instantiate(this);
 	}
 
-	void GameObject::Serialize()
+	void GameObject::Serialize(BinaryWriter* writer)
 	{
 		//= BASIC DATA ================================
-		StreamIO::WriteBool(m_isPrefab);
-		StreamIO::WriteBool(m_isActive);
-		StreamIO::WriteBool(m_hierarchyVisibility);
-		StreamIO::WriteSTR(m_ID);
-		StreamIO::WriteSTR(m_name);		
+		writer->WriteBool(m_isPrefab);
+		writer->WriteBool(m_isActive);
+		writer->WriteBool(m_hierarchyVisibility);
+		writer->WriteSTR(to_string(m_ID));
+		writer->WriteSTR(m_name);		
 		//=============================================
 
 		//= COMPONENTS ================================
-		StreamIO::WriteInt((int)m_components.size());
+		writer->WriteInt((int)m_components.size());
 		for (const auto& component : m_components)
 		{
-			StreamIO::WriteSTR(component->g_type);
-			StreamIO::WriteSTR(component->g_ID);
+			writer->WriteSTR(component->g_type);
+			writer->WriteSTR(component->g_ID);
 		}
 
 		for (const auto& component : m_components)
 		{
-			component->Serialize();
+			component->Serialize(writer);
 		}
 		//=============================================
 
@@ -174,12 +200,12 @@ namespace Directus
 		vector<Transform*> children = GetTransform()->GetChildren();
 
 		// 1st - children count
-		StreamIO::WriteInt((int)children.size());
+		writer->WriteInt((int)children.size());
 
 		// 2nd - children IDs
 		for (const auto& child : children)
 		{
-			StreamIO::WriteSTR(child->g_ID);
+			writer->WriteSTR(child->g_ID);
 		}
 
 		// 3rd - children
@@ -187,7 +213,7 @@ namespace Directus
 		{
 			if (!child->g_gameObject.expired())
 			{
-				child->g_gameObject._Get()->Serialize();
+				child->g_gameObject._Get()->Serialize(writer);
 			}
 			else
 			{
@@ -198,24 +224,34 @@ namespace Directus
 		//=============================================
 	}
 
-	void GameObject::Deserialize(Transform* parent)
+	void GameObject::Deserialize(BinaryReader* reader, Transform* parent)
 	{
 		//= BASIC DATA ================================
-		m_isPrefab = StreamIO::ReadBool();
-		m_isActive = StreamIO::ReadBool();
-		m_hierarchyVisibility = StreamIO::ReadBool();
-		m_ID = StreamIO::ReadSTR();
-		m_name = StreamIO::ReadSTR();
+		m_isPrefab = reader->ReadBool();
+		m_isActive = reader->ReadBool();
+		m_hierarchyVisibility = reader->ReadBool();
+		SetID(GUIDGenerator::IDFromString(reader->ReadSTR()));
+		SetName(reader->ReadSTR());
 		//=============================================
 
 		//= COMPONENTS ================================
-		int componentCount = StreamIO::ReadInt();
-		for (int i = 0; i < componentCount; i++)
+		int componentCount = reader->ReadInt();
+		for (int i = 0; i < componentCount && reader->IsValid(); i++)
 		{
-			string type = StreamIO::ReadSTR(); // load component's type
-			string id = StreamIO::ReadSTR(); // load component's id
+			string type = reader->ReadSTR(); // load component's type
+			string id = reader->ReadSTR(); // load component's id
 
-			Component* component = AddComponentBasedOnType(type);
+			// An unknown type (or a full pool) leaves the component's data unread, nothing after it can be read
+			Component* component = reader->IsValid() ? AddComponentBasedOnType(type) : nullptr;
+			if (!component)
+			{
+				if (reader->IsValid())
+				{
+					LOG_ERROR("GameObject: Failed to add a component of type \"" + type + "\" to \"" + m_name + "\", aborting deserialization.");
+					reader->Invalidate();
+				}
+				return;
+			}
 			component->g_ID = id;
 		}
 		// Sometimes there are component dependencies, e.g. a collider that needs
@@ -223,7 +259,7 @@ namespace Directus
 		// the components (like above) and then deserialize them (like here).
 		for (const auto& component : m_components)
 		{
-			component->Deserialize();
+			component->Deserialize(reader);
 		}
 		//=============================================
 
@@ -235,22 +271,22 @@ namespace Directus
 
 		//= CHILDREN ===================================
 		// 1st - children count
-		int childrenCount = StreamIO::ReadInt();
+		int childrenCount = reader->ReadInt();
 
 		// 2nd - children IDs
 		auto scene = m_context->GetSubsystem<Scene>();
 		vector<weakGameObj> children;
-		for (int i = 0; i < childrenCount; i++)
+		for (int i = 0; i < childrenCount && reader->IsValid(); i++)
 		{
 			weakGameObj child = scene->CreateGameObject();
-			child._Get()->SetID(StreamIO::ReadSTR());
+			child._Get()->SetID(GUIDGenerator::IDFromString(reader->ReadSTR()));
 			children.push_back(child);
 		}
 
 		// 3rd - children
 		for (const auto& child : children)
 		{
-			child._Get()->Deserialize(GetTransform());
+			child._Get()->Deserialize(reader, GetTransform());
 		}
 		//=============================================
 
@@ -267,7 +303,8 @@ namespace Directus
 			auto component = *it;
 			if (id == component->g_ID)
 			{
-				delete component;
+				ForgetCachedComponent(component);
+				component->m_pool->Free(component);
 				it = m_components.erase(it);
 			}
 			else
@@ -275,9 +312,23 @@ namespace Directus
 				++it;
 			}
 		}
+
+		m_context->GetSubsystem<Scene>()->UpdateRenderLists(this);
 	}
 
 	//= HELPER FUNCTIONS ===========================================
+	void GameObject::ForgetCachedComponent(Component* component)
+	{
+		if (component == (Component*)m_meshFilter)
+		{
+			m_meshFilter = nullptr;
+		}
+		else if (component == (Component*)m_meshRenderer)
+		{
+			m_meshRenderer = nullptr;
+		}
+	}
+
 	Component* GameObject::AddComponentBasedOnType(const string& typeStr)
 	{
 		// Note: this is the only hardcoded part regarding
@@ -330,4 +381,25 @@ namespace Directus
 
 		return component;
 	}
+
+	ComponentPoolBase* GameObject::GetPoolBasedOnType(const string& typeStr)
+	{
+		// Has to match AddComponentBasedOnType()
+		if (typeStr == "Transform")		return &ComponentPool<Transform>::Get();
+		if (typeStr == "MeshFilter")	return &ComponentPool<MeshFilter>::Get();
+		if (typeStr == "MeshRenderer")	return &ComponentPool<MeshRenderer>::Get();
+		if (typeStr == "Light")			return &ComponentPool<Light>::Get();
+		if (typeStr == "Camera")		return &ComponentPool<Camera>::Get();
+		if (typeStr == "Skybox")		return &ComponentPool<Skybox>::Get();
+		if (typeStr == "RigidBody")		return &ComponentPool<RigidBody>::Get();
+		if (typeStr == "Collider")		return &ComponentPool<Collider>::Get();
+		if (typeStr == "MeshCollider")	return &ComponentPool<MeshCollider>::Get();
+		if (typeStr == "Hinge")			return &ComponentPool<Hinge>::Get();
+		if (typeStr == "Script")		return &ComponentPool<Script>::Get();
+		if (typeStr == "LineRenderer")	return &ComponentPool<LineRenderer>::Get();
+		if (typeStr == "AudioSource")	return &ComponentPool<AudioSource>::Get();
+		if (typeStr == "AudioListener")	return &ComponentPool<AudioListener>::Get();
+
+		return nullptr;
+	}
 }
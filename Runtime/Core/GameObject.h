@@ -24,8 +24,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =======================
 #include <vector>
 #include "Scene.h"
+#include "ComponentPool.h"
 #include "../Components/Component.h"
 #include "../Core/Context.h"
+#include "../Logging/Log.h"
+#include "../EventSystem/EventSystem.h"
 //==================================
 
 namespace Directus
@@ -33,6 +36,8 @@ namespace Directus
 	class Transform;
 	class MeshFilter;
 	class MeshRenderer;
+	class BinaryWriter;
+	class BinaryReader;
 
 	class DLL_API GameObject
 	{
@@ -49,21 +54,26 @@ namespace Directus
 		bool SaveAsPrefab(const std::string& filePath);
 		bool LoadFromPrefab(const std::string& filePath);
 
-		void Serialize();
-		void Deserialize(Transform* parent);
+		void Serialize(BinaryWriter* writer);
+		void Deserialize(BinaryReader* reader, Transform* parent);
 
 		//= PROPERTIES =========================================================================================
+		// Renaming or changing the ID keeps the scene's lookup indices up to date
 		const std::string& GetName() { return m_name; }
-		void SetName(const std::string& name) { m_name = name; }
+		void SetName(const std::string& name);
 
-		const std::string& GetID() { return m_ID; }
-		void SetID(const std::string& ID) { m_ID = ID; }
+		unsigned long long GetID() { return m_ID; }
+		void SetID(unsigned long long ID);
 
 		bool IsActive() { return m_isActive; }
-		void SetActive(bool active) { m_isActive = active; }
+		void SetActive(bool active);
 
 		bool IsVisibleInHierarchy() { return m_hierarchyVisibility; }
 		void SetHierarchyVisibility(bool hierarchyVisibility) { m_hierarchyVisibility = hierarchyVisibility; }
+
+		// Created while staging and not yet committed to the scene
+		bool IsStaged() { return m_isStaged; }
+		void SetStaged(bool staged) { m_isStaged = staged; }
 		//======================================================================================================
 
 		//= COMPONENTS =========================================================================================
@@ -79,7 +89,12 @@ namespace Directus
 				return static_cast<T*>(existingComp); // return the existing component.
 
 			// Get the created component.
-			Component* component = new T;
+			T* component = ComponentPool<T>::Get().Allocate();
+			if (!component)
+			{
+				LOG_ERROR("GameObject: Failed to allocate a " + typeStr + " component.");
+				return nullptr;
+			}
 
 			// Add the component.
 			m_components.push_back(component);
@@ -95,27 +110,38 @@ namespace Directus
 			// Run Initialize().
 			component->Reset();
 
+			// Let queries see it
+			ComponentPool<T>::Get().Publish(component);
+			m_context->GetSubsystem<Scene>()->UpdateRenderLists(this);
+
 			// Caching of rendering performance critical components
 			if (typeStr == "MeshFilter")
 			{
-				m_meshFilter = (MeshFilter*)component;
+				m_meshFilter = (MeshFilter*)(Component*)component;
 			}
 			else if (typeStr == "MeshRenderer")
 			{
-				m_meshRenderer = (MeshRenderer*)component;
+				m_meshRenderer = (MeshRenderer*)(Component*)component;
+			}
+
+			// Staged GameObjects are not part of the scene yet
+			if (!IsStaged())
+			{
+				EventSystem::Fire(ComponentAddedEvent{ this, component });
 			}
 
-			// Return it as a component of the requested type
-			return static_cast<T*>(component);
+			return component;
 		}
 
 		// Returns a component of type T (if it exists)
 		template <class T>
 		T* GetComponent()
 		{
+			// Components of a type share a pool, so the pool identifies the type
+			ComponentPoolBase* pool = &ComponentPool<T>::Get();
 			for (const auto& component : m_components)
 			{
-				if (typeid(T) != typeid(*component))
+				if (component->m_pool != pool)
 					continue;
 
 				return static_cast<T*>(component);
@@ -129,9 +155,10 @@ namespace Directus
 		std::vector<T*> GetComponents()
 		{
 			std::vector<T*> components;
+			ComponentPoolBase* pool = &ComponentPool<T>::Get();
 			for (const auto& component : m_components)
 			{
-				if (typeid(T) != typeid(*component))
+				if (component->m_pool != pool)
 					continue;
 
 				components.push_back(static_cast<T*>(component));
@@ -148,12 +175,14 @@ namespace Directus
 		template <class T>
 		void RemoveComponent()
 		{
+			ComponentPoolBase* pool = &ComponentPool<T>::Get();
 			for (auto it = m_components.begin(); it != m_components.end(); )
 			{
 				auto component = *it;
-				if (typeid(T) == typeid(*component))
+				if (component->m_pool == pool)
 				{
-					delete component;
+					ForgetCachedComponent(component);
+					pool->Free(component);
 					it = m_components.erase(it);
 				}
 				else
@@ -161,6 +190,8 @@ namespace Directus
 					++it;
 				}
 			}
+
+			m_context->GetSubsystem<Scene>()->UpdateRenderLists(this);
 		}
 
 		void RemoveComponentByID(const std::string& id);
@@ -172,11 +203,15 @@ namespace Directus
 		MeshRenderer* GetMeshRenderer() { return m_meshRenderer; }
 
 	private:
-		std::string m_ID;
+		// Builds instances without going through serialization
+		friend class Prefab;
+
+		unsigned long long m_ID;
 		std::string m_name;
 		bool m_isActive;
 		bool m_isPrefab;
 		bool m_hierarchyVisibility;
+		bool m_isStaged;
 		std::vector<Component*> m_components;
 
 		// Caching of performance critical components
@@ -189,6 +224,8 @@ namespace Directus
 
 		//= HELPER FUNCTIONS ====================================
 		Component* AddComponentBasedOnType(const std::string& typeStr);
+		static ComponentPoolBase* GetPoolBasedOnType(const std::string& typeStr);
+		void ForgetCachedComponent(Component* component);
 
 		template <class T>
 		static std::string GetTypeSTR()
@@ -197,4 +234,18 @@ namespace Directus
 			return typeStr.substr(typeStr.find_last_of(":") + 1); // e.g Transform
 		}
 	};
+
+	// Defined here as it needs both the pools and the GameObject
+	template <class First, class... Rest, typename Function>
+	void Scene::ForEach(Function&& function)
+	{
+		ComponentPool<First>::Get().ForEach([&function](First* component)
+		{
+			GameObject* gameObject = component->g_gameObject._Get();
+			if (!gameObject || gameObject->IsStaged())
+				return;
+
+			InvokeIfAll(function, component, gameObject->template GetComponent<Rest>()...);
+		});
+	}
 }
\ No newline at end of file
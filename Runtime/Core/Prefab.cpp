@@ -0,0 +1,419 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//= INCLUDES ===================================
+#include "Prefab.h"
+#include <cstring>
+#include <map>
+#include <unordered_map>
+#include "GameObject.h"
+#include "Scene.h"
+#include "Settings.h"
+#include "GUIDGenerator.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
+#include "../Logging/Log.h"
+#include "../Components/Transform.h"
+#include "../Components/MeshFilter.h"
+#include "../Components/MeshRenderer.h"
+#include "../Threading/Threading.h"
+//==============================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Directus::Math;
+//=============================
+
+namespace Directus
+{
+	//= PREFAB FORMAT ==========================================================================================
+	// [magic][version][node count][nodes, parents before children]
+	// node: [parent index][ID][name][isPrefab][isActive][hierarchyVisibility][component count][components]
+	// component: [type][size][the component's own serialization]
+	// The sizes let a component be deserialized on its own, so nothing has to be parsed per instance.
+	// Prefabs saved before this format are a plain GameObject serialization, see InstantiateLegacy().
+	static const char PREFAB_MAGIC[4] = { 'D', 'P', 'F', 'B' };
+	static const unsigned int PREFAB_VERSION = 1;
+	//===========================================================================================================
+
+	Prefab::Prefab(Context* context)
+	{
+		m_context = context;
+
+		//= RESOURCE INTERFACE =========
+		m_resourceID = GENERATE_GUID;
+		m_resourceType = Prefab_Resource;
+		//==============================
+
+		m_legacy = false;
+	}
+
+	Prefab::~Prefab()
+	{
+
+	}
+
+	//= RESOURCE INTERFACE ====================================================================
+	bool Prefab::LoadFromFile(const string& filePath)
+	{
+		BinaryReader reader;
+		if (!reader.LoadFromFile(filePath, m_context->GetSubsystem<Threading>()))
+			return false;
+
+		// The reader may own a decompressed copy, the template keeps one of its own
+		m_data.assign(reader.GetData(), reader.GetData() + reader.GetSize());
+
+		m_resourceFilePath = filePath;
+		m_resourceName = FileSystem::GetFileNameNoExtensionFromFilePath(filePath);
+
+		return Parse();
+	}
+
+	bool Prefab::SaveToFile(const string& filePath)
+	{
+		// The template is never modified, there is no metadata to save
+		if (filePath == RESOURCE_SAVE)
+			return true;
+
+		BinaryWriter writer;
+		writer.WriteBytes(m_data.data(), m_data.size());
+
+		return writer.SaveToFile(filePath, Settings::GetCompressAssets(), m_context->GetSubsystem<Threading>());
+	}
+	//=========================================================================================
+
+	bool Prefab::Save(GameObject* root, const string& filePath)
+	{
+		if (!root || !root->GetTransform())
+			return false;
+
+		// Depth first, so that every parent is written before its children
+		vector<pair<Transform*, int>> pending = { make_pair(root->GetTransform(), -1) };
+		vector<pair<Transform*, int>> nodes;
+		while (!pending.empty())
+		{
+			auto node = pending.back();
+			pending.pop_back();
+
+			int index = (int)nodes.size();
+			nodes.push_back(node);
+
+			// Pushed in reverse so that they come out in order
+			const auto& children = node.first->GetChildren();
+			for (auto it = children.rbegin(); it != children.rend(); ++it)
+			{
+				pending.push_back(make_pair(*it, index));
+			}
+		}
+
+		BinaryWriter writer;
+		writer.WriteBytes(PREFAB_MAGIC, sizeof(PREFAB_MAGIC));
+		writer.WriteUINT(PREFAB_VERSION);
+		writer.WriteUINT((unsigned int)nodes.size());
+
+		BinaryWriter componentWriter;
+		for (const auto& node : nodes)
+		{
+			GameObject* gameObject = node.first->GetGameObject()._Get();
+			if (!gameObject)
+			{
+				LOG_ERROR("Prefab: Aborting \"" + filePath + "\", a GameObject of the hierarchy is nullptr.");
+				return false;
+			}
+
+			writer.WriteInt(node.second);
+			writer.WriteSTR(to_string(gameObject->GetID()));
+			writer.WriteSTR(gameObject->GetName());
+			writer.WriteBool(gameObject->m_isPrefab);
+			writer.WriteBool(gameObject->m_isActive);
+			writer.WriteBool(gameObject->m_hierarchyVisibility);
+
+			writer.WriteUINT((unsigned int)gameObject->m_components.size());
+			for (const auto& component : gameObject->m_components)
+			{
+				componentWriter.Clear();
+				component->Serialize(&componentWriter);
+
+				writer.WriteSTR(component->g_type);
+				writer.WriteUINT((unsigned int)componentWriter.GetSize());
+				writer.WriteBytes(componentWriter.GetData(), componentWriter.GetSize());
+			}
+		}
+
+		return writer.SaveToFile(filePath, Settings::GetCompressAssets(), root->m_context->GetSubsystem<Threading>());
+	}
+
+	bool Prefab::Instantiate(GameObject* root)
+	{
+		if (!root || !root->GetTransform())
+			return false;
+
+		if (m_legacy)
+			return InstantiateLegacy(root);
+
+		if (m_nodes.empty())
+		{
+			LOG_WARNING("Prefab: \"" + m_resourceFilePath + "\" has nothing to instantiate.");
+			return false;
+		}
+
+		// Make room for all the components at once
+		for (const auto& usage : m_poolUsage)
+		{
+			usage.first->Reserve(usage.second);
+		}
+
+		//= GAMEOBJECTS ========================================================================
+		// All of them exist before any component is deserialized, as components can refer to
+		// other GameObjects of the prefab (e.g. a hinge). Those references go through the remap.
+		auto scene = m_context->GetSubsystem<Scene>();
+		vector<GameObject*> gameObjects(m_nodes.size());
+		unordered_map<unsigned long long, unsigned long long> remap;
+		remap.reserve(m_nodes.size());
+		for (size_t i = 0; i < m_nodes.size(); i++)
+		{
+			const PrefabNode& node = m_nodes[i];
+			GameObject* gameObject = (i == 0) ? root : scene->CreateGameObject()._Get();
+
+			gameObject->m_isPrefab = node.isPrefab;
+			gameObject->m_isActive = node.isActive;
+			gameObject->m_hierarchyVisibility = node.hierarchyVisibility;
+			gameObject->SetName(node.name);
+			gameObject->m_components.reserve(node.componentCount);
+			remap[node.ID] = gameObject->GetID();
+
+			// Parents come first and the GameObject is new, so there is no hierarchy to resolve
+			if (node.parent != -1)
+			{
+				gameObjects[node.parent]->GetTransform()->AttachNewChild(gameObject->GetTransform());
+			}
+
+			gameObjects[i] = gameObject;
+		}
+		//======================================================================================
+
+		//= COMPONENTS =========================================================================
+		scene->SetIDRemap(&remap);
+		vector<Component*> components;
+		for (size_t i = 0; i < m_nodes.size(); i++)
+		{
+			const PrefabNode& node = m_nodes[i];
+			GameObject* gameObject = gameObjects[i];
+
+			// As with deserialization, the components are all created before any of them
+			// is deserialized, e.g. a collider needs to find the rigidbody.
+			components.clear();
+			for (int j = node.firstComponent; j < node.firstComponent + node.componentCount; j++)
+			{
+				const PrefabComponent& prefabComponent = m_components[j];
+				Component* component = (prefabComponent.kind == Component_Transform) ? gameObject->GetTransform() : gameObject->AddComponentBasedOnType(prefabComponent.type);
+				if (!component)
+				{
+					LOG_WARNING("Prefab: Unknown component type \"" + prefabComponent.type + "\" in \"" + m_resourceFilePath + "\".");
+				}
+				components.push_back(component);
+			}
+
+			for (int j = 0; j < node.componentCount; j++)
+			{
+				Component* component = components[j];
+				if (!component)
+					continue;
+
+				int index = node.firstComponent + j;
+				const PrefabComponent& prefabComponent = m_components[index];
+				BinaryReader reader(m_data.data() + prefabComponent.offset, prefabComponent.size);
+
+				if (prefabComponent.kind == Component_Transform)
+				{
+					// The hierarchy is already built
+					static_cast<Transform*>(component)->DeserializeLocal(&reader);
+				}
+				else if (prefabComponent.kind == Component_MeshFilter)
+				{
+					auto meshFilter = static_cast<MeshFilter*>(component);
+
+					SharedResources shared;
+					{
+						lock_guard<mutex> lock(m_sharedMutex);
+						shared = m_shared[index];
+					}
+
+					// Share the mesh and its buffers, unless the model has been unloaded meanwhile
+					if (shared.resolved && meshFilter->SetMeshShared((MeshFilter::MeshType)shared.meshType, shared.mesh, shared.vertexBuffer, shared.indexBuffer, shared.boundingBox))
+						continue;
+
+					meshFilter->Deserialize(&reader);
+					if (!meshFilter->HasMesh() || !meshFilter->GetVertexBuffer() || !meshFilter->GetIndexBuffer())
+						continue;
+
+					lock_guard<mutex> lock(m_sharedMutex);
+					SharedResources& resolved = m_shared[index];
+					resolved.resolved = true;
+					resolved.meshType = (int)meshFilter->GetMeshType();
+					resolved.mesh = meshFilter->GetMesh();
+					resolved.vertexBuffer = meshFilter->GetVertexBuffer();
+					resolved.indexBuffer = meshFilter->GetIndexBuffer();
+					resolved.boundingBox = meshFilter->GetBoundingBox();
+				}
+				else if (prefabComponent.kind == Component_MeshRenderer)
+				{
+					auto meshRenderer = static_cast<MeshRenderer*>(component);
+
+					SharedResources shared;
+					{
+						lock_guard<mutex> lock(m_sharedMutex);
+						shared = m_shared[index];
+					}
+
+					// Share the material, unless it has been unloaded meanwhile
+					if (shared.resolved && !shared.material.expired())
+					{
+						meshRenderer->SetMaterialShared(shared.material, (MaterialType)shared.materialType);
+						meshRenderer->SetCastShadows(shared.castShadows);
+						meshRenderer->SetReceiveShadows(shared.receiveShadows);
+						continue;
+					}
+
+					meshRenderer->Deserialize(&reader);
+
+					// The skybox material is managed by the skybox component
+					if (!meshRenderer->HasMaterial() || meshRenderer->GetMaterialType() == Material_Skybox)
+						continue;
+
+					lock_guard<mutex> lock(m_sharedMutex);
+					SharedResources& resolved = m_shared[index];
+					resolved.resolved = true;
+					resolved.materialType = (int)meshRenderer->GetMaterialType();
+					resolved.material = meshRenderer->GetMaterial();
+					resolved.castShadows = meshRenderer->GetCastShadows();
+					resolved.receiveShadows = meshRenderer->GetReceiveShadows();
+				}
+				else
+				{
+					component->Deserialize(&reader);
+				}
+			}
+		}
+		scene->SetIDRemap(nullptr);
+		//======================================================================================
+
+		return true;
+	}
+
+	bool Prefab::Parse()
+	{
+		m_nodes.clear();
+		m_components.clear();
+		m_poolUsage.clear();
+		{
+			lock_guard<mutex> lock(m_sharedMutex);
+			m_shared.clear();
+		}
+
+		// Older prefabs can only be deserialized as a whole
+		m_legacy = m_data.size() < sizeof(PREFAB_MAGIC) || memcmp(m_data.data(), PREFAB_MAGIC, sizeof(PREFAB_MAGIC)) != 0;
+		if (m_legacy)
+			return !m_data.empty();
+
+		BinaryReader reader(m_data.data(), m_data.size());
+		reader.Skip(sizeof(PREFAB_MAGIC));
+
+		unsigned int version = reader.ReadUINT();
+		if (version != PREFAB_VERSION)
+		{
+			LOG_ERROR("Prefab: \"" + m_resourceFilePath + "\" has an unsupported version (" + to_string(version) + ").");
+			return false;
+		}
+
+		map<string, int> componentsPerType;
+		unsigned int nodeCount = reader.ReadUINT();
+		for (unsigned int i = 0; i < nodeCount && reader.IsValid(); i++)
+		{
+			PrefabNode node;
+			node.parent = reader.ReadInt();
+			node.ID = GUIDGenerator::IDFromString(reader.ReadSTR());
+			node.name = reader.ReadSTR();
+			node.isPrefab = reader.ReadBool();
+			node.isActive = reader.ReadBool();
+			node.hierarchyVisibility = reader.ReadBool();
+			node.firstComponent = (int)m_components.size();
+			node.componentCount = (int)reader.ReadUINT();
+
+			// Only the first node is a root and parents come before their children
+			bool validParent = (i == 0) ? node.parent == -1 : (node.parent >= 0 && node.parent < (int)i);
+			if (!validParent || node.componentCount < 0)
+			{
+				LOG_ERROR("Prefab: \"" + m_resourceFilePath + "\" is corrupt.");
+				m_nodes.clear();
+				return false;
+			}
+
+			for (int j = 0; j < node.componentCount && reader.IsValid(); j++)
+			{
+				PrefabComponent component;
+				component.type = reader.ReadSTR();
+				component.size = reader.ReadUINT();
+				component.offset = reader.GetPosition();
+				reader.Skip(component.size);
+
+				if (component.type == "Transform")			component.kind = Component_Transform;
+				else if (component.type == "MeshFilter")	component.kind = Component_MeshFilter;
+				else if (component.type == "MeshRenderer")	component.kind = Component_MeshRenderer;
+				else										component.kind = Component_Generic;
+
+				componentsPerType[component.type]++;
+				m_components.push_back(component);
+			}
+
+			m_nodes.push_back(node);
+		}
+
+		if (!reader.IsValid() || m_nodes.empty())
+		{
+			LOG_ERROR("Prefab: \"" + m_resourceFilePath + "\" is corrupt.");
+			m_nodes.clear();
+			m_components.clear();
+			return false;
+		}
+
+		for (const auto& type : componentsPerType)
+		{
+			if (ComponentPoolBase* pool = GameObject::GetPoolBasedOnType(type.first))
+			{
+				m_poolUsage.push_back(make_pair(pool, type.second));
+			}
+		}
+
+		lock_guard<mutex> lock(m_sharedMutex);
+		m_shared.resize(m_components.size());
+
+		return true;
+	}
+
+	bool Prefab::InstantiateLegacy(GameObject* root)
+	{
+		// Deserialized in full every time, but from memory instead of the disk
+		BinaryReader reader(m_data.data(), m_data.size());
+		root->Deserialize(&reader, nullptr);
+
+		return reader.IsValid();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#pragma once
+
+//= INCLUDES =======================
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../Resource/Resource.h"
+#include "../Math/BoundingBox.h"
+//==================================
+
+namespace Directus
+{
+	class GameObject;
+	class ComponentPoolBase;
+	class Mesh;
+	class Material;
+	class D3D11VertexBuffer;
+	class D3D11IndexBuffer;
+
+	// A prefab file parsed once into an immutable template. Instances are built from memory, with
+	// IDs of their own, and share the meshes, GPU buffers and materials the first instance resolved.
+	class DLL_API Prefab : public Resource
+	{
+	public:
+		Prefab(Context* context);
+		~Prefab();
+
+		//= RESOURCE INTERFACE ================================
+		virtual bool LoadFromFile(const std::string& filePath);
+		virtual bool SaveToFile(const std::string& filePath);
+		virtual unsigned long long GetMemoryUsageCPU() { return m_data.size(); }
+		//======================================================
+
+		// Writes a GameObject and its descendants as a prefab file
+		static bool Save(GameObject* root, const std::string& filePath);
+
+		// Turns a new GameObject (e.g. from Scene::CreateGameObject()) into an instance of the prefab
+		bool Instantiate(GameObject* root);
+
+	private:
+		enum ComponentKind
+		{
+			Component_Generic,
+			Component_Transform,
+			Component_MeshFilter,
+			Component_MeshRenderer
+		};
+
+		struct PrefabComponent
+		{
+			std::string type;
+			ComponentKind kind;
+			size_t offset; // of the serialized component within m_data
+			size_t size;
+		};
+
+		struct PrefabNode
+		{
+			int parent; // index of the parent node, -1 for the root
+			unsigned long long ID; // as saved, instances get new ones
+			std::string name;
+			bool isPrefab;
+			bool isActive;
+			bool hierarchyVisibility;
+			int firstComponent;
+			int componentCount;
+		};
+
+		// What a MeshFilter or MeshRenderer of the first instance resolved to
+		struct SharedResources
+		{
+			bool resolved = false;
+			int meshType = 0;
+			std::weak_ptr<Mesh> mesh;
+			std::shared_ptr<D3D11VertexBuffer> vertexBuffer;
+			std::shared_ptr<D3D11IndexBuffer> indexBuffer;
+			Math::BoundingBox boundingBox;
+			int materialType = 0;
+			std::weak_ptr<Material> material;
+			bool castShadows = true;
+			bool receiveShadows = true;
+		};
+
+		bool Parse();
+		bool InstantiateLegacy(GameObject* root);
+
+		std::vector<char> m_data;
+		bool m_legacy;
+		std::vector<PrefabNode> m_nodes;
+		std::vector<PrefabComponent> m_components;
+		std::vector<std::pair<ComponentPoolBase*, int>> m_poolUsage; // components per pool, for one instance
+
+		// One per component, instances can be made from any thread
+		std::vector<SharedResources> m_shared;
+		std::mutex m_sharedMutex;
+	};
+}
\ No newline at end of file
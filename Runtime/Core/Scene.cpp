@@ -21,7 +21,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ===========================
 #include "Scene.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
+#include "../IO/MemoryMappedFile.h"
+#include "../IO/BlockCompression.h"
 #include "../FileSystem/FileSystem.h"
 #include "../Logging/Log.h"
 #include "../Graphics//Renderer.h"
@@ -32,12 +35,31 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Components/Skybox.h"
 #include "../Components/Script.h"
 #include "../Components/MeshFilter.h"
+#include "../Components/RigidBody.h"
+#include "../Components/Collider.h"
+#include "../Components/MeshCollider.h"
+#include "../Components/Hinge.h"
+#include "../Components/AudioSource.h"
+#include "../Components/AudioListener.h"
+#include "../Graphics/Model.h"
+#include "../Graphics/Material.h"
 #include "../Physics/Physics.h"
 #include "../EventSystem/EventSystem.h"
 #include "../Core/Context.h"
 #include "../Resource/ResourceManager.h"
 #include "Timer.h"
+#include "Scheduler.h"
+#include "GUIDGenerator.h"
+#include "Settings.h"
 #include "../Components/Light.h"
+#include "../Profiling/Profiler.h"
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <unordered_set>
+#include <fstream>
+#include <cmath>
+#include <cstring>
 //======================================
 
 //= NAMESPACES ================
@@ -47,9 +69,324 @@ using namespace Directus::Math;
 
 namespace Directus
 {
+	// GameObjects created by a thread which is staging
+	static thread_local bool t_staging = false;
+	static thread_local GameObjectList t_stagedGameObjects;
+	// IDs which GetGameObjectByID() translates, see SetIDRemap()
+	static thread_local const unordered_map<unsigned long long, unsigned long long>* t_idRemap = nullptr;
+
+	//= SCENE FORMAT ==========================================================================================
+	// [header][table of contents, one entry per root][resource paths][root subtrees, each one self-contained]
+	// The offsets let the resources and every root subtree be read on their own, so they can load in parallel.
+	static const char SCENE_MAGIC[4] = { 'D', 'S', 'C', 'N' };
+	static const uint32_t SCENE_VERSION = 1;
+
+	struct SceneFileHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t rootCount;
+		uint32_t flags; // none defined yet
+		uint64_t resourcesOffset;
+		uint64_t resourcesSize;
+	};
+
+	enum SceneRootFlags : uint32_t
+	{
+		SceneRoot_MainThread = 1 << 0 // has components which can only be created on the main thread
+	};
+
+	struct SceneFileRoot
+	{
+		uint64_t offset;
+		uint64_t size;
+		uint32_t gameObjectCount;
+		uint32_t flags;
+	};
+
+	static_assert(sizeof(SceneFileHeader) == 32 && sizeof(SceneFileRoot) == 24, "The scene file structures must not contain padding");
+
+	// A scene file read into memory, with its table of contents validated
+	struct SceneFile
+	{
+		BinaryReader reader;
+		std::vector<std::string> resourcePaths;
+		std::vector<SceneFileRoot> roots;
+		bool legacy = false; // saved before the table of contents existed
+	};
+
+	// Validates the table of contents of a scene file the reader holds, the name is only used for errors
+	static bool ParseSceneFile(SceneFile& file, const string& name)
+	{
+		// Legacy files start with the resource paths, followed by the GameObjects
+		const char* data = file.reader.GetData();
+		uint64_t size = file.reader.GetSize();
+		if (size < sizeof(SceneFileHeader) || memcmp(data, SCENE_MAGIC, sizeof(SCENE_MAGIC)) != 0)
+		{
+			file.legacy = true;
+			file.resourcePaths = file.reader.ReadVectorSTR();
+			return file.reader.IsValid();
+		}
+
+		SceneFileHeader header;
+		memcpy(&header, data, sizeof(header));
+		if (header.version != SCENE_VERSION)
+		{
+			LOG_ERROR("Scene: \"" + name + "\" has an unsupported version (" + to_string(header.version) + ").");
+			return false;
+		}
+
+		uint64_t contentsSize = (uint64_t)header.rootCount * sizeof(SceneFileRoot);
+		bool valid = contentsSize <= size - sizeof(SceneFileHeader) && header.resourcesOffset <= size && header.resourcesSize <= size - header.resourcesOffset;
+		if (valid)
+		{
+			file.roots.resize(header.rootCount);
+			memcpy(file.roots.data(), data + sizeof(SceneFileHeader), (size_t)contentsSize);
+			for (const auto& root : file.roots)
+			{
+				valid = valid && root.offset <= size && root.size <= size - root.offset;
+			}
+		}
+
+		if (valid)
+		{
+			BinaryReader resources(data + header.resourcesOffset, (size_t)header.resourcesSize);
+			file.resourcePaths = resources.ReadVectorSTR();
+			valid = resources.IsValid();
+		}
+
+		if (!valid)
+		{
+			LOG_ERROR("Scene: \"" + name + "\" is truncated or corrupt.");
+			file.roots.clear();
+		}
+
+		return valid;
+	}
+
+	static bool ReadSceneFile(const string& filePath, SceneFile& file, Threading* threading)
+	{
+		return file.reader.LoadFromFile(filePath, threading) && ParseSceneFile(file, filePath);
+	}
+
+	// Components which register with subsystems that may only be used from the main thread
+	static bool HasMainThreadComponents(GameObject* gameObject)
+	{
+		return 
+			gameObject->HasComponent<RigidBody>() ||
+			gameObject->HasComponent<Collider>() ||
+			gameObject->HasComponent<MeshCollider>() ||
+			gameObject->HasComponent<Hinge>() ||
+			gameObject->HasComponent<Script>() ||
+			gameObject->HasComponent<AudioSource>() ||
+			gameObject->HasComponent<AudioListener>();
+	}
+
+	// Fills in the table of contents entry of a root, apart from its offset and size
+	static void DescribeSubtree(GameObject* gameObject, SceneFileRoot& root)
+	{
+		root.gameObjectCount++;
+		if (HasMainThreadComponents(gameObject))
+		{
+			root.flags |= SceneRoot_MainThread;
+		}
+
+		for (const auto& child : gameObject->GetTransform()->GetChildren())
+		{
+			if (!child->g_gameObject.expired())
+			{
+				DescribeSubtree(child->g_gameObject._Get(), root);
+			}
+		}
+	}
+
+	// Writes the given roots and their descendants, along with the resources they need
+	static void WriteSceneFile(const vector<weakGameObj>& rootGameObjects, const vector<string>& resourcePaths, BinaryWriter& writer)
+	{
+		vector<SceneFileRoot> contents(rootGameObjects.size(), SceneFileRoot{ 0, 0, 0, 0 });
+		uint64_t contentsEnd = sizeof(SceneFileHeader) + contents.size() * sizeof(SceneFileRoot);
+
+		// The body goes right after the table of contents, which can only be filled in once it's written
+		BinaryWriter body;
+
+		//= Save resource paths ========================================================================
+		SceneFileHeader header = {};
+		memcpy(header.magic, SCENE_MAGIC, sizeof(header.magic));
+		header.version = SCENE_VERSION;
+		header.rootCount = (uint32_t)rootGameObjects.size();
+		header.resourcesOffset = contentsEnd;
+		body.WriteVectorSTR(resourcePaths);
+		header.resourcesSize = body.GetSize();
+		//==============================================================================================
+
+		//= Save GameObjects ============================
+		for (size_t i = 0; i < rootGameObjects.size(); i++)
+		{
+			GameObject* root = rootGameObjects[i]._Get();
+			contents[i].offset = contentsEnd + body.GetSize();
+			root->Serialize(&body);
+			contents[i].size = contentsEnd + body.GetSize() - contents[i].offset;
+			DescribeSubtree(root, contents[i]);
+		}
+		//==============================================
+
+		writer.Reserve((size_t)contentsEnd + body.GetSize());
+		writer.WriteBytes(&header, sizeof(header));
+		writer.WriteArray(contents.data(), contents.size());
+		writer.WriteBytes(body.GetData(), body.GetSize());
+	}
+	//=========================================================================================================
+
+	//= STREAMING FORMAT ======================================================================================
+	// [header][cell table][resident chunk][cell chunks], every chunk is a scene file image of its own (compressed
+	// on its own, if at all) listing just the resources it needs. The file is mapped and a cell read in place.
+	static const char STREAM_MAGIC[4] = { 'D', 'S', 'T', 'R' };
+	static const uint32_t STREAM_VERSION = 1;
+	// Cells committed per frame and cells loading at once, which bounds both the hitches and the memory
+	static const int MAX_CELL_COMMITS_PER_FRAME = 1;
+	static const int MAX_CELL_LOADS_IN_FLIGHT = 4;
+
+	struct SceneStreamHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t cellCount;
+		float cellSize;
+		uint64_t residentOffset; // what is always loaded, e.g. cameras and directional lights
+		uint64_t residentSize;
+	};
+
+	struct SceneStreamCell
+	{
+		int32_t x; // the cell covers [x, x + 1) * cellSize
+		int32_t z; // the cell covers [z, z + 1) * cellSize
+		uint64_t offset;
+		uint64_t size;
+	};
+
+	static_assert(sizeof(SceneStreamHeader) == 32 && sizeof(SceneStreamCell) == 24, "The streaming file structures must not contain padding");
+
+	enum CellState
+	{
+		Cell_Unloaded,
+		Cell_Loading,
+		Cell_Loaded,
+		Cell_Failed // corrupt, it won't be tried again
+	};
+
+	// A cell decoded on a worker, waiting to be committed
+	struct CellLoad
+	{
+		SceneFile file;
+		vector<shared_ptr<GameObjectList>> stagedRoots;
+		bool acquired = false; // holds references to the resources of the cell
+	};
+
+	struct StreamingCell
+	{
+		SceneStreamCell entry;
+		CellState state = Cell_Unloaded;
+		vector<weakGameObj> roots;
+		vector<string> resourcePaths; // referenced for as long as the cell is loaded
+	};
+
+	// A streaming file the scene is streaming from, apart from the file and the token it's only touched on the main thread
+	struct SceneStream
+	{
+		MemoryMappedFile file;
+		float cellSize = 0.0f;
+		vector<StreamingCell> cells;
+		deque<pair<size_t, shared_ptr<CellLoad>>> finished;
+		int loadsInFlight = 0;
+		CancellationToken token;
+	};
+
+	static bool IsStreamingFile(const string& filePath)
+	{
+		char magic[sizeof(STREAM_MAGIC)] = {};
+		ifstream in(filePath, ios::in | ios::binary);
+		return in.read(magic, sizeof(magic)) && memcmp(magic, STREAM_MAGIC, sizeof(magic)) == 0;
+	}
+
+	// Cameras, skyboxes and directional lights aren't anywhere in particular, their subtrees are always loaded
+	static bool StaysResident(GameObject* gameObject)
+	{
+		Light* light = gameObject->GetComponent<Light>();
+		if (gameObject->HasComponent<Camera>() || gameObject->HasComponent<Skybox>() || (light && light->GetLightType() == Directional))
+			return true;
+
+		for (const auto& child : gameObject->GetTransform()->GetChildren())
+		{
+			if (!child->g_gameObject.expired() && StaysResident(child->g_gameObject._Get()))
+				return true;
+		}
+
+		return false;
+	}
+
+	// The resources a GameObject refers to, its children aside
+	template <typename Add>
+	static void ForEachResourcePath(GameObject* gameObject, ResourceManager* resourceMng, Add add)
+	{
+		MeshFilter* meshFilter = gameObject->GetComponent<MeshFilter>();
+		if (meshFilter && !meshFilter->GetMesh().expired())
+		{
+			auto model = resourceMng->GetResourceByID<Model>(meshFilter->GetMesh()._Get()->GetModelID());
+			if (!model.expired())
+			{
+				add(model._Get()->GetResourceFilePath());
+			}
+		}
+
+		MeshRenderer* meshRenderer = gameObject->GetComponent<MeshRenderer>();
+		if (meshRenderer && !meshRenderer->GetMaterial().expired())
+		{
+			Material* material = meshRenderer->GetMaterial()._Get();
+			for (const auto& texturePath : material->GetTexturePaths())
+			{
+				add(texturePath);
+			}
+			add(material->GetResourceFilePath());
+		}
+	}
+
+	// The resources a subtree refers to, which are all that need to be loaded for it
+	static void CollectResourcePaths(GameObject* gameObject, ResourceManager* resourceMng, vector<string>& resourcePaths)
+	{
+		ForEachResourcePath(gameObject, resourceMng, [&resourcePaths](const string& resourcePath)
+		{
+			if (!resourcePath.empty() && resourcePath != DATA_NOT_ASSIGNED && find(resourcePaths.begin(), resourcePaths.end(), resourcePath) == resourcePaths.end())
+			{
+				resourcePaths.push_back(resourcePath);
+			}
+		});
+
+		for (const auto& child : gameObject->GetTransform()->GetChildren())
+		{
+			if (!child->g_gameObject.expired())
+			{
+				CollectResourcePaths(child->g_gameObject._Get(), resourceMng, resourcePaths);
+			}
+		}
+	}
+
+	// Distance on the XZ plane from a position to the closest point of a cell
+	static float CellDistance(const SceneStreamCell& cell, float cellSize, const Vector3& position)
+	{
+		float minX = cell.x * cellSize;
+		float minZ = cell.z * cellSize;
+		float dx = max(max(minX - position.x, position.x - (minX + cellSize)), 0.0f);
+		float dz = max(max(minZ - position.z, position.z - (minZ + cellSize)), 0.0f);
+
+		return sqrt(dx * dx + dz * dz);
+	}
+	//=========================================================================================================
+
 	Scene::Scene(Context* context) : Subsystem(context)
 	{
 		m_ambientLight = Vector3::Zero;
+		m_hierarchyDirty = true;
+		m_streamingRadius = 100.0f;
 	}
 
 	Scene::~Scene()
@@ -62,17 +399,23 @@ namespace Directus
 		m_mainCamera = CreateCamera();
 		CreateSkybox();
 		CreateDirectionalLight();
-		Resolve();
 
-		SUBSCRIBE_TO_EVENT(EVENT_UPDATE, this, Scene::Resolve);
-		SUBSCRIBE_TO_EVENT(EVENT_RENDER, this, Scene::Update);
+		Scheduler* scheduler = m_context->GetSubsystem<Scheduler>();
+		// After physics (which moves rigid bodies) and before rendering, so the renderer's parallel passes only ever read
+		scheduler->AddJob("Transforms", Stage_Update,
+			Frame_SceneGraph, Frame_Transforms, false,
+			bind(&Scene::UpdateTransforms, this));
+		// Scripts, rigid bodies and audio sources are updated here, none of which are thread safe
+		scheduler->AddJob("Scene Update", Stage_Render,
+			Frame_Input, Frame_Transforms | Frame_SceneGraph | Frame_RenderLists | Frame_Physics | Frame_Audio | Frame_Scripts, true,
+			bind(&Scene::Update, this));
 
 		return true;
 	}
 
 	void Scene::Start()
 	{
-		for (const auto& gameObject : m_gameObjects)
+		for (const auto& gameObject : m_gameObjects.Get())
 		{
 			gameObject->Start();
 		}
@@ -80,7 +423,7 @@ namespace Directus
 
 	void Scene::OnDisable()
 	{
-		for (const auto& gameObject : m_gameObjects)
+		for (const auto& gameObject : m_gameObjects.Get())
 		{
 			gameObject->OnDisable();
 		}
@@ -88,27 +431,37 @@ namespace Directus
 
 	void Scene::Update()
 	{
-		for (const auto& gameObject : m_gameObjects)
+		for (const auto& gameObject : m_gameObjects.Get())
 		{
 			gameObject->Update();
 		}
 
+		UpdateStreaming();
+		UpdateResidency();
 		CalculateFPS();
 	}
 
 	void Scene::Clear()
 	{
-		m_gameObjects.clear();
-		m_gameObjects.shrink_to_fit();
+		ClearKeepingResources(vector<string>());
+	}
+
+	void Scene::ClearKeepingResources(const vector<string>& resourcePaths)
+	{
+		// Before the resources go, so that no cell can reference them from now on
+		CloseStream();
 
-		m_renderables.clear();
-		m_renderables.shrink_to_fit();
+		// Empty the render lists first, so the GameObjects have nothing to remove themselves from
+		m_renderables.Clear();
+		m_lights.Clear();
+		m_mainCamera.reset();
+		m_skybox.reset();
 
-		m_lights.clear();
-		m_lights.shrink_to_fit();
+		m_gameObjects.Clear();
+		m_hierarchyDirty = true;
 
 		// Clear the resource cache
-		m_context->GetSubsystem<ResourceManager>()->Unload();
+		m_context->GetSubsystem<ResourceManager>()->UnloadExcept(resourcePaths);
 
 		// Clear/Reset subsystems that allocate some things
 		m_context->GetSubsystem<Scripting>()->Reset();
@@ -118,18 +471,75 @@ namespace Directus
 	//=========================================================================================================
 
 	//= I/O ===================================================================================================
-	void Scene::SaveToFileAsync(const string& filePath)
+	TaskHandle Scene::SaveToFileAsync(const string& filePath)
 	{
-		m_context->GetSubsystem<Threading>()->AddTask(std::bind(&Scene::SaveToFile, this, filePath));
+		return m_context->GetSubsystem<Threading>()->AddTask(std::bind(&Scene::SaveToFile, this, filePath));
 	}
 
-	void Scene::LoadFromFileAsync(const string& filePath)
+	TaskHandle Scene::LoadFromFileAsync(const string& filePath)
 	{
-		m_context->GetSubsystem<Threading>()->AddTask(std::bind(&Scene::LoadFromFile, this, filePath));
+		if (!FileSystem::FileExists(filePath))
+		{
+			LOG_ERROR(filePath + " was not found.");
+			return TaskHandle();
+		}
+
+		// Whatever was loading for the current scene (or a previous async load) is of no use now
+		ResourceManager* resourceMng = m_context->GetSubsystem<ResourceManager>();
+		resourceMng->CancelAllLoading();
+		CancellationToken token = resourceMng->GetLoadingToken(filePath);
+
+		return m_context->GetSubsystem<Threading>()->AddTask([this, filePath, token]
+		{
+			// Only the resident part of a streaming file loads up front, which is quick, the cells follow on their own
+			if (IsStreamingFile(filePath))
+			{
+				QueueCommand([this, filePath, token]
+				{
+					if (!token.IsCancelled())
+					{
+						LoadFromStreamingFile(filePath);
+						m_context->GetSubsystem<ResourceManager>()->FinishLoading(filePath, token);
+					}
+				});
+				return;
+			}
+
+			// The file is read once, everything gets deserialized from the same buffer
+			auto file = make_shared<SceneFile>();
+			if (!ReadSceneFile(filePath, *file, m_context->GetSubsystem<Threading>()))
+			{
+				m_context->GetSubsystem<ResourceManager>()->FinishLoading(filePath, token);
+				return;
+			}
+
+			// The expensive part, resources the current scene shares with the new one are reused
+			LoadResources(file->resourcePaths, &token);
+
+			// Most of the GameObjects can be built on the workers, off to the side
+			auto stagedRoots = make_shared<vector<shared_ptr<GameObjectList>>>(StageRoots(*file, &token));
+
+			// Swap the GameObjects while nobody is iterating over them
+			QueueCommand([this, filePath, file, stagedRoots, token]
+			{
+				// Staged GameObjects are freed here either way, on the main thread
+				if (token.IsCancelled())
+				{
+					stagedRoots->clear();
+					return;
+				}
+
+				ClearKeepingResources(file->resourcePaths);
+				CommitRoots(*file, *stagedRoots);
+				m_context->GetSubsystem<ResourceManager>()->FinishLoading(filePath, token);
+			});
+		}, Priority_Normal, token);
 	}
 
 	bool Scene::SaveToFile(const string& filePathIn)
 	{
+		PROFILE_FUNCTION();
+
 		// Add scene file extension to the filepath if it's missing
 		string filePath = filePathIn;
 		if (FileSystem::GetExtensionFromFilePath(filePath) != SCENE_EXTENSION)
@@ -140,113 +550,591 @@ namespace Directus
 		// Save any in-memory changes done to resources while running.
 		m_context->GetSubsystem<ResourceManager>()->SaveResourceMetadata();
 
-		if (!StreamIO::StartWriting(filePath))
+		// Only save root GameObjects as they will also save their descendants
+		BinaryWriter writer;
+		WriteSceneFile(GetRootGameObjects(), m_context->GetSubsystem<ResourceManager>()->GetResourceFilePaths(), writer);
+
+		return writer.SaveToFile(filePath, Settings::GetCompressAssets(), m_context->GetSubsystem<Threading>());
+	}
+
+	bool Scene::LoadFromFile(const string& filePath)
+	{
+		PROFILE_FUNCTION();
+
+		if (!FileSystem::FileExists(filePath))
+		{
+			LOG_ERROR(filePath + " was not found.");
 			return false;
+		}
 
-		//= Save currently loaded resource paths =======================================================
-		vector<string> resourcePaths = m_context->GetSubsystem<ResourceManager>()->GetResourceFilePaths();
-		StreamIO::WriteVectorSTR(resourcePaths);
-		//==============================================================================================
+		if (IsStreamingFile(filePath))
+			return LoadFromStreamingFile(filePath);
 
-		//= Save GameObjects ============================
-		// Only save root GameObjects as they will also save their descendants
-		vector<weakGameObj> rootGameObjects = GetRootGameObjects();
+		Clear();
 
+		SceneFile file;
+		if (!ReadSceneFile(filePath, file, m_context->GetSubsystem<Threading>()))
+			return false;
+
+		// Load all the resources first, the GameObjects refer to them
+		LoadResources(file.resourcePaths);
+
+		auto stagedRoots = StageRoots(file, nullptr);
+		return CommitRoots(file, stagedRoots);
+	}
+
+	void Scene::LoadResources(const vector<string>& resourcePaths, const CancellationToken* token)
+	{
+		PROFILE_FUNCTION();
+
+		auto resourceMng = m_context->GetSubsystem<ResourceManager>();
+
+		// Textures aren't waited for, materials render with placeholders until theirs arrive
+		vector<string> modelPaths;
+		vector<string> materialPaths;
+		for (const auto& resourcePath : resourcePaths)
+		{
+			if (FileSystem::IsEngineMaterialFile(resourcePath))
+			{
+				materialPaths.push_back(resourcePath);
+			}
+			else if (FileSystem::IsEngineModelFile(resourcePath))
+			{
+				modelPaths.push_back(resourcePath);
+			}
+			else if (FileSystem::IsSupportedImageFile(resourcePath) && !(token && token->IsCancelled()))
+			{
+				resourceMng->LoadAsync<Texture>(resourcePath);
+			}
+		}
+
+		// The GameObjects need the models and materials, every one of them loads as a task of its own
+		auto threading = m_context->GetSubsystem<Threading>();
+		threading->ParallelFor(0, modelPaths.size(), 1, [resourceMng, token, &modelPaths](size_t i)
+		{
+			if (token && token->IsCancelled())
+				return;
+
+			resourceMng->Load<Model>(modelPaths[i]);
+		});
+
+		threading->ParallelFor(0, materialPaths.size(), 1, [resourceMng, token, &materialPaths](size_t i)
+		{
+			if (token && token->IsCancelled())
+				return;
+
+			resourceMng->Load<Material>(materialPaths[i]);
+		});
+	}
+
+	vector<shared_ptr<GameObjectList>> Scene::StageRoots(const SceneFile& file, const CancellationToken* token)
+	{
+		PROFILE_FUNCTION();
+
+		vector<shared_ptr<GameObjectList>> stagedRoots(file.roots.size());
+		m_context->GetSubsystem<Threading>()->ParallelFor(0, file.roots.size(), 1, [this, &file, token, &stagedRoots](size_t i)
+		{
+			if ((file.roots[i].flags & SceneRoot_MainThread) || (token && token->IsCancelled()))
+				return;
+
+			// A root that fails is left to CommitRoots(), which decodes it again and reports the error
+			BeginStaging();
+			if (DeserializeRoot(file, i))
+			{
+				stagedRoots[i] = TakeStaging();
+			}
+			else
+			{
+				DiscardStaging();
+			}
+		});
+
+		return stagedRoots;
+	}
+
+	bool Scene::CommitRoots(SceneFile& file, const vector<shared_ptr<GameObjectList>>& stagedRoots)
+	{
+		PROFILE_FUNCTION();
+
+		if (file.legacy)
+			return LoadGameObjects(&file.reader);
+
+		// In file order, a root which couldn't be staged gets decoded right here
+		bool valid = true;
+		for (size_t i = 0; i < file.roots.size(); i++)
+		{
+			if (i < stagedRoots.size() && stagedRoots[i])
+			{
+				AddStaged(*stagedRoots[i]);
+			}
+			else
+			{
+				valid = DeserializeRoot(file, i) && valid;
+			}
+		}
+
+		if (!valid)
+		{
+			LOG_ERROR("Scene: The scene file is truncated or corrupt.");
+		}
+
+		return valid;
+	}
+
+	bool Scene::DeserializeRoot(const SceneFile& file, size_t rootIndex)
+	{
+		const SceneFileRoot& root = file.roots[rootIndex];
+		BinaryReader reader(file.reader.GetData() + root.offset, (size_t)root.size);
+		CreateGameObject()._Get()->Deserialize(&reader, nullptr);
+
+		return reader.IsValid();
+	}
+
+	// Scene files saved before the table of contents existed
+	bool Scene::LoadGameObjects(BinaryReader* reader)
+	{
+		//= Load GameObjects ============================	
 		// 1st - GameObject count
-		StreamIO::WriteInt((int)rootGameObjects.size());
+		int rootGameObjectCount = reader->ReadInt();
 
 		// 2nd - GameObject IDs
-		for (const auto& root : rootGameObjects)
+		for (int i = 0; i < rootGameObjectCount; i++)
 		{
-			StreamIO::WriteSTR(root._Get()->GetID());
+			if (!reader->IsValid())
+			{
+				rootGameObjectCount = i;
+				break;
+			}
+
+			auto gameObj = CreateGameObject().lock();
+			gameObj->SetID(GUIDGenerator::IDFromString(reader->ReadSTR()));
 		}
 
 		// 3rd - GameObjects
-		for (const auto& root : rootGameObjects)
+		// It's important to loop with rootGameObjectCount
+		// as the vector size will increase as we deserialize
+		// GameObjects. This is because a GameObject will also
+		// deserialize their descendants.
+		for (int i = 0; i < rootGameObjectCount; i++)
 		{
-			root._Get()->Serialize();
+			m_gameObjects.Get()[i]->Deserialize(reader, nullptr);
 		}
 		//==============================================
 
-		StreamIO::StopWriting();
+		if (!reader->IsValid())
+		{
+			LOG_ERROR("Scene: The scene file is truncated or corrupt.");
+			return false;
+		}
 
 		return true;
 	}
+	//===================================================================================================
 
-	bool Scene::LoadFromFile(const string& filePath)
+	//= STREAMING =======================================================================================
+	bool Scene::SaveToStreamingFile(const string& filePathIn, float cellSize)
 	{
-		if (!FileSystem::FileExists(filePath))
+		PROFILE_FUNCTION();
+
+		if (cellSize <= 0.0f)
 		{
-			LOG_ERROR(filePath + " was not found.");
+			LOG_ERROR("Scene: The cell size of a streaming file has to be positive.");
 			return false;
 		}
 
+		string filePath = filePathIn;
+		if (FileSystem::GetExtensionFromFilePath(filePath) != SCENE_EXTENSION)
+		{
+			filePath += SCENE_EXTENSION;
+		}
+
+		auto resourceMng = m_context->GetSubsystem<ResourceManager>();
+		resourceMng->SaveResourceMetadata();
+
+		// Each root goes to the cell its position falls in, ordered so that the file is the same every time
+		vector<weakGameObj> residentRoots;
+		map<pair<int32_t, int32_t>, vector<weakGameObj>> cellRoots;
+		for (const auto& root : GetRootGameObjects())
+		{
+			GameObject* gameObject = root._Get();
+			if (StaysResident(gameObject))
+			{
+				residentRoots.push_back(root);
+				continue;
+			}
+
+			Vector3 position = gameObject->GetTransform()->GetPosition();
+			cellRoots[make_pair((int32_t)floor(position.x / cellSize), (int32_t)floor(position.z / cellSize))].push_back(root);
+		}
+
+		// Chunks are compressed one by one, so that each can still be read on its own
+		Threading* threading = m_context->GetSubsystem<Threading>();
+		bool compress = Settings::GetCompressAssets();
+		auto writeChunk = [resourceMng, threading, compress](const vector<weakGameObj>& roots)
+		{
+			vector<string> resourcePaths;
+			for (const auto& root : roots)
+			{
+				CollectResourcePaths(root._Get(), resourceMng, resourcePaths);
+			}
+
+			BinaryWriter chunk;
+			WriteSceneFile(roots, resourcePaths, chunk);
+
+			vector<char> data;
+			if (compress)
+			{
+				BlockCompression::Compress(chunk.GetData(), chunk.GetSize(), data, threading);
+			}
+			else
+			{
+				data.assign(chunk.GetData(), chunk.GetData() + chunk.GetSize());
+			}
+			return data;
+		};
+
+		SceneStreamHeader header = {};
+		memcpy(header.magic, STREAM_MAGIC, sizeof(header.magic));
+		header.version = STREAM_VERSION;
+		header.cellCount = (uint32_t)cellRoots.size();
+		header.cellSize = cellSize;
+
+		vector<vector<char>> chunks;
+		chunks.push_back(writeChunk(residentRoots));
+		uint64_t offset = sizeof(SceneStreamHeader) + cellRoots.size() * sizeof(SceneStreamCell);
+		header.residentOffset = offset;
+		header.residentSize = chunks.back().size();
+		offset += header.residentSize;
+
+		vector<SceneStreamCell> cells;
+		for (const auto& cell : cellRoots)
+		{
+			chunks.push_back(writeChunk(cell.second));
+			cells.push_back(SceneStreamCell{ cell.first.first, cell.first.second, offset, chunks.back().size() });
+			offset += chunks.back().size();
+		}
+
+		BinaryWriter writer;
+		writer.Reserve((size_t)offset);
+		writer.WriteBytes(&header, sizeof(header));
+		writer.WriteArray(cells.data(), cells.size());
+		for (const auto& chunk : chunks)
+		{
+			writer.WriteBytes(chunk.data(), chunk.size());
+		}
+
+		// Never compressed as a whole, it's mapped when loading
+		return writer.SaveToFile(filePath);
+	}
+
+	bool Scene::LoadFromStreamingFile(const string& filePath)
+	{
+		PROFILE_FUNCTION();
+
 		Clear();
 
-		// Read all the resource file paths
-		if (!StreamIO::StartReading(filePath))
+		auto stream = make_shared<SceneStream>();
+		if (!stream->file.Open(filePath))
+			return false;
+
+		const char* data = stream->file.GetData();
+		uint64_t size = stream->file.GetSize();
+		SceneStreamHeader header = {};
+		if (size >= sizeof(header))
+		{
+			memcpy(&header, data, sizeof(header));
+		}
+
+		if (size < sizeof(header) || memcmp(header.magic, STREAM_MAGIC, sizeof(STREAM_MAGIC)) != 0 || header.version != STREAM_VERSION)
+		{
+			LOG_ERROR("Scene: \"" + filePath + "\" is not a supported streaming file.");
+			return false;
+		}
+
+		uint64_t cellsSize = (uint64_t)header.cellCount * sizeof(SceneStreamCell);
+		bool valid = header.cellSize > 0.0f && cellsSize <= size - sizeof(header) && header.residentOffset <= size && header.residentSize <= size - header.residentOffset;
+		if (valid)
+		{
+			vector<SceneStreamCell> cells(header.cellCount);
+			memcpy(cells.data(), data + sizeof(header), (size_t)cellsSize);
+			for (const auto& cell : cells)
+			{
+				valid = valid && cell.offset <= size && cell.size <= size - cell.offset;
+
+				StreamingCell streamingCell;
+				streamingCell.entry = cell;
+				stream->cells.push_back(move(streamingCell));
+			}
+		}
+
+		if (!valid)
+		{
+			LOG_ERROR("Scene: \"" + filePath + "\" is truncated or corrupt.");
+			return false;
+		}
+		stream->cellSize = header.cellSize;
+
+		// The resident part loads like a scene of its own, it holds on to its resources so that cells can't unload them
+		Threading* threading = m_context->GetSubsystem<Threading>();
+		SceneFile file;
+		if (!file.reader.LoadFromMemory(data + header.residentOffset, (size_t)header.residentSize, threading) || !ParseSceneFile(file, filePath))
 			return false;
 
-		vector<string> resourcePaths = StreamIO::ReadVectorSTR();
-		StreamIO::StopReading();
+		m_context->GetSubsystem<ResourceManager>()->AcquireResources(file.resourcePaths);
+		LoadResources(file.resourcePaths);
+		auto stagedRoots = StageRoots(file, nullptr);
+		if (!CommitRoots(file, stagedRoots))
+			return false;
+
+		m_stream = stream;
+		UpdateStreaming();
+
+		return true;
+	}
 
-		// Load all all these resources
+	void Scene::UpdateResidency()
+	{
 		auto resourceMng = m_context->GetSubsystem<ResourceManager>();
-		for (const auto& resourcePath : resourcePaths)
+		if (!resourceMng->IsOverMemoryBudget())
+			return;
+
+		PROFILE_FUNCTION();
+
+		// Whatever a GameObject uses stays, inactive ones included
+		unordered_set<string> resourcesInUse;
+		for (const auto& gameObject : m_gameObjects.Get())
+		{
+			ForEachResourcePath(gameObject.get(), resourceMng, [&resourcesInUse](const string& resourcePath)
+			{
+				resourcesInUse.insert(resourcePath);
+			});
+		}
+
+		resourceMng->EnforceMemoryBudgets(resourcesInUse);
+	}
+
+	void Scene::UpdateStreaming()
+	{
+		if (!m_stream || m_mainCamera.expired())
+			return;
+
+		PROFILE_FUNCTION();
+
+		SceneStream& stream = *m_stream;
+		Vector3 position = m_mainCamera._Get()->GetTransform()->GetPosition();
+		// Cells unload a bit further out than they load, so that a camera on a cell border doesn't keep reloading it
+		float unloadRadius = m_streamingRadius + stream.cellSize * 0.5f;
+
+		// Loads that finished are committed a few per frame, those the camera moved away from meanwhile are dropped
+		int commits = 0;
+		while (!stream.finished.empty() && commits < MAX_CELL_COMMITS_PER_FRAME)
 		{
-			if (FileSystem::IsEngineModelFile(resourcePath))
+			size_t cellIndex = stream.finished.front().first;
+			shared_ptr<CellLoad> load = stream.finished.front().second;
+			stream.finished.pop_front();
+			stream.loadsInFlight--;
+
+			StreamingCell& cell = stream.cells[cellIndex];
+			if (!load->acquired)
 			{
-				resourceMng->Load<Model>(resourcePath);
+				cell.state = Cell_Failed;
 				continue;
 			}
 
-			if (FileSystem::IsEngineMaterialFile(resourcePath))
+			if (CellDistance(cell.entry, stream.cellSize, position) > unloadRadius)
 			{
-				resourceMng->Load<Material>(resourcePath);
+				load->stagedRoots.clear();
+				m_context->GetSubsystem<ResourceManager>()->ReleaseResources(load->file.resourcePaths);
+				cell.state = Cell_Unloaded;
 				continue;
 			}
 
-			if (FileSystem::IsSupportedImageFile(resourcePath))
+			// The cell's roots are whatever roots get added from here on
+			size_t first = m_gameObjects.Get().size();
+			CommitRoots(load->file, load->stagedRoots);
+			const auto& gameObjects = m_gameObjects.Get();
+			for (size_t i = first; i < gameObjects.size(); i++)
 			{
-				resourceMng->Load<Texture>(resourcePath);
+				if (gameObjects[i]->GetTransform()->IsRoot())
+				{
+					cell.roots.push_back(gameObjects[i]);
+				}
 			}
+			cell.resourcePaths = move(load->file.resourcePaths);
+			cell.state = Cell_Loaded;
+			commits++;
 		}
 
+		// Unload what's out of range, then load what's in range, nearest first
+		vector<pair<float, size_t>> wanted;
+		for (size_t i = 0; i < stream.cells.size(); i++)
+		{
+			const StreamingCell& cell = stream.cells[i];
+			float distance = CellDistance(cell.entry, stream.cellSize, position);
+			if (cell.state == Cell_Loaded && distance > unloadRadius)
+			{
+				UnloadCell(i);
+			}
+			else if (cell.state == Cell_Unloaded && distance <= m_streamingRadius)
+			{
+				wanted.emplace_back(distance, i);
+			}
+		}
 
-		if (!StreamIO::StartReading(filePath))
-			return false;
+		sort(wanted.begin(), wanted.end());
+		for (const auto& cell : wanted)
+		{
+			if (stream.loadsInFlight >= MAX_CELL_LOADS_IN_FLIGHT)
+				break;
 
-		// Read our way through the resource paths
-		StreamIO::ReadVectorSTR();
+			LoadCell(cell.second);
+		}
+	}
 
-		//= Load GameObjects ============================	
-		// 1st - GameObject count
-		int rootGameObjectCount = StreamIO::ReadInt();
+	void Scene::LoadCell(size_t cellIndex)
+	{
+		shared_ptr<SceneStream> stream = m_stream;
+		stream->cells[cellIndex].state = Cell_Loading;
+		stream->loadsInFlight++;
 
-		// 2nd - GameObject IDs
-		for (int i = 0; i < rootGameObjectCount; i++)
+		m_context->GetSubsystem<Threading>()->AddTask([this, stream, cellIndex]
+		{
+			// Only the entry is read here, it doesn't change once the file is open
+			const SceneStreamCell& entry = stream->cells[cellIndex].entry;
+			auto load = make_shared<CellLoad>();
+			SceneFile& file = load->file;
+			if (!file.reader.LoadFromMemory(stream->file.GetData() + entry.offset, (size_t)entry.size, m_context->GetSubsystem<Threading>()) ||
+				!ParseSceneFile(file, stream->file.GetFilePath()) || file.legacy)
+			{
+				LOG_ERROR("Scene: Cell (" + to_string(entry.x) + ", " + to_string(entry.z) + ") of \"" + stream->file.GetFilePath() + "\" failed to load.");
+			}
+			else if (m_context->GetSubsystem<ResourceManager>()->AcquireResources(file.resourcePaths, &stream->token))
+			{
+				load->acquired = true;
+				LoadResources(file.resourcePaths, &stream->token);
+				load->stagedRoots = StageRoots(file, &stream->token);
+			}
+
+			// Committed by UpdateStreaming(), unless the scene stopped streaming from this file meanwhile
+			QueueCommand([stream, cellIndex, load]
+			{
+				if (stream->token.IsCancelled())
+				{
+					load->stagedRoots.clear();
+					return;
+				}
+
+				stream->finished.emplace_back(cellIndex, load);
+			});
+		}, Priority_Background, stream->token);
+	}
+
+	void Scene::UnloadCell(size_t cellIndex)
+	{
+		StreamingCell& cell = m_stream->cells[cellIndex];
+		RemoveGameObjects(cell.roots);
+		cell.roots.clear();
+
+		// Resources other cells (or the resident part) use stay loaded
+		m_context->GetSubsystem<ResourceManager>()->ReleaseResources(cell.resourcePaths);
+		cell.resourcePaths.clear();
+		cell.state = Cell_Unloaded;
+	}
+
+	void Scene::CloseStream()
+	{
+		if (!m_stream)
+			return;
+
+		// Loads still in flight see the token and drop what they staged, on the main thread
+		m_stream->token.Cancel();
+		for (auto& load : m_stream->finished)
 		{
+			load.second->stagedRoots.clear();
+		}
+		m_stream.reset();
+	}
+	//===================================================================================================
 
-			auto gameObj = CreateGameObject().lock();
-			gameObj->SetID(StreamIO::ReadSTR());
+	//= STRUCTURAL CHANGES ==============================================================================
+	void Scene::QueueCommand(function<void()>&& command)
+	{
+		lock_guard<mutex> lock(m_commandsMutex);
+		m_commands.push_back(move(command));
+	}
+
+	void Scene::ApplyCommands()
+	{
+		// Swap them out first, a command may well queue another one
+		vector<function<void()>> commands;
+		{
+			lock_guard<mutex> lock(m_commandsMutex);
+			commands.swap(m_commands);
 		}
 
-		// 3rd - GameObjects
-		// It's important to loop with rootGameObjectCount
-		// as the vector size will increase as we deserialize
-		// GameObjects. This is because a GameObject will also
-		// deserialize their descendants.
-		for (int i = 0; i < rootGameObjectCount; i++)
+		for (const auto& command : commands)
 		{
-			m_gameObjects[i]->Deserialize(nullptr);
+			command();
 		}
+	}
 
-		StreamIO::StopReading();
-		//==============================================
+	void Scene::BeginStaging()
+	{
+		if (t_staging)
+		{
+			LOG_WARNING("Scene: This thread is already staging");
+			return;
+		}
+
+		t_staging = true;
+	}
 
-		Resolve();
+	void Scene::CommitStaging()
+	{
+		if (!t_staging)
+			return;
 
-		return true;
+		auto gameObjects = TakeStaging();
+		QueueCommand([this, gameObjects] { AddStaged(*gameObjects); });
+	}
+
+	void Scene::DiscardStaging()
+	{
+		// Components are freed on the main thread, where the pools are iterated
+		auto gameObjects = TakeStaging();
+		QueueCommand([gameObjects] { gameObjects->Clear(); });
+	}
+
+	shared_ptr<GameObjectList> Scene::TakeStaging()
+	{
+		auto gameObjects = make_shared<GameObjectList>(move(t_stagedGameObjects));
+		t_stagedGameObjects.Clear();
+		t_staging = false;
+
+		return gameObjects;
+	}
+
+	void Scene::AddStaged(GameObjectList& gameObjects)
+	{
+		for (const auto& gameObject : gameObjects.Get())
+		{
+			gameObject->SetStaged(false);
+			m_gameObjects.Add(gameObject);
+			UpdateRenderLists(gameObject.get());
+		}
+		m_hierarchyDirty = true;
+	}
+
+	GameObjectList& Scene::GetGameObjects()
+	{
+		return t_staging ? t_stagedGameObjects : m_gameObjects;
+	}
+
+	void Scene::UpdateIndices(GameObject* gameObject, unsigned long long oldID, const string& oldName)
+	{
+		// A staged GameObject can only be renamed by the thread staging it
+		GameObjectList& list = gameObject->IsStaged() ? t_stagedGameObjects : m_gameObjects;
+		list.UpdateIndices(gameObject, oldID, oldName);
 	}
 	//===================================================================================================
 
@@ -254,7 +1142,7 @@ namespace Directus
 	vector<weakGameObj> Scene::GetRootGameObjects()
 	{
 		vector<weakGameObj> rootGameObjects;
-		for (const auto& gameObj : m_gameObjects)
+		for (const auto& gameObj : GetGameObjects().Get())
 		{
 			if (gameObj->GetTransform()->IsRoot())
 			{
@@ -272,28 +1160,26 @@ namespace Directus
 
 	weakGameObj Scene::GetGameObjectByName(const string& name)
 	{
-		for (const auto& gameObject : m_gameObjects)
-		{
-			if (gameObject->GetName() == name)
-			{
-				return gameObject;
-			}
-		}
-
-		return weakGameObj();
+		return GetGameObjects().FindByName(name);
 	}
 
-	weakGameObj Scene::GetGameObjectByID(const string& ID)
+	weakGameObj Scene::GetGameObjectByID(unsigned long long ID)
 	{
-		for (const auto& gameObject : m_gameObjects)
+		if (t_idRemap)
 		{
-			if (gameObject->GetID() == ID)
+			auto it = t_idRemap->find(ID);
+			if (it != t_idRemap->end())
 			{
-				return gameObject;
+				ID = it->second;
 			}
 		}
 
-		return weakGameObj();
+		return GetGameObjects().FindByID(ID);
+	}
+
+	void Scene::SetIDRemap(const unordered_map<unsigned long long, unsigned long long>* remap)
+	{
+		t_idRemap = remap;
 	}
 
 	bool Scene::GameObjectExists(weakGameObj gameObject)
@@ -301,29 +1187,58 @@ namespace Directus
 		if (gameObject.expired())
 			return false;
 
-		return !GetGameObjectByID(gameObject._Get()->GetID()).expired() ? true : false;
+		return GetGameObjectByID(gameObject._Get()->GetID())._Get() == gameObject._Get();
 	}
 
 	// Removes a GameObject and all of it's children
 	void Scene::RemoveGameObject(weakGameObj gameObject)
 	{
-		if (gameObject.expired())
-			return;
+		RemoveGameObjects(vector<weakGameObj>{ gameObject });
+	}
 
-		// remove any descendants
-		vector<Transform*> descendants;
-		gameObject._Get()->GetTransform()->GetDescendants(&descendants);
-		for (const auto& descendant : descendants)
+	void Scene::RemoveGameObjects(const vector<weakGameObj>& gameObjects)
+	{
+		// Gather every subtree first, removing one GameObject at a time would walk the whole scene for each
+		vector<GameObject*> removed;
+		vector<Transform*> parents;
+		for (const auto& gameObject : gameObjects)
 		{
-			RemoveSingleGameObject(descendant->GetGameObject());
+			if (gameObject.expired())
+				continue;
+
+			Transform* transform = gameObject._Get()->GetTransform();
+			vector<Transform*> descendants;
+			transform->GetDescendants(&descendants);
+			for (const auto& descendant : descendants)
+			{
+				removed.push_back(descendant->GetGameObject()._Get());
+			}
+			removed.push_back(gameObject._Get());
+
+			if (transform->GetParent())
+			{
+				parents.push_back(transform->GetParent());
+			}
 		}
 
-		// remove this gameobject but keep it's parent
-		Transform* parent = gameObject._Get()->GetTransform()->GetParent();
-		RemoveSingleGameObject(gameObject);
+		if (removed.empty())
+			return;
+
+		// Parents which are removed as well have nobody left to update
+		unordered_set<GameObject*> doomed(removed.begin(), removed.end());
+		auto removedParent = [&doomed](Transform* parent) { return doomed.count(parent->GetGameObject()._Get()) != 0; };
+		parents.erase(remove_if(parents.begin(), parents.end(), removedParent), parents.end());
+
+		// They may outlive their removal if something still holds on to them
+		for (GameObject* gameObject : removed)
+		{
+			RemoveFromRenderLists(gameObject);
+		}
+		m_gameObjects.Remove(removed);
+		m_hierarchyDirty = true;
 
-		// if there is a parent, update it's children pool
-		if (parent)
+		// The remaining parents update their children pool
+		for (Transform* parent : parents)
 		{
 			parent->ResolveChildrenRecursively();
 		}
@@ -335,60 +1250,146 @@ namespace Directus
 		if (gameObject.expired())
 			return;
 
-		bool dirty = false;
-		for (auto it = m_gameObjects.begin(); it < m_gameObjects.end();)
+		// It may outlive its removal if something still holds on to it
+		RemoveFromRenderLists(gameObject._Get());
+		m_gameObjects.Remove(gameObject._Get());
+		m_hierarchyDirty = true;
+	}
+	//===================================================================================================
+
+	//= RENDER LISTS ==================================================================================
+	void Scene::UpdateRenderLists(GameObject* gameObject)
+	{
+		// Staged GameObjects are picked up once they are committed
+		if (gameObject->IsStaged())
+			return;
+
+		// Expired while it's being destroyed
+		weakGameObj weak = gameObject->GetTransform() ? gameObject->GetTransform()->g_gameObject : weakGameObj();
+		if (weak.expired())
+		{
+			RemoveFromRenderLists(gameObject);
+			return;
+		}
+
+		bool active = gameObject->IsActive();
+
+		if (active && gameObject->HasComponent<MeshRenderer>() && gameObject->HasComponent<MeshFilter>())
 		{
-			sharedGameObj temp = *it;
-			if (temp->GetID() == gameObject.lock()->GetID())
+			m_renderables.Set(gameObject, weak);
+		}
+		else
+		{
+			m_renderables.Remove(gameObject);
+		}
+
+		Light* light = active ? gameObject->GetComponent<Light>() : nullptr;
+		if (light)
+		{
+			m_lights.Set(gameObject, light);
+		}
+		else
+		{
+			m_lights.Remove(gameObject);
+		}
+
+		// The first camera and skybox stay, until they go away
+		if (gameObject->HasComponent<Camera>())
+		{
+			if (m_mainCamera.expired())
 			{
-				it = m_gameObjects.erase(it);
-				dirty = true;
-				return;
+				m_mainCamera = weak;
 			}
-			++it;
+		}
+		else if (m_mainCamera._Get() == gameObject)
+		{
+			m_mainCamera = FindAnother<Camera>(gameObject);
 		}
 
-		if (dirty)
+		if (gameObject->HasComponent<Skybox>())
 		{
-			Resolve();
+			if (m_skybox.expired())
+			{
+				m_skybox = weak;
+			}
+		}
+		else if (m_skybox._Get() == gameObject)
+		{
+			m_skybox = FindAnother<Skybox>(gameObject);
 		}
 	}
-	//===================================================================================================
 
-	//= SCENE RESOLUTION  ===============================================================================
-	void Scene::Resolve()
+	void Scene::RemoveFromRenderLists(GameObject* gameObject)
 	{
-		m_renderables.clear();
-		m_renderables.shrink_to_fit();
+		m_renderables.Remove(gameObject);
+		m_lights.Remove(gameObject);
 
-		m_lights.clear();
-		m_lights.shrink_to_fit();
+		if (m_mainCamera._Get() == gameObject)
+		{
+			m_mainCamera = FindAnother<Camera>(gameObject);
+		}
 
-		for (const auto& gameObject : m_gameObjects)
+		if (m_skybox._Get() == gameObject)
 		{
-			// Find camera
-			if (gameObject->HasComponent<Camera>())
-			{
-				m_mainCamera = gameObject;
-			}
+			m_skybox = FindAnother<Skybox>(gameObject);
+		}
+	}
 
-			// Find skybox
-			if (gameObject->HasComponent<Skybox>())
+	template <class T>
+	weakGameObj Scene::FindAnother(GameObject* gameObject)
+	{
+		weakGameObj found;
+		ForEach<T>([&found, gameObject](T* component)
+		{
+			if (component->g_gameObject._Get() != gameObject && !component->g_gameObject.expired())
 			{
-				m_skybox = gameObject;
+				found = component->g_gameObject;
 			}
+		});
 
-			// Find renderables
-			if (gameObject->HasComponent<MeshRenderer>() && gameObject->HasComponent<MeshFilter>())
+		return found;
+	}
+	//===================================================================================================
+
+	//= TRANSFORMS ====================================================================================
+	void Scene::UpdateTransforms()
+	{
+		if (m_hierarchyDirty.exchange(false))
+		{
+			m_transforms.clear();
+			m_transformSubtrees.clear();
+			for (const auto& gameObject : m_gameObjects.Get())
 			{
-				m_renderables.push_back(gameObject);
+				Transform* transform = gameObject->GetTransform();
+				if (!transform || !transform->IsRoot())
+					continue;
+
+				int begin = (int)m_transforms.size();
+				AppendSubtree(transform);
+				m_transformSubtrees.emplace_back(begin, (int)m_transforms.size());
 			}
+		}
 
-			// Find lights
-			if (gameObject->HasComponent<Light>())
+		// Subtrees don't share anything, parents come before their children within one
+		m_context->GetSubsystem<Threading>()->ParallelFor(0, m_transformSubtrees.size(), 64, [this](size_t i)
+		{
+			for (int j = m_transformSubtrees[i].first; j < m_transformSubtrees[i].second; j++)
 			{
-				m_lights.push_back(gameObject->GetComponent<Light>());
+				Transform* transform = m_transforms[j];
+				if (transform->IsDirty())
+				{
+					transform->UpdateTransform();
+				}
 			}
+		});
+	}
+
+	void Scene::AppendSubtree(Transform* transform)
+	{
+		m_transforms.push_back(transform);
+		for (const auto& child : transform->GetChildren())
+		{
+			AppendSubtree(child);
 		}
 	}
 	//===================================================================================================
@@ -469,13 +1470,127 @@ namespace Directus
 	weakGameObj Scene::CreateGameObject()
 	{
 		auto gameObj = make_shared<GameObject>(m_context);
+		gameObj->SetStaged(t_staging);
 
 		// First save the GameObject because the Transform (added below)
 		// will call the scene to get the GameObject it's attached to
-		m_gameObjects.push_back(gameObj);
+		GetGameObjects().Add(gameObj);
 
 		gameObj->Initialize(gameObj->AddComponent<Transform>());
 
 		return gameObj;
 	}
-}
+
+	//= GAMEOBJECT LIST =================================================================================
+	void GameObjectList::Add(const sharedGameObj& gameObject)
+	{
+		m_gameObjects.push_back(gameObject);
+		m_byID[gameObject->GetID()] = gameObject;
+		m_order[gameObject.get()] = m_nextOrder;
+		m_byName[gameObject->GetName()][m_nextOrder] = gameObject;
+		m_nextOrder++;
+	}
+
+	bool GameObjectList::Remove(GameObject* gameObject)
+	{
+		return Remove(vector<GameObject*>{ gameObject }) != 0;
+	}
+
+	size_t GameObjectList::Remove(const vector<GameObject*>& gameObjects)
+	{
+		unordered_set<GameObject*> doomed(gameObjects.begin(), gameObjects.end());
+
+		// Compact the list in place, keeping the removed ones alive until they are out of the indices
+		vector<sharedGameObj> removed;
+		size_t kept = 0;
+		for (size_t i = 0; i < m_gameObjects.size(); i++)
+		{
+			if (doomed.count(m_gameObjects[i].get()))
+			{
+				removed.push_back(move(m_gameObjects[i]));
+				continue;
+			}
+
+			if (kept != i)
+			{
+				m_gameObjects[kept] = move(m_gameObjects[i]);
+			}
+			kept++;
+		}
+		m_gameObjects.resize(kept);
+
+		for (const auto& gameObject : removed)
+		{
+			auto idIt = m_byID.find(gameObject->GetID());
+			if (idIt != m_byID.end() && idIt->second._Get() == gameObject.get())
+			{
+				m_byID.erase(idIt);
+			}
+
+			RemoveName(gameObject.get(), gameObject->GetName());
+			m_order.erase(gameObject.get());
+		}
+
+		return removed.size();
+	}
+
+	void GameObjectList::Clear()
+	{
+		m_byID.clear();
+		m_byName.clear();
+		m_order.clear();
+		m_gameObjects.clear();
+		m_gameObjects.shrink_to_fit();
+	}
+
+	void GameObjectList::UpdateIndices(GameObject* gameObject, unsigned long long oldID, const string& oldName)
+	{
+		// Not in this list (e.g. it was removed but something still holds on to it)
+		auto idIt = m_byID.find(oldID);
+		if (idIt == m_byID.end() || idIt->second._Get() != gameObject)
+			return;
+
+		weakGameObj weak = idIt->second;
+		m_byID.erase(idIt);
+		m_byID[gameObject->GetID()] = weak;
+
+		RemoveName(gameObject, oldName);
+		m_byName[gameObject->GetName()][m_order[gameObject]] = weak;
+	}
+
+	weakGameObj GameObjectList::FindByID(unsigned long long ID)
+	{
+		auto it = m_byID.find(ID);
+		return it != m_byID.end() ? it->second : weakGameObj();
+	}
+
+	weakGameObj GameObjectList::FindByName(const string& name)
+	{
+		auto it = m_byName.find(name);
+		if (it == m_byName.end())
+			return weakGameObj();
+
+		for (const auto& entry : it->second)
+		{
+			if (!entry.second.expired())
+				return entry.second;
+		}
+
+		return weakGameObj();
+	}
+
+	void GameObjectList::RemoveName(GameObject* gameObject, const string& name)
+	{
+		auto it = m_byName.find(name);
+		auto orderIt = m_order.find(gameObject);
+		if (it == m_byName.end() || orderIt == m_order.end())
+			return;
+
+		it->second.erase(orderIt->second);
+		if (it->second.empty())
+		{
+			m_byName.erase(it);
+		}
+	}
+	//===================================================================================================
+}
\ No newline at end of file
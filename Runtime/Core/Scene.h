@@ -23,17 +23,55 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ======================
 #include <vector>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <map>
 #include "../Math/Vector3.h"
 #include "../Threading/Threading.h"
+#include "DenseMap.h"
 //=================================
 
 namespace Directus
 {
 	class GameObject;
 	class Light;
+	class Transform;
+	class BinaryReader;
+	struct SceneFile;
+	struct SceneStream;
 	typedef std::weak_ptr<GameObject> weakGameObj;
 	typedef std::shared_ptr<GameObject> sharedGameObj;
 
+	// GameObjects in creation order, plus indices to find them by ID and by name
+	class GameObjectList
+	{
+	public:
+		void Add(const sharedGameObj& gameObject);
+		bool Remove(GameObject* gameObject);
+		// One pass over the list however many are removed, returns how many were in it
+		size_t Remove(const std::vector<GameObject*>& gameObjects);
+		void Clear();
+		// Re-keys a GameObject of this list after its ID or name changed
+		void UpdateIndices(GameObject* gameObject, unsigned long long oldID, const std::string& oldName);
+
+		weakGameObj FindByID(unsigned long long ID);
+		weakGameObj FindByName(const std::string& name);
+		const std::vector<sharedGameObj>& Get() { return m_gameObjects; }
+
+	private:
+		void RemoveName(GameObject* gameObject, const std::string& name);
+
+		std::vector<sharedGameObj> m_gameObjects;
+		std::unordered_map<unsigned long long, weakGameObj> m_byID;
+		// Names aren't unique, so each name maps to the GameObjects which have it, keyed by the order they
+		// were added in. That's also their order in m_gameObjects, so FindByName() returns the first match.
+		std::unordered_map<std::string, std::map<unsigned long long, weakGameObj>> m_byName;
+		std::unordered_map<GameObject*, unsigned long long> m_order;
+		unsigned long long m_nextOrder = 0;
+	};
+
 	class DLL_API Scene : public Subsystem
 	{
 	public:
@@ -50,30 +88,72 @@ namespace Directus
 		void Clear();
 
 		//= IO ========================================================================
-		void SaveToFileAsync(const std::string& filePath);
-		void LoadFromFileAsync(const std::string& filePath);
+		TaskHandle SaveToFileAsync(const std::string& filePath);
+		// Resources load on a worker, the GameObjects replace the current ones at a frame boundary
+		TaskHandle LoadFromFileAsync(const std::string& filePath);
 		bool SaveToFile(const std::string& filePath);
+		// Streaming files are recognized and loaded as such
 		bool LoadFromFile(const std::string& filePath);
 
+		//= STREAMING =================================================================
+		// Saves the scene split into square cells on the XZ plane, a root and its descendants go to the cell
+		// the root is in. Cameras, skyboxes and directional lights aren't split up, they are always loaded.
+		bool SaveToStreamingFile(const std::string& filePath, float cellSize);
+		// Loads what's always loaded, the cells around the main camera then load and unload asynchronously
+		bool LoadFromStreamingFile(const std::string& filePath);
+		bool IsStreaming() { return m_stream != nullptr; }
+		// Cells closer than this to the main camera are kept loaded
+		void SetStreamingRadius(float radius) { m_streamingRadius = radius; }
+		float GetStreamingRadius() { return m_streamingRadius; }
+
+		//= STRUCTURAL CHANGES ========================================================
+		// Thread safe, the command runs on the main thread at the next frame boundary
+		void QueueCommand(std::function<void()>&& command);
+		// Runs the queued commands, once per frame before any frame jobs
+		void ApplyCommands();
+		// GameObjects the calling thread creates go to a staging list, which is invisible to
+		// the rest of the engine, until CommitStaging() queues them to be added to the scene.
+		void BeginStaging();
+		void CommitStaging();
+		void DiscardStaging();
+
 		//= GAMEOBJECT HELPER FUNCTIONS ===============================================
 		weakGameObj CreateGameObject();
-		int GetGameObjectCount() { return (int)m_gameObjects.size(); }
-		const std::vector<sharedGameObj>& GetAllGameObjects() { return m_gameObjects; }
+		int GetGameObjectCount() { return (int)GetGameObjects().Get().size(); }
+		const std::vector<sharedGameObj>& GetAllGameObjects() { return GetGameObjects().Get(); }
 		std::vector<weakGameObj> GetRootGameObjects();
 		weakGameObj GetGameObjectRoot(weakGameObj gameObject);
 		weakGameObj GetGameObjectByName(const std::string& name);
-		weakGameObj GetGameObjectByID(const std::string& ID);
+		weakGameObj GetGameObjectByID(unsigned long long ID);
+		// While set, GetGameObjectByID() translates the IDs found in the map, for the calling thread
+		// only. Used while instantiating a prefab, so that references resolve to the new GameObjects.
+		void SetIDRemap(const std::unordered_map<unsigned long long, unsigned long long>* remap);
 		bool GameObjectExists(weakGameObj gameObject);
 		void RemoveGameObject(weakGameObj gameObject);
+		// Removes GameObjects and all of their children, with a single pass over the scene
+		void RemoveGameObjects(const std::vector<weakGameObj>& gameObjects);
 		void RemoveSingleGameObject(weakGameObj gameObject);
 
-		//= SCENE RESOLUTION  =========================================================
-		void Resolve();
-		const std::vector<weakGameObj>& GetRenderables() { return m_renderables; }
-		const std::vector<Light*>& GetLights() { return m_lights; }
+		//= QUERIES ===================================================================
+		// Calls function(First*, Rest*...) for every GameObject in the scene which has all of the
+		// given component types. It walks the pool of First, so the rarest type should go first.
+		template <class First, class... Rest, typename Function>
+		void ForEach(Function&& function);
+
+		//= RENDER LISTS ==============================================================
+		// Kept up to date as components are added or removed and GameObjects are (de)activated,
+		// the vectors stay valid for the lifetime of the scene and can be iterated without copying.
+		const std::vector<weakGameObj>& GetRenderables() { return m_renderables.Get(); }
+		const std::vector<Light*>& GetLights() { return m_lights.Get(); }
 		weakGameObj GetSkybox() { return m_skybox; }
 		weakGameObj GetMainCamera() { return m_mainCamera; }
 
+		//= TRANSFORMS ================================================================
+		// Brings every dirty transform up to date, once per frame before anything reads them
+		void UpdateTransforms();
+		// Called whenever a transform's children change
+		void MarkHierarchyDirty() { m_hierarchyDirty = true; }
+
 		//= MISC ======================================================================
 		void SetAmbientLight(float x, float y, float z);
 		Math::Vector3 GetAmbientLight();
@@ -89,14 +169,71 @@ namespace Directus
 		weakGameObj CreateDirectionalLight();
 		//===================================
 
-		std::vector<sharedGameObj> m_gameObjects;
-		std::vector<weakGameObj> m_renderables;
-		std::vector<Light*> m_lights;
+		// The staging list while the calling thread is staging, the scene's GameObjects otherwise
+		GameObjectList& GetGameObjects();
+		friend class GameObject;
+		// Called by GameObject::SetID() and GameObject::SetName()
+		void UpdateIndices(GameObject* gameObject, unsigned long long oldID, const std::string& oldName);
+		// Called by GameObject whenever it gains or loses components, is (de)activated or destroyed
+		void UpdateRenderLists(GameObject* gameObject);
+		void RemoveFromRenderLists(GameObject* gameObject);
+		template <class T>
+		weakGameObj FindAnother(GameObject* gameObject);
+		void AppendSubtree(Transform* transform);
+
+		template <typename Function, class First, class... Rest>
+		static void InvokeIfAll(Function& function, First* first, Rest*... rest)
+		{
+			bool valid[] = { true, (rest != nullptr)... };
+			for (bool v : valid)
+			{
+				if (!v)
+					return;
+			}
+			function(first, rest...);
+		}
+
+		// Detaches the calling thread's staging list, or adds one to the scene (main thread only)
+		std::shared_ptr<GameObjectList> TakeStaging();
+		void AddStaged(GameObjectList& gameObjects);
+
+		void ClearKeepingResources(const std::vector<std::string>& resourcePaths);
+		void LoadResources(const std::vector<std::string>& resourcePaths, const CancellationToken* token = nullptr);
+		// Decodes the roots that can be decoded on the workers, in parallel and each into a staging list of its own
+		std::vector<std::shared_ptr<GameObjectList>> StageRoots(const SceneFile& file, const CancellationToken* token);
+		// Main thread only, adds the staged roots and decodes the rest
+		bool CommitRoots(SceneFile& file, const std::vector<std::shared_ptr<GameObjectList>>& stagedRoots);
+		bool DeserializeRoot(const SceneFile& file, size_t rootIndex);
+		bool LoadGameObjects(BinaryReader* reader);
+
+		// Main thread only, commits finished cells and starts loading or unloading cells as the main camera moves
+		void UpdateStreaming();
+		void LoadCell(size_t cellIndex);
+		void UnloadCell(size_t cellIndex);
+		void CloseStream();
+
+		// Main thread only, evicts unused resources when the memory budgets are exceeded
+		void UpdateResidency();
+
+		GameObjectList m_gameObjects;
+		DenseMap<GameObject*, weakGameObj> m_renderables;
+		DenseMap<GameObject*, Light*> m_lights;
 
 		weakGameObj m_mainCamera;
 		weakGameObj m_skybox;
+
+		// Every transform in the scene, parents before children, each root's subtree contiguous
+		std::vector<Transform*> m_transforms;
+		std::vector<std::pair<int, int>> m_transformSubtrees; // [begin, end) into m_transforms
+		std::atomic<bool> m_hierarchyDirty;
 		Math::Vector3 m_ambientLight;
 
+		std::vector<std::function<void()>> m_commands;
+		std::mutex m_commandsMutex;
+
+		std::shared_ptr<SceneStream> m_stream;
+		float m_streamingRadius;
+
 		//= STATS =========
 		float m_fps;
 		float m_timePassed;
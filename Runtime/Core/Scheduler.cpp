@@ -0,0 +1,184 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ========================
+#include "Scheduler.h"
+#include <chrono>
+#include "Context.h"
+#include "../Threading/Threading.h"
+#include "../Profiling/Profiler.h"
+//===================================
+
+//= NAMESPACES =====
+using namespace std;
+using namespace std::chrono;
+//==================
+
+namespace Directus
+{
+	Scheduler::Scheduler(Context* context) : Subsystem(context)
+	{
+		m_dirty = false;
+		m_frameTimeMs = 0.0f;
+	}
+
+	Scheduler::~Scheduler()
+	{
+
+	}
+
+	bool Scheduler::Initialize()
+	{
+		return true;
+	}
+
+	void Scheduler::AddJob(const string& name, FrameStage stage, unsigned int reads, unsigned int writes, bool mainThread, function<void()>&& function)
+	{
+		FrameJob job;
+		job.name = name;
+		job.profilerName = Profiler::Intern(name);
+		job.function = move(function);
+		job.stage = stage;
+		job.reads = reads;
+		job.writes = writes;
+		job.mainThread = mainThread;
+		job.phase = -1;
+		job.timeMs = 0.0f;
+
+		m_jobs.push_back(move(job));
+		m_dirty = true;
+	}
+
+	void Scheduler::Execute()
+	{
+		if (m_dirty)
+		{
+			BuildPhases();
+			m_dirty = false;
+		}
+
+		Threading* threading = m_context->GetSubsystem<Threading>();
+		auto frameStart = high_resolution_clock::now();
+
+		for (auto& phase : m_phases)
+		{
+			auto phaseStart = high_resolution_clock::now();
+
+			// Every job times itself, they may run concurrently
+			auto runJob = [this](int jobIndex)
+			{
+				FrameJob& job = m_jobs[jobIndex];
+				PROFILE_SCOPE(job.profilerName);
+				auto jobStart = high_resolution_clock::now();
+				job.function();
+				job.timeMs = duration<float, milli>(high_resolution_clock::now() - jobStart).count();
+			};
+
+			// Hand the worker jobs off first, then do the main thread ones ourselves.
+			// The frame waits on them, so they go ahead of loading and streaming.
+			vector<TaskHandle> tasks;
+			for (int jobIndex : phase.jobs)
+			{
+				if (!m_jobs[jobIndex].mainThread && threading && phase.jobs.size() > 1)
+				{
+					tasks.emplace_back(threading->AddTask([runJob, jobIndex] { runJob(jobIndex); }, vector<TaskHandle>(), Priority_Critical, nullptr));
+				}
+			}
+
+			for (int jobIndex : phase.jobs)
+			{
+				if (m_jobs[jobIndex].mainThread || !threading || phase.jobs.size() == 1)
+				{
+					runJob(jobIndex);
+				}
+			}
+
+			if (threading)
+			{
+				threading->WaitAll(tasks);
+			}
+
+			phase.timeMs = duration<float, milli>(high_resolution_clock::now() - phaseStart).count();
+		}
+
+		m_frameTimeMs = duration<float, milli>(high_resolution_clock::now() - frameStart).count();
+	}
+
+	void Scheduler::BuildPhases()
+	{
+		m_phases.clear();
+
+		int stageFirstPhase = 0;
+		FrameStage currentStage = Stage_Update;
+		bool firstJob = true;
+
+		// Stable sort by stage, registration order is kept within a stage
+		vector<int> order;
+		for (int stage = Stage_Update; stage <= Stage_Render; stage++)
+		{
+			for (int i = 0; i < (int)m_jobs.size(); i++)
+			{
+				if (m_jobs[i].stage == stage)
+				{
+					order.push_back(i);
+				}
+			}
+		}
+
+		for (size_t n = 0; n < order.size(); n++)
+		{
+			FrameJob& job = m_jobs[order[n]];
+
+			// A new stage can't share phases with the previous one
+			if (firstJob || job.stage != currentStage)
+			{
+				currentStage = job.stage;
+				stageFirstPhase = (int)m_phases.size();
+				firstJob = false;
+			}
+
+			// The job has to run after every earlier job it conflicts with
+			int phase = stageFirstPhase;
+			for (size_t m = 0; m < n; m++)
+			{
+				const FrameJob& earlier = m_jobs[order[m]];
+				if (earlier.phase >= phase && Conflict(earlier, job))
+				{
+					phase = earlier.phase + 1;
+				}
+			}
+
+			if (phase >= (int)m_phases.size())
+			{
+				m_phases.resize(phase + 1);
+				m_phases[phase].timeMs = 0.0f;
+			}
+
+			job.phase = phase;
+			m_phases[phase].jobs.push_back(order[n]);
+		}
+	}
+
+	bool Scheduler::Conflict(const FrameJob& a, const FrameJob& b)
+	{
+		return (a.writes & (b.reads | b.writes)) || (b.writes & a.reads);
+	}
+}
\ No newline at end of file
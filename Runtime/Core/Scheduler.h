@@ -0,0 +1,108 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ======================
+#include <vector>
+#include <string>
+#include <functional>
+#include "Subsystem.h"
+//=================================
+
+namespace Directus
+{
+	// The data a frame job touches. Jobs that don't write anything the
+	// other reads or writes can run at the same time.
+	enum FrameData : unsigned int
+	{
+		Frame_None			= 0,
+		Frame_Input			= 1 << 0,	// Keyboard/mouse state
+		Frame_Transforms	= 1 << 1,	// Positions, rotations, scales
+		Frame_SceneGraph	= 1 << 2,	// GameObjects and their components
+		Frame_RenderLists	= 1 << 3,	// The scene's renderables, lights, camera, skybox
+		Frame_Physics		= 1 << 4,	// The Bullet world
+		Frame_Audio			= 1 << 5,	// The FMOD system
+		Frame_Scripts		= 1 << 6,	// AngelScript modules and instances
+		Frame_GPU			= 1 << 7	// The graphics device
+	};
+
+	// Frame jobs are grouped in stages, a stage starts only after the previous one has finished.
+	// This mirrors EVENT_UPDATE and EVENT_RENDER.
+	enum FrameStage
+	{
+		Stage_Update,
+		Stage_Render
+	};
+
+	struct FrameJob
+	{
+		std::string name;
+		const char* profilerName; // the name as the profiler keeps it
+		std::function<void()> function;
+		FrameStage stage;
+		unsigned int reads;
+		unsigned int writes;
+		bool mainThread; // e.g. anything that talks to the graphics device
+		int phase;
+		float timeMs;
+	};
+
+	struct FramePhase
+	{
+		std::vector<int> jobs; // indices into the job list
+		float timeMs;
+	};
+
+	class DLL_API Scheduler : public Subsystem
+	{
+	public:
+		Scheduler(Context* context);
+		~Scheduler();
+
+		//= Subsystem ============
+		virtual bool Initialize();
+		//========================
+
+		// Registers a job that will run once per frame
+		void AddJob(const std::string& name, FrameStage stage, unsigned int reads, unsigned int writes, bool mainThread, std::function<void()>&& function);
+
+		// Runs all the jobs, phase by phase
+		void Execute();
+
+		//= STATS ==================================================
+		const std::vector<FrameJob>& GetJobs() { return m_jobs; }
+		const std::vector<FramePhase>& GetPhases() { return m_phases; }
+		float GetFrameTime() { return m_frameTimeMs; }
+		//==========================================================
+
+	private:
+		// Packs the jobs into as few phases as possible while keeping
+		// conflicting jobs in registration order.
+		void BuildPhases();
+		static bool Conflict(const FrameJob& a, const FrameJob& b);
+
+		std::vector<FrameJob> m_jobs;
+		std::vector<FramePhase> m_phases;
+		bool m_dirty;
+		float m_frameTimeMs;
+	};
+}
\ No newline at end of file
@@ -44,6 +44,10 @@ namespace Directus
 	int Settings::m_shadowMapResolution = 2048;
 	unsigned int Settings::m_anisotropy = 16;
 	bool Settings::m_debugDraw = true;
+	bool Settings::m_compressAssets = false;
+	unsigned int Settings::m_textureMemoryBudgetMB = 0;
+	unsigned int Settings::m_modelMemoryBudgetMB = 0;
+	unsigned int Settings::m_materialMemoryBudgetMB = 0;
 	string Settings::m_settingsFileName = "Directus3D.ini";
 	//====================================================================================
 	ofstream Settings::m_fout;
@@ -86,6 +90,10 @@ namespace Directus
 			ReadSetting(m_fin, "ResolutionHeight", m_resolutionHeight);
 			ReadSetting(m_fin, "ShadowMapResolution", m_shadowMapResolution);
 			ReadSetting(m_fin, "Anisotropy", m_anisotropy);
+			ReadSetting(m_fin, "CompressAssets", m_compressAssets);
+			ReadSetting(m_fin, "TextureMemoryBudgetMB", m_textureMemoryBudgetMB);
+			ReadSetting(m_fin, "ModelMemoryBudgetMB", m_modelMemoryBudgetMB);
+			ReadSetting(m_fin, "MaterialMemoryBudgetMB", m_materialMemoryBudgetMB);
 
 			m_screenAspect = float(m_resolutionWidth) / float(m_resolutionHeight);
 
@@ -105,6 +113,10 @@ namespace Directus
 			WriteSetting(m_fout, "ResolutionHeight", m_resolutionHeight);
 			WriteSetting(m_fout, "ShadowMapResolution", m_shadowMapResolution);
 			WriteSetting(m_fout, "Anisotropy", m_anisotropy);
+			WriteSetting(m_fout, "CompressAssets", m_compressAssets);
+			WriteSetting(m_fout, "TextureMemoryBudgetMB", m_textureMemoryBudgetMB);
+			WriteSetting(m_fout, "ModelMemoryBudgetMB", m_modelMemoryBudgetMB);
+			WriteSetting(m_fout, "MaterialMemoryBudgetMB", m_materialMemoryBudgetMB);
 
 			// Close the file.
 			m_fout.close();
@@ -142,6 +154,31 @@ namespace Directus
 		return m_debugDraw;
 	}
 
+	void Settings::SetCompressAssets(bool enabled)
+	{
+		m_compressAssets = enabled;
+	}
+
+	bool Settings::GetCompressAssets()
+	{
+		return m_compressAssets;
+	}
+
+	unsigned int Settings::GetTextureMemoryBudgetMB()
+	{
+		return m_textureMemoryBudgetMB;
+	}
+
+	unsigned int Settings::GetModelMemoryBudgetMB()
+	{
+		return m_modelMemoryBudgetMB;
+	}
+
+	unsigned int Settings::GetMaterialMemoryBudgetMB()
+	{
+		return m_materialMemoryBudgetMB;
+	}
+
 	void Settings::SetResolution(int width, int height)
 	{
 		m_resolutionWidth = width;
@@ -83,6 +83,14 @@ namespace Directus
 		static unsigned int GetAnisotropy();
 		static void SetDebugDraw(bool enabled);
 		static bool GetDebugDraw();
+		// Whether scenes, models and prefabs are saved block compressed (they load either way)
+		static void SetCompressAssets(bool enabled);
+		static bool GetCompressAssets();
+
+		// Resource memory budgets in megabytes, 0 means unlimited
+		static unsigned int GetTextureMemoryBudgetMB();
+		static unsigned int GetModelMemoryBudgetMB();
+		static unsigned int GetMaterialMemoryBudgetMB();
 
 	private:
 		static std::ofstream m_fout;
@@ -99,6 +107,10 @@ namespace Directus
 		static bool m_isMouseVisible;		
 		static int m_shadowMapResolution;
 		static unsigned int m_anisotropy;
-		static bool m_debugDraw;	
+		static bool m_debugDraw;
+		static bool m_compressAssets;
+		static unsigned int m_textureMemoryBudgetMB;
+		static unsigned int m_modelMemoryBudgetMB;
+		static unsigned int m_materialMemoryBudgetMB;
 	};
 }
\ No newline at end of file
@@ -19,11 +19,14 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-#pragma once
-
-//= INCLUDES ===========
+//= INCLUDES ====================
 #include "EventSystem.h"
-//======================
+#include <map>
+#include <mutex>
+#include <vector>
+#include "../Logging/Log.h"
+#include "../Profiling/Profiler.h"
+//===============================
 
 //= NAMESPACES =====
 using namespace std;
@@ -31,41 +34,240 @@ using namespace std;
 
 namespace Directus
 {
-	vector<shared_ptr<Subscriber>> EventSystem::m_subscribers;
+	// The subscribers of a single event. The list is copied on write, so firing only
+	// holds the lock long enough to grab it and subscribers are free to (un)subscribe
+	// while being called. An unsubscribed function may still see an event that was
+	// already being fired.
+	struct EventBucket
+	{
+		mutex subscribersMutex;
+		shared_ptr<const vector<Subscriber>> subscribers;
+		atomic<int> count;
+
+		EventBucket() : count(0) {}
+	};
+
+	// Intrusive multi-producer single-consumer queue (Vyukov). Posting is a single
+	// exchange, only the thread that dispatches ever pops.
+	struct EventQueue
+	{
+		atomic<QueuedEvent*> head;
+		QueuedEvent* tail;
+		QueuedEvent stub;
+		atomic<int> size;
+		mutex consumerMutex;
+
+		EventQueue() : head(&stub), tail(&stub), size(0) {}
+
+		void Push(QueuedEvent* event)
+		{
+			event->next.store(nullptr, memory_order_relaxed);
+			QueuedEvent* previous = head.exchange(event, memory_order_acq_rel);
+			previous->next.store(event, memory_order_release);
+		}
+
+		// Returns nullptr when empty, or when the next event is still being pushed
+		QueuedEvent* Pop()
+		{
+			QueuedEvent* first = tail;
+			QueuedEvent* next = first->next.load(memory_order_acquire);
+
+			if (first == &stub)
+			{
+				if (!next)
+					return nullptr;
+
+				tail = next;
+				first = next;
+				next = next->next.load(memory_order_acquire);
+			}
+
+			if (next)
+			{
+				tail = next;
+				return first;
+			}
+
+			if (first != head.load(memory_order_acquire))
+				return nullptr;
+
+			// The last event, put the stub behind it so that it can be taken out
+			Push(&stub);
+			next = first->next.load(memory_order_acquire);
+			if (next)
+			{
+				tail = next;
+				return first;
+			}
+
+			return nullptr;
+		}
+	};
+
+	struct EventTypeRegistry
+	{
+		mutex typesMutex;
+		map<string, int> types;
+		int nextEventID = EventSystem::FIRST_TYPED_EVENT;
+	};
+
+	static EventBucket* GetBucket(int eventID)
+	{
+		static EventBucket buckets[EventSystem::MAX_EVENTS];
+
+		if (eventID < 0 || eventID >= EventSystem::MAX_EVENTS)
+		{
+			LOG_ERROR("EventSystem: Event ID " + to_string(eventID) + " is out of range.");
+			return nullptr;
+		}
+
+		return &buckets[eventID];
+	}
+
+	static EventQueue& GetQueue()
+	{
+		static EventQueue queue;
+		return queue;
+	}
+
+	static atomic<SubscriptionID> s_nextSubscriptionID(1);
+
+	void EventSystem::Post(int eventID)
+	{
+		QueuedEvent* event = new QueuedEvent();
+		event->eventID = eventID;
+		Enqueue(event);
+	}
+
+	bool EventSystem::HasSubscribers(int eventID)
+	{
+		EventBucket* bucket = GetBucket(eventID);
+		return bucket && bucket->count.load(memory_order_acquire) != 0;
+	}
+
+	void EventSystem::Dispatch()
+	{
+		PROFILE_FUNCTION();
+
+		EventQueue& queue = GetQueue();
+		lock_guard<mutex> lock(queue.consumerMutex);
+
+		// Only what was posted before we started
+		int count = queue.size.load(memory_order_acquire);
+		for (int i = 0; i < count; i++)
+		{
+			QueuedEvent* event = queue.Pop();
+			if (!event)
+				break;
+
+			queue.size.fetch_sub(1, memory_order_relaxed);
+			CallSubscribers(event->eventID, event->GetPayload());
+			delete event;
+		}
+	}
 
 	void EventSystem::Clear()
 	{
-		m_subscribers.clear();
-		m_subscribers.shrink_to_fit();
+		for (int eventID = 0; eventID < MAX_EVENTS; eventID++)
+		{
+			EventBucket* bucket = GetBucket(eventID);
+			lock_guard<mutex> lock(bucket->subscribersMutex);
+			bucket->subscribers.reset();
+			bucket->count.store(0, memory_order_release);
+		}
+
+		EventQueue& queue = GetQueue();
+		lock_guard<mutex> lock(queue.consumerMutex);
+		while (QueuedEvent* event = queue.Pop())
+		{
+			queue.size.fetch_sub(1, memory_order_relaxed);
+			delete event;
+		}
 	}
 
-	void EventSystem::AddSubscriber(shared_ptr<Subscriber> subscriber)
+	SubscriptionID EventSystem::AddSubscriber(int eventID, Subscriber::functionType&& function)
 	{
-		m_subscribers.push_back(subscriber);
+		EventBucket* bucket = GetBucket(eventID);
+		if (!bucket)
+			return 0;
+
+		SubscriptionID subscriptionID = s_nextSubscriptionID.fetch_add(1, memory_order_relaxed);
+
+		lock_guard<mutex> lock(bucket->subscribersMutex);
+		auto subscribers = bucket->subscribers ? make_shared<vector<Subscriber>>(*bucket->subscribers) : make_shared<vector<Subscriber>>();
+		subscribers->emplace_back(subscriptionID, move(function));
+		bucket->subscribers = subscribers;
+		bucket->count.store((int)subscribers->size(), memory_order_release);
+
+		return subscriptionID;
 	}
 
-	void EventSystem::RemoveSubscriber(int eventID, size_t functionAddress)
+	void EventSystem::RemoveSubscriber(int eventID, SubscriptionID subscriptionID)
 	{
-		for (auto it = m_subscribers.begin(); it != m_subscribers.end();)
+		EventBucket* bucket = GetBucket(eventID);
+		if (!bucket)
+			return;
+
+		lock_guard<mutex> lock(bucket->subscribersMutex);
+		if (!bucket->subscribers)
+			return;
+
+		auto subscribers = make_shared<vector<Subscriber>>();
+		subscribers->reserve(bucket->subscribers->size());
+		for (const auto& subscriber : *bucket->subscribers)
 		{
-			auto subscriber = *it;
-			if (subscriber->GetEventID() == eventID && subscriber->GetAddress() == functionAddress)
+			if (subscriber.GetID() != subscriptionID)
 			{
-				it = m_subscribers.erase(it);
-				return;
+				subscribers->push_back(subscriber);
 			}
-			++it;
 		}
+		bucket->subscribers = subscribers;
+		bucket->count.store((int)subscribers->size(), memory_order_release);
 	}
 
-	void EventSystem::CallSubscriber(int eventID)
+	void EventSystem::CallSubscribers(int eventID, const void* payload)
 	{
-		for (const auto& subscriber : m_subscribers)
+		EventBucket* bucket = GetBucket(eventID);
+		if (!bucket || bucket->count.load(memory_order_acquire) == 0)
+			return;
+
+		shared_ptr<const vector<Subscriber>> subscribers;
 		{
-			if (subscriber->GetEventID() == eventID)
-			{
-				subscriber->Call();
-			}
+			lock_guard<mutex> lock(bucket->subscribersMutex);
+			subscribers = bucket->subscribers;
+		}
+
+		for (const auto& subscriber : *subscribers)
+		{
+			subscriber.Call(payload);
 		}
 	}
+
+	int EventSystem::RegisterEventType(const char* typeName)
+	{
+		static EventTypeRegistry registry;
+		lock_guard<mutex> lock(registry.typesMutex);
+
+		auto it = registry.types.find(typeName);
+		if (it != registry.types.end())
+			return it->second;
+
+		if (registry.nextEventID >= MAX_EVENTS)
+		{
+			LOG_ERROR("EventSystem: Too many event types, " + string(typeName) + " will not be delivered.");
+			return -1;
+		}
+
+		int eventID = registry.nextEventID++;
+		registry.types[typeName] = eventID;
+
+		return eventID;
+	}
+
+	void EventSystem::Enqueue(QueuedEvent* event)
+	{
+		EventQueue& queue = GetQueue();
+		queue.Push(event);
+		queue.size.fetch_add(1, memory_order_release);
+	}
 }
\ No newline at end of file
@@ -22,18 +22,26 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ==========
-#include <vector>
+#include <atomic>
 #include <memory>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
 #include "Subscriber.h"
 //=====================
 
 /*
 HOW TO USE
 ===================================================================================================================
-To subscribe a function to an event						-> SUBSCRIBE_TO_EVENT(SOME_EVENT, Class::Func, this);
-To subscribe a function (with parameters) to an event	-> SUBSCRIBE_TO_EVENT(SOME_EVENT, Class::Func, this, args);
-To unsubscribe a function from an event					-> UNSUBSCRIBE_FROM_EVENT(SOME_EVENT, Class::Func, this);
+To subscribe a function to an event						-> id = SUBSCRIBE_TO_EVENT(SOME_EVENT, this, Class::Func);
+To unsubscribe a function from an event					-> UNSUBSCRIBE_FROM_EVENT(SOME_EVENT, id);
 To fire an event										-> FIRE_EVENT(SOME_EVENT);
+To subscribe to a typed event							-> id = EventSystem::Subscribe<SomeEvent>([](const SomeEvent& e) {...});
+To fire a typed event									-> EventSystem::Fire(SomeEvent{...});
+To post an event from any thread						-> EventSystem::Post(SomeEvent{...});
+
+Fired events reach their subscribers right away, on the firing thread. Posted events are queued
+and reach their subscribers on the main thread, when the engine dispatches them once per frame.
 ===================================================================================================================
 */
 
@@ -44,40 +52,128 @@ To fire an event										-> FIRE_EVENT(SOME_EVENT);
 
 //= MACROS =======================================================================================================================
 #define SUBSCRIBE_TO_EVENT(signalID, instance, function)		EventSystem::Subscribe(signalID, std::bind(&function, instance))
-#define UNSUBSCRIBE_FROM_EVENT(signalID, instance, function)	EventSystem::Unsubscribe(signalID, std::bind(&function, instance))
+#define UNSUBSCRIBE_FROM_EVENT(signalID, subscriptionID)		EventSystem::Unsubscribe(signalID, subscriptionID)
 #define FIRE_EVENT(signalID)									EventSystem::Fire(signalID)
 //================================================================================================================================
 
 namespace Directus
 {
+	class GameObject;
+	class Component;
+	class Resource;
+
+	//= TYPED EVENTS =================================================================
+	// Fired when a component gets added to a GameObject that is part of the scene
+	struct ComponentAddedEvent
+	{
+		GameObject* gameObject;
+		Component* component;
+	};
+
+	// Posted when a transform's position, rotation, scale or parent changes
+	struct TransformChangedEvent
+	{
+		std::weak_ptr<GameObject> gameObject;
+	};
+
+	// Posted when the ResourceManager loads a resource from a file
+	struct ResourceLoadedEvent
+	{
+		std::string filePath;
+		std::weak_ptr<Resource> resource;
+	};
+	//================================================================================
+
+	// A posted event, waiting in the queue to be dispatched
+	struct DLL_API QueuedEvent
+	{
+		QueuedEvent() : next(nullptr), eventID(0) {}
+		virtual ~QueuedEvent() {}
+		virtual const void* GetPayload() const { return nullptr; }
+
+		std::atomic<QueuedEvent*> next;
+		int eventID;
+	};
+
+	template <typename T>
+	struct TypedQueuedEvent : public QueuedEvent
+	{
+		TypedQueuedEvent(T&& event) : payload(std::move(event)) {}
+		const void* GetPayload() const override { return &payload; }
+
+		T payload;
+	};
+
 	class DLL_API EventSystem
 	{
 	public:
+		// IDs below this are for the #defined events, typed events get the ones above it
+		static const int FIRST_TYPED_EVENT = 64;
+		static const int MAX_EVENTS = 256;
+
+		//= EVENT IDS ==============================================================
 		template <typename Function>
-		static void Subscribe(int eventID, Function&& subscriber)
+		static SubscriptionID Subscribe(int eventID, Function&& subscriber)
 		{
-			AddSubscriber(std::make_shared<Subscriber>(eventID, std::bind(std::forward<Function>(subscriber))));
+			typename std::decay<Function>::type function(std::forward<Function>(subscriber));
+			return AddSubscriber(eventID, [function](const void*) { function(); });
 		}
 
-		template <typename Function>
-		static void Unsubscribe(int eventID, Function&& subscriber)
+		static void Unsubscribe(int eventID, SubscriptionID subscriptionID) { RemoveSubscriber(eventID, subscriptionID); }
+		static void Fire(int eventID) { CallSubscribers(eventID, nullptr); }
+		static void Post(int eventID);
+		//==========================================================================
+
+		//= TYPED EVENTS ===========================================================
+		template <typename T, typename Function>
+		static SubscriptionID Subscribe(Function&& subscriber)
 		{
-			RemoveSubscriber(eventID, getAddress(subscriber));
+			typename std::decay<Function>::type function(std::forward<Function>(subscriber));
+			return AddSubscriber(GetEventID<T>(), [function](const void* payload) { function(*static_cast<const T*>(payload)); });
 		}
 
-		static void Fire(int eventID)
+		template <typename T>
+		static void Unsubscribe(SubscriptionID subscriptionID) { RemoveSubscriber(GetEventID<T>(), subscriptionID); }
+
+		template <typename T>
+		static void Fire(const T& event) { CallSubscribers(GetEventID<T>(), &event); }
+
+		template <typename T>
+		static void Post(T event)
 		{
-			CallSubscriber(eventID);
+			TypedQueuedEvent<T>* queuedEvent = new TypedQueuedEvent<T>(std::move(event));
+			queuedEvent->eventID = GetEventID<T>();
+			Enqueue(queuedEvent);
 		}
 
+		// Lets the sender skip building an event that nobody listens to
+		template <typename T>
+		static bool HasSubscribers() { return HasSubscribers(GetEventID<T>()); }
+
+		// Every type gets its ID once, from a registry shared by all modules
+		template <typename T>
+		static int GetEventID()
+		{
+			static const int eventID = RegisterEventType(typeid(T).name());
+			return eventID;
+		}
+		//==========================================================================
+
+		static bool HasSubscribers(int eventID);
+
+		// Delivers the events posted so far, the engine calls this once per frame from the main thread.
+		// Events posted by subscribers while dispatching are delivered on the next call.
+		static void Dispatch();
+
+		// Removes all subscribers and drops any posted events
 		static void Clear();
 
 	private:
-		static std::vector<std::shared_ptr<Subscriber>> m_subscribers;
-
 		// Hiding implementations on purpose to allow cross-dll usage without linking errors
-		static void AddSubscriber(std::shared_ptr<Subscriber> subscriber);
-		static void RemoveSubscriber(int eventID, std::size_t functionAddress);
-		static void CallSubscriber(int eventID);
+		static SubscriptionID AddSubscriber(int eventID, Subscriber::functionType&& function);
+		static void RemoveSubscriber(int eventID, SubscriptionID subscriptionID);
+		static void CallSubscribers(int eventID, const void* payload);
+		static int RegisterEventType(const char* typeName);
+		static void Enqueue(QueuedEvent* event);
 	};
 }
\ No newline at end of file
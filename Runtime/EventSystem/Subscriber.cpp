@@ -31,22 +31,9 @@ using namespace std;
 
 namespace Directus
 {
-	template<typename T, typename... U>
-	size_t getAddress(function<T(U...)> f)
+	Subscriber::Subscriber(SubscriptionID id, functionType&& subFunc)
 	{
-		typedef T(fnType)(U...);
-		fnType ** fnPointer = f.template target<fnType*>();
-		return (size_t)*fnPointer;
-	}
-
-	Subscriber::Subscriber(int eventID, functionType&& subFunc)
-	{
-		m_eventID = eventID;
+		m_id = id;
 		m_subscribedFunction = forward<functionType>(subFunc);
 	}
-
-	size_t Subscriber::GetAddress()
-	{
-		return getAddress(m_subscribedFunction);
-	}
 }
\ No newline at end of file
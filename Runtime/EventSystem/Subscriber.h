@@ -28,18 +28,21 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Directus
 {
+	// Identifies a subscription, 0 is never handed out
+	typedef unsigned int SubscriptionID;
+
 	class DLL_API Subscriber
 	{
 	public:
-		typedef std::function<void()> functionType;
+		// Receives the event's payload, nullptr for events that don't carry one
+		typedef std::function<void(const void*)> functionType;
 
-		Subscriber(int eventID, functionType&& subFunc);
-		void Call() { m_subscribedFunction(); }
-		int GetEventID() { return m_eventID; }
-		size_t GetAddress();
+		Subscriber(SubscriptionID id, functionType&& subFunc);
+		void Call(const void* payload) const { m_subscribedFunction(payload); }
+		SubscriptionID GetID() const { return m_id; }
 
 	private:
-		int m_eventID;
+		SubscriptionID m_id;
 		functionType m_subscribedFunction;
 	};
 }
\ No newline at end of file
@@ -231,6 +231,22 @@ namespace Directus
 
 		return result;
 	}
+
+	bool FileSystem::RenameFile(const string& source, const string& destination)
+	{
+		bool result = false;
+		try
+		{
+			fs::rename(source, destination);
+			result = true;
+		}
+		catch (fs::filesystem_error& e)
+		{
+			LOG_ERROR("Could not rename \"" + source + "\". " + string(e.what()));
+		}
+
+		return result;
+	}
 	//====================================================================================
 
 	//= DIRECTORY PARSING ================================================================
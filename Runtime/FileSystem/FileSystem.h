@@ -61,6 +61,8 @@ namespace Directus
 		static bool FileExists(const std::string& path);
 		static bool DeleteFile_(const std::string& filePath);
 		static bool CopyFileFromTo(const std::string& source, const std::string& destination);
+		// Replaces the destination if it exists
+		static bool RenameFile(const std::string& source, const std::string& destination);
 		//====================================================================================
 
 		//= DIRECTORY PARSING  =================================================================
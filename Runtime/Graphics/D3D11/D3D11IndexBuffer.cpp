@@ -41,14 +41,13 @@ namespace Directus
 		SafeRelease(m_buffer);
 	}
 
-	bool D3D11IndexBuffer::Create(const vector<UINT>& indices)
+	bool D3D11IndexBuffer::Create(const UINT* indices, unsigned int indexCount)
 	{
-		if (!m_graphics->GetDevice() || indices.empty())
+		if (!m_graphics->GetDevice() || !indices || indexCount == 0)
 			return false;
 
 		UINT stride = sizeof(UINT);
-		float size = (UINT)indices.size();
-		unsigned int finalSize = stride * size;
+		unsigned int finalSize = stride * indexCount;
 
 		// fill in a buffer description.
 		D3D11_BUFFER_DESC bufferDesc;
@@ -62,7 +61,7 @@ namespace Directus
 
 		// fill in the subresource data.
 		D3D11_SUBRESOURCE_DATA initData;
-		initData.pSysMem = indices.data();
+		initData.pSysMem = indices;
 		initData.SysMemPitch = 0;
 		initData.SysMemSlicePitch = 0;
 
@@ -42,14 +42,13 @@ namespace Directus
 		SafeRelease(m_buffer);
 	}
 
-	bool D3D11VertexBuffer::Create(const vector<VertexPosTexNorTan>& vertices)
+	bool D3D11VertexBuffer::Create(const VertexPosTexNorTan* vertices, unsigned int vertexCount)
 	{
-		if (!m_graphics->GetDevice() || vertices.empty())
+		if (!m_graphics->GetDevice() || !vertices || vertexCount == 0)
 			return false;
 
 		m_stride = sizeof(VertexPosTexNorTan);
-		float size = (unsigned int)vertices.size();
-		UINT byteWidth = m_stride * size;
+		UINT byteWidth = m_stride * vertexCount;
 
 		// fill in a buffer description.
 		D3D11_BUFFER_DESC bufferDesc;
@@ -63,7 +62,7 @@ namespace Directus
 
 		// fill in the subresource data.
 		D3D11_SUBRESOURCE_DATA initData;
-		initData.pSysMem = vertices.data();
+		initData.pSysMem = vertices;
 		initData.SysMemPitch = 0;
 		initData.SysMemSlicePitch = 0;
 
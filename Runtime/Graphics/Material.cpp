@@ -138,6 +138,11 @@ namespace Directus
 
 	//= RESOURCE INTERFACE =====================================
 	bool Material::LoadFromFile(const string& filePath)
+	{
+		return DecodeFromFile(filePath) && FinalizeLoad();
+	}
+
+	bool Material::DecodeFromFile(const string& filePath)
 	{
 		// Make sure the path is relative
 		m_resourceFilePath = FileSystem::GetRelativeFilePath(filePath);
@@ -182,19 +187,37 @@ namespace Directus
 		}
 		XmlDocument::Release();
 
-		// Load unloaded textures
+		// Textures which aren't loaded load in the background, GetTextureByType() picks them up once they are
 		for (auto& it : m_textures)
 		{
 			if (it.second.first.expired())
 			{
-				it.second.first = m_context->GetSubsystem<ResourceManager>()->Load<Texture>(it.second.second);
+				m_context->GetSubsystem<ResourceManager>()->LoadAsync<Texture>(it.second.second);
 			}
 		}
 
+		return true;
+	}
+
+	bool Material::FinalizeLoad()
+	{
+		// The shader only depends on which textures the material has
 		AcquireShader();
 
 		return true;
 	}
+
+	unsigned long long Material::GetMemoryUsageCPU()
+	{
+		// The textures count on their own
+		unsigned long long size = sizeof(Material);
+		for (const auto& texture : m_textures)
+		{
+			size += texture.second.second.size();
+		}
+
+		return size;
+	}
 	//==========================================================
 
 	//= TEXTURES ===================================================================
@@ -233,10 +256,15 @@ namespace Directus
 
 	weak_ptr<Texture> Material::GetTextureByType(TextureType type)
 	{
-		for (const auto& it : m_textures)
+		for (auto& it : m_textures)
 		{
 			if (it.first == type)
 			{
+				// A texture still loading (or evicted) is picked up from the cache
+				if (it.second.first.expired() && m_context)
+				{
+					it.second.first = m_context->GetSubsystem<ResourceManager>()->GetResourceByPath<Texture>(it.second.second);
+				}
 				return it.second.first;
 			}
 		}
@@ -325,15 +353,15 @@ namespace Directus
 		auto shaders = m_context->GetSubsystem<ResourceManager>()->GetResourcesByType<ShaderVariation>();
 		for (const auto& shader : shaders)
 		{
-			if (shader._Get()->HasAlbedoTexture() != albedo) continue;
-			if (shader._Get()->HasRoughnessTexture() != roughness) continue;
-			if (shader._Get()->HasMetallicTexture() != metallic) continue;
-			if (shader._Get()->HasNormalTexture() != normal) continue;
-			if (shader._Get()->HasHeightTexture() != height) continue;
-			if (shader._Get()->HasOcclusionTexture() != occlusion) continue;
-			if (shader._Get()->HasEmissionTexture() != emission) continue;
-			if (shader._Get()->HasMaskTexture() != mask) continue;
-			if (shader._Get()->HasCubeMapTexture() != cubemap) continue;
+			if (shader->HasAlbedoTexture() != albedo) continue;
+			if (shader->HasRoughnessTexture() != roughness) continue;
+			if (shader->HasMetallicTexture() != metallic) continue;
+			if (shader->HasNormalTexture() != normal) continue;
+			if (shader->HasHeightTexture() != height) continue;
+			if (shader->HasOcclusionTexture() != occlusion) continue;
+			if (shader->HasEmissionTexture() != emission) continue;
+			if (shader->HasMaskTexture() != mask) continue;
+			if (shader->HasCubeMapTexture() != cubemap) continue;
 
 			return shader;
 		}
@@ -371,6 +399,12 @@ namespace Directus
 			return texture._Get()->GetShaderResource();
 		}
 
+		// The shader samples every texture the material has, one that's still loading gets a stand-in
+		if (HasTextureOfType(type) && m_context)
+		{
+			return m_context->GetSubsystem<ResourceManager>()->GetPlaceholderTexture(type)->GetShaderResource();
+		}
+
 		return nullptr;
 	}
 	//==============================================================================
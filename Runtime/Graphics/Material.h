@@ -65,6 +65,9 @@ namespace Directus
 		//= RESOURCE INTERFACE ======================================
 		bool LoadFromFile(const std::string& filePath);
 		bool SaveToFile(const std::string& filePath) { return true; }
+		bool DecodeFromFile(const std::string& filePath);
+		bool FinalizeLoad();
+		unsigned long long GetMemoryUsageCPU();
 		//===========================================================
 
 		//= TEXTURES ==================================================================
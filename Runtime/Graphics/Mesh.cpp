@@ -26,7 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Logging/Log.h"
 #include "../Core/GUIDGenerator.h"
 #include "../FileSystem/FileSystem.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryReader.h"
 //===================================
 
 //= NAMESPACES ================
@@ -36,6 +36,9 @@ using namespace Directus::Math;
 
 namespace Directus
 {
+	// Vertices are stored as they sit in memory, eleven tightly packed floats
+	static_assert(sizeof(VertexPosTexNorTan) == 11 * sizeof(float), "The vertex layout no longer matches the file format");
+
 	Mesh::Mesh()
 	{
 		// Mesh	
@@ -46,6 +49,8 @@ namespace Directus
 		m_triangleCount = 0;
 		m_boundingBox = BoundingBox();
 		m_onUpdate = nullptr;
+		m_mappedVertices = nullptr;
+		m_mappedIndices = nullptr;
 	}
 
 	Mesh::~Mesh()
@@ -59,64 +64,88 @@ namespace Directus
 	}
 
 	//= IO =========================================================================
-	void Mesh::Serialize()
+	void Mesh::Deserialize(BinaryReader* reader)
 	{
-		StreamIO::WriteSTR(m_id);
-		StreamIO::WriteSTR(m_gameObjID);
-		StreamIO::WriteSTR(m_modelID);
-		StreamIO::WriteSTR(m_name);
-		StreamIO::WriteInt(m_vertexCount);
-		StreamIO::WriteInt(m_indexCount);
-		StreamIO::WriteInt(m_triangleCount);
-
-		for (const auto& vertex : m_vertices)
+		m_id = reader->ReadSTR();
+		m_gameObjID = reader->ReadSTR();
+		m_modelID = reader->ReadSTR();
+		m_name = reader->ReadSTR();
+		m_vertexCount = reader->ReadInt();
+		m_indexCount = reader->ReadInt();
+		m_triangleCount = reader->ReadInt();
+
+		// Counts come from the file, don't trust them with an allocation before they're known to fit
+		if (!reader->IsValid() || (size_t)m_vertexCount * sizeof(VertexPosTexNorTan) + (size_t)m_indexCount * sizeof(unsigned int) > reader->GetSize() - reader->GetPosition())
 		{
-			SaveVertex(vertex);
+			LOG_ERROR("Mesh: \"" + m_name + "\" is truncated or corrupt.");
+			m_vertexCount = m_indexCount = m_triangleCount = 0;
+			return;
 		}
 
-		for (const auto& index : m_indices)
-		{
-			StreamIO::WriteInt(index);
-		}
+		m_vertices.resize(m_vertexCount);
+		m_indices.resize(m_indexCount);
+		reader->ReadArray(m_vertices.data(), m_vertices.size());
+		reader->ReadArray(m_indices.data(), m_indices.size());
+
+		m_boundingBox.ComputeFromMesh(this);
 	}
 
-	void Mesh::Deserialize()
+	vector<VertexPosTexNorTan>& Mesh::GetVertices()
 	{
-		m_id = StreamIO::ReadSTR();
-		m_gameObjID = StreamIO::ReadSTR();
-		m_modelID = StreamIO::ReadSTR();
-		m_name = StreamIO::ReadSTR();
-		m_vertexCount = StreamIO::ReadInt();
-		m_indexCount = StreamIO::ReadInt();
-		m_triangleCount = StreamIO::ReadInt();
-
-		for (unsigned int i = 0; i < m_vertexCount; i++)
-		{
-			m_vertices.push_back(VertexPosTexNorTan());
-			LoadVertex(m_vertices.back());
-		}
-
-		for (unsigned int i = 0; i < m_indexCount; i++)
-		{
-			m_indices.push_back(StreamIO::ReadInt());
-		}
-
-		m_boundingBox.ComputeFromMesh(this);
+		DetachMappedGeometry();
+		return m_vertices;
 	}
 
 	void Mesh::SetVertices(const vector<VertexPosTexNorTan>& vertices)
 	{
+		DetachMappedGeometry();
 		m_vertices = vertices;
 		m_vertexCount = (unsigned int)vertices.size();
 	}
 
+	vector<unsigned int>& Mesh::GetIndices()
+	{
+		DetachMappedGeometry();
+		return m_indices;
+	}
+
 	void Mesh::SetIndices(const vector<unsigned>& indices)
 	{
+		DetachMappedGeometry();
 		m_indices = indices;
 		m_indexCount = (unsigned int)indices.size();
 		m_triangleCount = m_indexCount / 3;
 	}
 
+	void Mesh::SetMappedGeometry(shared_ptr<const void> storage, const VertexPosTexNorTan* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount, const BoundingBox& boundingBox)
+	{
+		m_vertices.clear();
+		m_vertices.shrink_to_fit();
+		m_indices.clear();
+		m_indices.shrink_to_fit();
+
+		m_mappedStorage = storage;
+		m_mappedVertices = vertices;
+		m_mappedIndices = indices;
+		m_vertexCount = vertexCount;
+		m_indexCount = indexCount;
+		m_triangleCount = m_indexCount / 3;
+		m_boundingBox = boundingBox;
+	}
+
+	void Mesh::DetachMappedGeometry()
+	{
+		if (!m_mappedStorage)
+			return;
+
+		m_vertices.assign(m_mappedVertices, m_mappedVertices + m_vertexCount);
+		m_indices.assign(m_mappedIndices, m_mappedIndices + m_indexCount);
+
+		m_mappedVertices = nullptr;
+		m_mappedIndices = nullptr;
+		m_mappedStorage.reset();
+	}
+
 	//==============================================================================
 
 	//= PROCESSING =================================================================
@@ -149,50 +178,13 @@ namespace Directus
 	}
 	//==============================================================================
 
-	//= IO =========================================================================
-	void Mesh::SaveVertex(const VertexPosTexNorTan& vertex)
-	{
-		StreamIO::WriteFloat(vertex.position.x);
-		StreamIO::WriteFloat(vertex.position.y);
-		StreamIO::WriteFloat(vertex.position.z);
-
-		StreamIO::WriteFloat(vertex.uv.x);
-		StreamIO::WriteFloat(vertex.uv.y);
-
-		StreamIO::WriteFloat(vertex.normal.x);
-		StreamIO::WriteFloat(vertex.normal.y);
-		StreamIO::WriteFloat(vertex.normal.z);
-
-		StreamIO::WriteFloat(vertex.tangent.x);
-		StreamIO::WriteFloat(vertex.tangent.y);
-		StreamIO::WriteFloat(vertex.tangent.z);
-	}
-
-	void Mesh::LoadVertex(VertexPosTexNorTan& vertex)
-	{
-		vertex.position.x = StreamIO::ReadFloat();
-		vertex.position.y = StreamIO::ReadFloat();
-		vertex.position.z = StreamIO::ReadFloat();
-
-		vertex.uv.x = StreamIO::ReadFloat();
-		vertex.uv.y = StreamIO::ReadFloat();
-
-		vertex.normal.x = StreamIO::ReadFloat();
-		vertex.normal.y = StreamIO::ReadFloat();
-		vertex.normal.z = StreamIO::ReadFloat();
-
-		vertex.tangent.x = StreamIO::ReadFloat();
-		vertex.tangent.y = StreamIO::ReadFloat();
-		vertex.tangent.z = StreamIO::ReadFloat();
-	}
-	//==============================================================================
-
 	//= HELPER FUNCTIONS ===========================================================
 	void Mesh::SetScale(Mesh* meshData, float scale)
 	{
+		auto& vertices = meshData->GetVertices();
 		for (unsigned int i = 0; i < meshData->GetVertexCount(); i++)
 		{
-			meshData->GetVertices()[i].position *= scale;
+			vertices[i].position *= scale;
 		}
 	}
 	//==============================================================================
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ==================
 #include <vector>
+#include <memory>
 #include <functional>
 #include "Vertex.h"
 #include "../Math/BoundingBox.h"
@@ -30,16 +31,19 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Directus
 {
+	class BinaryReader;
+
 	class Mesh
 	{
 	public:
 		Mesh();
 		~Mesh();
 
-		void Serialize();
-		void Deserialize();
+		// Reads a mesh stored in the legacy (pre-mapping) engine format
+		void Deserialize(BinaryReader* reader);
 
 		const std::string& GetID() { return m_id; }
+		void SetID(const std::string& id) { m_id = id; }
 
 		const std::string& GetGameObjectID() { return m_gameObjID; }
 		void SetGameObjectID(const std::string& gameObjID) { m_gameObjID = gameObjID; }
@@ -50,16 +54,28 @@ namespace Directus
 		const std::string& GetName() { return m_name; }
 		void SetName(const std::string& name) { m_name = name; }
 
-		std::vector<VertexPosTexNorTan>& GetVertices() { return m_vertices; }
+		// Read-only geometry, wherever it lives. Valid until the mesh is modified.
+		const VertexPosTexNorTan* GetVertexData() const { return m_mappedVertices ? m_mappedVertices : m_vertices.data(); }
+		const unsigned int* GetIndexData() const { return m_mappedIndices ? m_mappedIndices : m_indices.data(); }
+
+		// Modifiable geometry, a mapped mesh gets copied into memory first
+		std::vector<VertexPosTexNorTan>& GetVertices();
 		void SetVertices(const std::vector<VertexPosTexNorTan>& vertices);
 
-		std::vector<unsigned int>& GetIndices() { return m_indices; }
+		std::vector<unsigned int>& GetIndices();
 		void SetIndices(const std::vector<unsigned int>& indices);
 
+		// Points the mesh at geometry inside a loaded model file, storage being whatever holds it (the mapped file
+		// or the buffer it was decompressed to). The bounding box is taken as is instead of being computed.
+		void SetMappedGeometry(std::shared_ptr<const void> storage, const VertexPosTexNorTan* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount, const Math::BoundingBox& boundingBox);
+		bool IsMapped() const { return m_mappedStorage != nullptr; }
+		// Copies mapped geometry into the mesh and lets go of the storage
+		void DetachMappedGeometry();
+
 		unsigned int GetVertexCount() const { return m_vertexCount; }
 		unsigned int GetIndexCount() const { return m_indexCount; }
 		unsigned int GetTriangleCount() const { return m_triangleCount; }
-		unsigned int GetIndexStart() { return !m_indices.empty() ? m_indices.front() : 0; }
+		unsigned int GetIndexStart() { return m_indexCount != 0 ? GetIndexData()[0] : 0; }
 
 		const Math::BoundingBox& GetBoundingBox() { return m_boundingBox; }
 
@@ -70,11 +86,6 @@ namespace Directus
 		//==============================================================================
 
 	private:
-		//= IO =========================================================================
-		static void SaveVertex(const VertexPosTexNorTan& vertex);
-		static void LoadVertex(VertexPosTexNorTan& vertex);
-		//==============================================================================
-
 		//= HELPER FUNCTIONS =============================
 		static void SetScale(Mesh* meshData, float scale);
 		//================================================
@@ -87,6 +98,11 @@ namespace Directus
 		std::vector<VertexPosTexNorTan> m_vertices;
 		std::vector<unsigned int> m_indices;
 
+		// Geometry that lives in a loaded model file, instead of the vectors above
+		std::shared_ptr<const void> m_mappedStorage;
+		const VertexPosTexNorTan* m_mappedVertices;
+		const unsigned int* m_mappedIndices;
+
 		unsigned int m_vertexCount;
 		unsigned int m_indexCount;
 		unsigned int m_triangleCount;
@@ -23,14 +23,22 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Model.h"
 #include "Mesh.h"
 #include "../Core/GameObject.h"
+#include "../Core/Scene.h"
 #include "../Core/GUIDGenerator.h"
 #include "../Resource/ResourceManager.h"
 #include "../Components/MeshFilter.h"
+#include "../Components/MeshRenderer.h"
 #include "../Components/Transform.h"
 #include "../Graphics/Vertex.h"
 #include "../Graphics/Material.h"
 #include "../Graphics/Shaders/ShaderVariation.h"
-#include "../IO/StreamIO.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
+#include "../IO/MemoryMappedFile.h"
+#include "../IO/BlockCompression.h"
+#include "../IO/ContentHash.h"
+#include "../Core/Settings.h"
+#include "../Threading/Threading.h"
 //==============================================
 
 //= NAMESPACES ================
@@ -40,6 +48,64 @@ using namespace Directus::Math;
 
 namespace Directus
 {
+	//= ENGINE FORMAT ==========================================================================================
+	// The model file is laid out so that it can be used in place once mapped, the geometry is never parsed:
+	// [header][table of contents, one entry per mesh][strings][vertices, indices, ... (16 byte aligned)]
+	static const char MODEL_MAGIC[4] = { 'D', 'M', 'D', 'L' };
+	static const uint32_t MODEL_VERSION = 2;
+	static const uint64_t MODEL_ALIGNMENT = 16;
+
+	struct ModelFileHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t meshCount;
+		float normalizedScale;
+		uint64_t stringsOffset; // the model's ID, name and file path
+		uint64_t stringsSize;
+	};
+
+	struct ModelFileMesh
+	{
+		uint64_t stringsOffset; // the mesh's ID, GameObject ID, model ID and name
+		uint64_t stringsSize;
+		uint64_t verticesOffset;
+		uint64_t indicesOffset;
+		uint32_t vertexCount;
+		uint32_t indexCount;
+		float aabbMin[3];
+		float aabbMax[3];
+	};
+
+	// The hierarchy an import builds, stored next to the model in the DerivedDataCache:
+	// [node count][per node: parent index, name, local transform, mesh index, material file path]
+	static const char* DERIVED_HIERARCHY_EXTENSION = ".hierarchy";
+
+	struct DerivedNode
+	{
+		int parent;
+		string name;
+		Vector3 position;
+		Quaternion rotation;
+		Vector3 scale;
+		int mesh;
+		string materialFilePath;
+	};
+
+	static_assert(sizeof(ModelFileHeader) == 32 && sizeof(ModelFileMesh) == 64, "The model file structures must not contain padding");
+
+	static uint64_t AlignOffset(uint64_t offset)
+	{
+		return (offset + MODEL_ALIGNMENT - 1) & ~(MODEL_ALIGNMENT - 1);
+	}
+
+	// Overflow safe check that [offset, offset + size) lies within the file
+	static bool IsInFile(uint64_t offset, uint64_t size, uint64_t fileSize)
+	{
+		return offset <= fileSize && size <= fileSize - offset;
+	}
+	//===========================================================================================================
+
 	Model::Model(Context* context)
 	{
 		m_context = context;
@@ -89,6 +155,38 @@ namespace Directus
 		return success;
 	}
 
+	bool Model::DecodeFromFile(const string& filePath)
+	{
+		if (FileSystem::GetExtensionFromFilePath(filePath) == MODEL_EXTENSION)
+			return LoadFromFile(filePath);
+
+		m_foreignFilePath = filePath;
+		return true;
+	}
+
+	bool Model::FinalizeLoad()
+	{
+		if (m_foreignFilePath.empty())
+			return true;
+
+		string filePath;
+		filePath.swap(m_foreignFilePath);
+		return LoadFromFile(filePath);
+	}
+
+	unsigned long long Model::GetMemoryUsageCPU()
+	{
+		// The vertex and index buffers belong to the MeshFilters which use the meshes
+		unsigned long long size = 0;
+		for (const auto& mesh : m_meshes)
+		{
+			size += (unsigned long long)mesh->GetVertexCount() * sizeof(VertexPosTexNorTan);
+			size += (unsigned long long)mesh->GetIndexCount() * sizeof(unsigned int);
+		}
+
+		return size;
+	}
+
 	bool Model::SaveToFile(const string& filePath)
 	{
 		string savePath = filePath;
@@ -97,22 +195,105 @@ namespace Directus
 			savePath = m_resourceFilePath;
 		}
 
-		if (!StreamIO::StartWriting(savePath))
-			return false;
+		// Nothing changed since the model was loaded from or saved to that very file
+		if (savePath == m_savedFilePath && IsGeometryMapped())
+			return true;
 
-		StreamIO::WriteSTR(m_resourceID);
-		StreamIO::WriteSTR(m_resourceName);
-		StreamIO::WriteSTR(m_resourceFilePath);
-		StreamIO::WriteFloat(m_normalizedScale);
-		StreamIO::WriteInt((int)m_meshes.size());
+		// Strings first, their size determines where the geometry starts
+		BinaryWriter strings;
+		strings.WriteSTR(m_resourceID);
+		strings.WriteSTR(m_resourceName);
+		strings.WriteSTR(m_resourceFilePath);
+
+		ModelFileHeader header = {};
+		memcpy(header.magic, MODEL_MAGIC, sizeof(header.magic));
+		header.version = MODEL_VERSION;
+		header.meshCount = (uint32_t)m_meshes.size();
+		header.normalizedScale = m_normalizedScale;
+		header.stringsOffset = sizeof(ModelFileHeader) + m_meshes.size() * sizeof(ModelFileMesh);
+		header.stringsSize = strings.GetSize();
+
+		vector<ModelFileMesh> contents(m_meshes.size());
+		for (size_t i = 0; i < m_meshes.size(); i++)
+		{
+			const auto& mesh = m_meshes[i];
+			contents[i].stringsOffset = header.stringsOffset + strings.GetSize();
+			strings.WriteSTR(mesh->GetID());
+			strings.WriteSTR(mesh->GetGameObjectID());
+			strings.WriteSTR(mesh->GetModelID());
+			strings.WriteSTR(mesh->GetName());
+			contents[i].stringsSize = header.stringsOffset + strings.GetSize() - contents[i].stringsOffset;
+		}
+
+		// Then the geometry, every array starts aligned
+		uint64_t offset = header.stringsOffset + strings.GetSize();
+		for (size_t i = 0; i < m_meshes.size(); i++)
+		{
+			const auto& mesh = m_meshes[i];
+			const BoundingBox& box = mesh->GetBoundingBox();
+
+			contents[i].vertexCount = mesh->GetVertexCount();
+			contents[i].indexCount = mesh->GetIndexCount();
+			contents[i].verticesOffset = AlignOffset(offset);
+			contents[i].indicesOffset = AlignOffset(contents[i].verticesOffset + (uint64_t)contents[i].vertexCount * sizeof(VertexPosTexNorTan));
+			offset = contents[i].indicesOffset + (uint64_t)contents[i].indexCount * sizeof(unsigned int);
+
+			float aabb[6] = { box.min.x, box.min.y, box.min.z, box.max.x, box.max.y, box.max.z };
+			memcpy(contents[i].aabbMin, &aabb[0], sizeof(contents[i].aabbMin));
+			memcpy(contents[i].aabbMax, &aabb[3], sizeof(contents[i].aabbMax));
+		}
 
+		BinaryWriter writer;
+		writer.Reserve((size_t)offset);
+		writer.WriteBytes(&header, sizeof(header));
+		writer.WriteArray(contents.data(), contents.size());
+		writer.WriteBytes(strings.GetData(), strings.GetSize());
 		for (const auto& mesh : m_meshes)
 		{
-			mesh->Serialize();
+			writer.Align(MODEL_ALIGNMENT);
+			writer.WriteArray(mesh->GetVertexData(), mesh->GetVertexCount());
+			writer.Align(MODEL_ALIGNMENT);
+			writer.WriteArray(mesh->GetIndexData(), mesh->GetIndexCount());
+		}
+
+		// Written next to the file and then moved over it, a failed save never leaves half a model behind
+		Threading* threading = m_context->GetSubsystem<Threading>();
+		string temporaryFilePath = savePath + ".tmp";
+		if (!writer.SaveToFile(temporaryFilePath, Settings::GetCompressAssets(), threading))
+			return false;
+
+		// Once no mesh points into the storage anymore (they were all modified), nothing reads it
+		bool meshMapped = false;
+		for (const auto& mesh : m_meshes)
+		{
+			meshMapped = meshMapped || mesh->IsMapped();
+		}
+		if (!meshMapped)
+		{
+			m_mappedStorage.reset();
+			m_mappedFilePath.clear();
+		}
+
+		// A mapped file can't be replaced. Scenes save on a worker while the main thread renders,
+		// so only the main thread may take the geometry out of the file.
+		if (m_mappedStorage && savePath == m_mappedFilePath)
+		{
+			if (!threading->IsMainThread())
+			{
+				LOG_WARNING("Model: \"" + savePath + "\" is mapped, it can only be replaced from the main thread.");
+				FileSystem::DeleteFile_(temporaryFilePath);
+				return false;
+			}
+			DetachMappedGeometry();
 		}
 
-		StreamIO::StopWriting();
+		if (!FileSystem::RenameFile(temporaryFilePath, savePath))
+		{
+			FileSystem::DeleteFile_(temporaryFilePath);
+			return false;
+		}
 
+		m_savedFilePath = savePath;
 		return true;
 	}
 	//============================================================================================
@@ -152,13 +333,13 @@ namespace Directus
 		if (!material)
 			return weak_ptr<Material>();
 
-		// Add it to our resources
-		weak_ptr<Material> weakMat = m_context->GetSubsystem<ResourceManager>()->Add(material);
-
-		// Save the material/shader in our custom format
+		// Save the material/shader in our custom format, first as that's what gives the material its file path
 		material._Get()->Save(GetResourceDirectory() + "Materials//" + material->GetResourceName(), false);
 		material._Get()->GetShader()._Get()->SaveToFile(GetResourceDirectory() + "Shaders//" + material._Get()->GetResourceName());
 
+		// Add it to our resources
+		weak_ptr<Material> weakMat = m_context->GetSubsystem<ResourceManager>()->Add(material);
+
 		// Save it
 		m_materials.push_back(material);
 
@@ -200,6 +381,30 @@ namespace Directus
 		return textureDestination;
 	}
 
+	bool Model::IsGeometryMapped()
+	{
+		if (!m_mappedStorage)
+			return false;
+
+		for (const auto& mesh : m_meshes)
+		{
+			if (!mesh->IsMapped())
+				return false;
+		}
+
+		return true;
+	}
+
+	void Model::DetachMappedGeometry()
+	{
+		for (const auto& mesh : m_meshes)
+		{
+			mesh->DetachMappedGeometry();
+		}
+		m_mappedStorage.reset();
+		m_mappedFilePath.clear();
+	}
+
 	float Model::GetBoundingSphereRadius()
 	{
 		Vector3 extent = m_boundingBox.GetHalfSize().Absolute();
@@ -207,27 +412,118 @@ namespace Directus
 	}
 
 	bool Model::LoadFromEngineFormat(const string& filePath)
+	{
+		auto file = make_shared<MemoryMappedFile>();
+		if (!file->Open(filePath))
+			return false;
+
+		// The meshes point into whatever holds the geometry, which is the mapping
+		// itself, or a buffer when the file was saved with block compression
+		shared_ptr<const void> storage = file;
+		const char* data = file->GetData();
+		uint64_t fileSize = file->GetSize();
+		if (BlockCompression::IsCompressed(data, (size_t)fileSize))
+		{
+			auto buffer = make_shared<vector<char>>();
+			if (!BlockCompression::Decompress(data, (size_t)fileSize, *buffer, m_context->GetSubsystem<Threading>()))
+			{
+				LOG_ERROR("Model: \"" + filePath + "\" is compressed but could not be decompressed.");
+				return false;
+			}
+			file->Close();
+
+			storage = buffer;
+			data = buffer->data();
+			fileSize = buffer->size();
+		}
+
+		// Files saved before the mapped layout existed start with a string, not the magic
+		if (fileSize < sizeof(ModelFileHeader) || memcmp(data, MODEL_MAGIC, sizeof(MODEL_MAGIC)) != 0)
+		{
+			file->Close();
+			return LoadFromLegacyEngineFormat(filePath);
+		}
+
+		const ModelFileHeader* header = (const ModelFileHeader*)data;
+		if (header->version != MODEL_VERSION)
+		{
+			LOG_ERROR("Model: \"" + filePath + "\" has an unsupported version (" + to_string(header->version) + ").");
+			return false;
+		}
+
+		if (!IsInFile(sizeof(ModelFileHeader), (uint64_t)header->meshCount * sizeof(ModelFileMesh), fileSize) || !IsInFile(header->stringsOffset, header->stringsSize, fileSize))
+		{
+			LOG_ERROR("Model: \"" + filePath + "\" is truncated or corrupt.");
+			return false;
+		}
+
+		BinaryReader strings(data + header->stringsOffset, (size_t)header->stringsSize);
+		m_resourceID = strings.ReadSTR();
+		m_resourceName = strings.ReadSTR();
+		m_resourceFilePath = strings.ReadSTR();
+		m_normalizedScale = header->normalizedScale;
+
+		// The table of contents has everything needed, the meshes just point into the file
+		const ModelFileMesh* contents = (const ModelFileMesh*)(data + sizeof(ModelFileHeader));
+		m_meshes.reserve(m_meshes.size() + header->meshCount);
+		for (uint32_t i = 0; i < header->meshCount; i++)
+		{
+			const ModelFileMesh& entry = contents[i];
+			if (!IsInFile(entry.stringsOffset, entry.stringsSize, fileSize) ||
+				!IsInFile(entry.verticesOffset, (uint64_t)entry.vertexCount * sizeof(VertexPosTexNorTan), fileSize) ||
+				!IsInFile(entry.indicesOffset, (uint64_t)entry.indexCount * sizeof(unsigned int), fileSize) ||
+				entry.verticesOffset % MODEL_ALIGNMENT != 0 || entry.indicesOffset % MODEL_ALIGNMENT != 0)
+			{
+				LOG_ERROR("Model: \"" + filePath + "\" is truncated or corrupt.");
+				return false;
+			}
+
+			BinaryReader meshStrings(data + entry.stringsOffset, (size_t)entry.stringsSize);
+			auto mesh = make_shared<Mesh>();
+			mesh->SetID(meshStrings.ReadSTR());
+			mesh->SetGameObjectID(meshStrings.ReadSTR());
+			mesh->SetModelID(meshStrings.ReadSTR());
+			mesh->SetName(meshStrings.ReadSTR());
+			mesh->SetMappedGeometry(
+				storage,
+				(const VertexPosTexNorTan*)(data + entry.verticesOffset), entry.vertexCount,
+				(const unsigned int*)(data + entry.indicesOffset), entry.indexCount,
+				BoundingBox(Vector3(entry.aabbMin[0], entry.aabbMin[1], entry.aabbMin[2]), Vector3(entry.aabbMax[0], entry.aabbMax[1], entry.aabbMax[2]))
+			);
+
+			// The bounding box is precomputed, so skip AddMesh() and its Update()
+			m_meshes.push_back(mesh);
+		}
+
+		m_mappedStorage = storage;
+		m_mappedFilePath = storage == file ? filePath : string();
+		m_savedFilePath = filePath;
+		ComputeDimensions();
+
+		return strings.IsValid();
+	}
+
+	bool Model::LoadFromLegacyEngineFormat(const string& filePath)
 	{
 		// Deserialize
-		if (!StreamIO::StartReading(filePath))
+		BinaryReader reader;
+		if (!reader.LoadFromFile(filePath, m_context->GetSubsystem<Threading>()))
 			return false;
 
-		m_resourceID = StreamIO::ReadSTR();
-		m_resourceName = StreamIO::ReadSTR();
-		m_resourceFilePath = StreamIO::ReadSTR();
-		m_normalizedScale = StreamIO::ReadFloat();
-		int meshCount = StreamIO::ReadInt();
+		m_resourceID = reader.ReadSTR();
+		m_resourceName = reader.ReadSTR();
+		m_resourceFilePath = reader.ReadSTR();
+		m_normalizedScale = reader.ReadFloat();
+		int meshCount = reader.ReadInt();
 
-		for (int i = 0; i < meshCount; i++)
+		for (int i = 0; i < meshCount && reader.IsValid(); i++)
 		{
 			auto mesh = make_shared<Mesh>();
-			mesh->Deserialize();
+			mesh->Deserialize(&reader);
 			AddMesh(mesh);
 		}
 
-		StreamIO::StopReading();
-
-		return true;
+		return reader.IsValid();
 	}
 
 	bool Model::LoadFromForeignFormat(const string& filePath)
@@ -241,6 +537,15 @@ namespace Directus
 		FileSystem::CreateDirectory_(dir + "Materials//");
 		FileSystem::CreateDirectory_(dir + "Shaders//");
 
+		// An unchanged model is served from what its last import derived, without running the importer
+		DerivedDataCache* derivedData = m_resourceManager->GetDerivedDataCache();
+		uint64_t key = 0;
+		// The materials and textures an import writes live in the asset directory, so it's part of the key
+		uint64_t settings = ContentHash::Compute(m_resourceFilePath.data(), m_resourceFilePath.size());
+		bool keyed = derivedData && derivedData->MakeKey(filePath, settings, ModelImporter::VERSION, key);
+		if (keyed && LoadFromDerivedData(key))
+			return true;
+
 		// Load the model
 		if (m_resourceManager->GetModelImporter()._Get()->Load(this, filePath))
 		{
@@ -252,12 +557,170 @@ namespace Directus
 			// Save the model in our custom format.
 			SaveToFile(m_resourceFilePath);
 
+			if (keyed)
+			{
+				SaveDerivedData(key);
+			}
+
 			return true;
 		}
 
 		return false;
 	}
 
+	bool Model::LoadFromDerivedData(uint64_t key)
+	{
+		DerivedDataCache* derivedData = m_resourceManager->GetDerivedDataCache();
+		BinaryReader reader;
+		if (!derivedData->Load(key, DERIVED_HIERARCHY_EXTENSION, reader))
+			return false;
+
+		// Never trust a count beyond what's left to read
+		size_t nodeCount = reader.ReadUINT();
+		if (!reader.IsValid() || nodeCount == 0 || nodeCount > reader.GetSize() - reader.GetPosition())
+			return false;
+
+		vector<DerivedNode> nodes(nodeCount);
+
+		for (size_t i = 0; i < nodes.size(); i++)
+		{
+			DerivedNode& node = nodes[i];
+			node.parent = reader.ReadInt();
+			node.name = reader.ReadSTR();
+			node.position = reader.ReadVector3();
+			node.rotation = reader.ReadQuaternion();
+			node.scale = reader.ReadVector3();
+			node.mesh = reader.ReadInt();
+			node.materialFilePath = reader.ReadSTR();
+
+			// Parents come first, only the root has none
+			if (!reader.IsValid() || node.parent >= (int)i || (node.parent < 0) != (i == 0))
+				return false;
+
+			// The materials and textures live with the imported model, if they are gone, import again
+			if (node.materialFilePath != DATA_NOT_ASSIGNED && !FileSystem::FileExists(node.materialFilePath))
+				return false;
+		}
+
+		// The cached file holds the ID, name and path of the import which stored it, this model keeps its own
+		string resourceID = m_resourceID;
+		string resourceName = m_resourceName;
+		string resourceFilePath = m_resourceFilePath;
+		bool loaded = LoadFromEngineFormat(derivedData->GetFilePath(key, MODEL_EXTENSION));
+		for (const auto& node : nodes)
+		{
+			loaded = loaded && node.mesh < (int)m_meshes.size();
+		}
+
+		m_resourceID = resourceID;
+		m_resourceName = resourceName;
+		m_resourceFilePath = resourceFilePath;
+		m_savedFilePath.clear();
+		if (!loaded)
+		{
+			LOG_WARNING("Model: The derived data of \"" + m_resourceName + "\" is unusable, importing it again.");
+			m_meshes.clear();
+			m_mappedStorage.reset();
+			m_mappedFilePath.clear();
+			m_boundingBox = BoundingBox();
+			return false;
+		}
+
+		for (const auto& mesh : m_meshes)
+		{
+			mesh->SetModelID(m_resourceID);
+		}
+
+		// Build the hierarchy the importer would have built
+		Scene* scene = m_context->GetSubsystem<Scene>();
+		vector<weak_ptr<GameObject>> gameObjects;
+		gameObjects.reserve(nodes.size());
+		for (const auto& node : nodes)
+		{
+			auto gameObject = scene->CreateGameObject();
+			gameObjects.push_back(gameObject);
+
+			gameObject._Get()->SetName(node.name);
+			Transform* transform = gameObject._Get()->GetTransform();
+			transform->SetParent(node.parent >= 0 ? gameObjects[node.parent]._Get()->GetTransform() : nullptr);
+			transform->SetPositionLocal(node.position);
+			transform->SetRotationLocal(node.rotation);
+			transform->SetScaleLocal(node.scale);
+
+			if (node.mesh >= 0)
+			{
+				const auto& mesh = m_meshes[node.mesh];
+				mesh->SetGameObjectID(to_string(gameObject._Get()->GetID()));
+				gameObject._Get()->AddComponent<MeshFilter>()->SetMesh(mesh);
+			}
+
+			if (node.materialFilePath != DATA_NOT_ASSIGNED)
+			{
+				m_materials.push_back(gameObject._Get()->AddComponent<MeshRenderer>()->SetMaterialFromFile(node.materialFilePath));
+			}
+		}
+		SetRootGameObject(gameObjects.front());
+		gameObjects.front()._Get()->GetTransform()->UpdateTransform();
+
+		// Save the model in our custom format, as the import would have
+		SaveToFile(m_resourceFilePath);
+
+		return true;
+	}
+
+	void Model::SaveDerivedData(uint64_t key)
+	{
+		if (m_rootGameObj.expired())
+			return;
+
+		// Flatten the hierarchy, parents first
+		vector<Transform*> transforms = { m_rootGameObj._Get()->GetTransform() };
+		vector<int> parents = { -1 };
+		for (size_t i = 0; i < transforms.size(); i++)
+		{
+			for (Transform* child : transforms[i]->GetChildren())
+			{
+				transforms.push_back(child);
+				parents.push_back((int)i);
+			}
+		}
+
+		BinaryWriter writer;
+		writer.WriteUINT((unsigned int)transforms.size());
+		for (size_t i = 0; i < transforms.size(); i++)
+		{
+			Transform* transform = transforms[i];
+			GameObject* gameObject = transform->GetGameObject()._Get();
+
+			int meshIndex = -1;
+			MeshFilter* meshFilter = gameObject->GetComponent<MeshFilter>();
+			shared_ptr<Mesh> mesh = meshFilter ? meshFilter->GetMesh().lock() : nullptr;
+			for (size_t j = 0; mesh && j < m_meshes.size(); j++)
+			{
+				meshIndex = m_meshes[j] == mesh ? (int)j : meshIndex;
+			}
+
+			MeshRenderer* meshRenderer = gameObject->GetComponent<MeshRenderer>();
+			bool hasMaterial = meshRenderer && meshRenderer->HasMaterial();
+
+			writer.WriteInt(parents[i]);
+			writer.WriteSTR(gameObject->GetName());
+			writer.WriteVector3(transform->GetPositionLocal());
+			writer.WriteQuaternion(transform->GetRotationLocal());
+			writer.WriteVector3(transform->GetScaleLocal());
+			writer.WriteInt(meshIndex);
+			writer.WriteSTR(hasMaterial ? meshRenderer->GetMaterial()._Get()->GetResourceFilePath() : DATA_NOT_ASSIGNED);
+		}
+
+		// The model first, the hierarchy completes the entry
+		DerivedDataCache* derivedData = m_resourceManager->GetDerivedDataCache();
+		string temporaryFilePath = derivedData->GetTemporaryFilePath(key, MODEL_EXTENSION);
+		if (!FileSystem::CopyFileFromTo(m_resourceFilePath, temporaryFilePath) || !derivedData->Commit(temporaryFilePath, key, MODEL_EXTENSION))
+			return;
+
+		derivedData->Save(key, DERIVED_HIERARCHY_EXTENSION, writer);
+	}
+
 	void Model::SetScale(float scale)
 	{
 		for (const auto& mesh : m_meshes)
@@ -311,7 +774,7 @@ namespace Directus
 
 			if (!m_boundingBox.Defined())
 			{
-				m_boundingBox.ComputeFromMesh(mesh);
+				m_boundingBox = mesh->GetBoundingBox();
 			}
 
 			m_boundingBox.Merge(mesh->GetBoundingBox());
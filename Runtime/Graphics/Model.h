@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ====================
 #include <memory>
 #include <vector>
+#include <cstdint>
 #include "../Resource/Resource.h"
 #include "../Math/Vector3.h"
 #include "../Math/BoundingBox.h"
@@ -51,6 +52,9 @@ namespace Directus
 		//= RESOURCE INTERFACE ================================
 		virtual bool LoadFromFile(const std::string& filePath);
 		virtual bool SaveToFile(const std::string& filePath);
+		virtual bool DecodeFromFile(const std::string& filePath);
+		virtual bool FinalizeLoad();
+		virtual unsigned long long GetMemoryUsageCPU();
 		//======================================================
 
 		// Sets the  GameObject that represents this model in the scene
@@ -76,8 +80,18 @@ namespace Directus
 	private:
 		// Load the model from disk
 		bool LoadFromEngineFormat(const std::string& filePath);
+		bool LoadFromLegacyEngineFormat(const std::string& filePath);
 		bool LoadFromForeignFormat(const std::string& filePath);
 
+		// True while every mesh still points into the storage it was loaded from
+		bool IsGeometryMapped();
+		// Takes the geometry out of the storage, main thread only as other threads may be reading it
+		void DetachMappedGeometry();
+
+		// What an import derived (the model plus its GameObject hierarchy), see DerivedDataCache
+		bool LoadFromDerivedData(uint64_t key);
+		void SaveDerivedData(uint64_t key);
+
 		//= SCALING / DIMENSIONS =======================
 		void SetScale(float scale);
 		float ComputeNormalizeScale();
@@ -91,6 +105,16 @@ namespace Directus
 		// The meshes that make up this model
 		std::vector<std::shared_ptr<Mesh>> m_meshes;
 
+		// What holds the geometry of the meshes, when they were loaded from an engine model file
+		std::shared_ptr<const void> m_mappedStorage;
+		// The file that storage is a mapping of (a compressed file is decompressed into memory instead)
+		std::string m_mappedFilePath;
+		// The file which holds this model as it is, while its meshes are unmodified
+		std::string m_savedFilePath;
+
+		// A foreign model builds GameObjects as it loads, so it waits for FinalizeLoad()
+		std::string m_foreignFilePath;
+
 		// The materials used by this model (materials also hold textures)
 		std::vector<std::weak_ptr<Material>> m_materials;
 
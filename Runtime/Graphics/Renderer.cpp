@@ -42,7 +42,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Core/GameObject.h"
 #include "../Core/Context.h"
 #include "../Core/Stopwatch.h"
+#include "../Core/Scheduler.h"
 #include "../Resource/ResourceManager.h"
+#include "../Threading/Threading.h"
+#include "../Profiling/Profiler.h"
 #include "Material.h"
 //======================================
 
@@ -65,10 +68,16 @@ namespace Directus
 		m_farPlane = 0.0f;
 		m_resourceMng = nullptr;
 		m_graphics = nullptr;
+		m_threading = nullptr;
+		m_renderables = nullptr;
+		m_lights = nullptr;
+		m_directionalLight = nullptr;
 		m_renderOutput = Render_Default;
 
-		// Subscribe to render event
-		SUBSCRIBE_TO_EVENT(EVENT_RENDER, this, Renderer::Render);
+		// Talks to the device, so it stays on the main thread
+		m_context->GetSubsystem<Scheduler>()->AddJob("Renderer", Stage_Render,
+			Frame_Transforms | Frame_RenderLists | Frame_SceneGraph | Frame_Physics, Frame_GPU, true,
+			bind(&Renderer::Render, this));
 	}
 
 	Renderer::~Renderer()
@@ -89,6 +98,14 @@ namespace Directus
 		// Get ResourceManager subsystem
 		m_resourceMng = m_context->GetSubsystem<ResourceManager>();
 
+		// Get Threading subsystem
+		m_threading = m_context->GetSubsystem<Threading>();
+
+		// The scene keeps these up to date, they are read in place every frame
+		Scene* scene = m_context->GetSubsystem<Scene>();
+		m_renderables = &scene->GetRenderables();
+		m_lights = &scene->GetLights();
+
 		// Create G-Buffer
 		m_GBuffer = make_shared<GBuffer>(m_graphics);
 		m_GBuffer->Create(RESOLUTION_WIDTH, RESOLUTION_HEIGHT);
@@ -139,6 +156,8 @@ namespace Directus
 
 	void Renderer::Render()
 	{
+		PROFILE_FUNCTION();
+
 		if (!m_graphics)
 			return;
 
@@ -157,7 +176,7 @@ namespace Directus
 		}
 
 		// If there is nothing to render clear to camera's color and present
-		if (m_renderables.empty())
+		if (m_renderables->empty())
 		{
 			m_graphics->Clear(m_camera->GetClearColor());
 			m_graphics->Present();
@@ -228,23 +247,18 @@ namespace Directus
 
 	void Renderer::Clear()
 	{
-		m_renderables.clear();
-		m_renderables.shrink_to_fit();
-
-		m_lights.clear();
-		m_lights.shrink_to_fit();
 		m_directionalLight = nullptr;
 	}
 
 	void Renderer::AcquirePrerequisites()
 	{
+		PROFILE_FUNCTION();
+
 		Clear();
 		Scene* scene = m_context->GetSubsystem<Scene>();
-		m_renderables = scene->GetRenderables();
-		m_lights = scene->GetLights();
 
 		// Get directional light
-		for (const auto& light : m_lights)
+		for (const auto& light : *m_lights)
 		{
 			if (light->GetLightType() == Directional)
 			{
@@ -284,6 +298,8 @@ namespace Directus
 
 	void Renderer::DirectionalLightDepthPass()
 	{
+		PROFILE_FUNCTION();
+
 		if (!m_directionalLight)
 			return;
 
@@ -292,6 +308,40 @@ namespace Directus
 
 		m_shaderDepth->Set();
 
+		// Find the shadow casters once, rather than once per cascade
+		const auto& renderables = *m_renderables;
+		m_renderablesCastShadows.resize(renderables.size());
+		m_threading->ParallelFor(0, renderables.size(), 128, [this, &renderables](size_t i)
+		{
+			m_renderablesCastShadows[i] = false;
+
+			const auto& gameObject = renderables[i];
+			if (gameObject.expired())
+				return;
+
+			auto meshRenderer = gameObject._Get()->GetComponent<MeshRenderer>();
+			auto meshFilter = gameObject._Get()->GetComponent<MeshFilter>();
+			if (!meshFilter || !meshRenderer)
+				return;
+
+			auto material = meshRenderer->GetMaterial();
+			auto mesh = meshFilter->GetMesh();
+
+			// Make sure we have everything
+			if (mesh.expired() || material.expired())
+				return;
+
+			// Skip meshes that don't cast shadows
+			if (!meshRenderer->GetCastShadows())
+				return;
+
+			// Skip transparent meshes (for now)
+			if (material._Get()->GetOpacity() < 1.0f)
+				return;
+
+			m_renderablesCastShadows[i] = true;
+		});
+
 		for (int cascadeIndex = 0; cascadeIndex < m_directionalLight->GetShadowCascadeCount(); cascadeIndex++)
 		{
 			// Set appropriate shadow map as render target
@@ -301,28 +351,15 @@ namespace Directus
 			Matrix mProjectionLight = m_directionalLight->ComputeOrthographicProjectionMatrix(cascadeIndex);
 			Matrix mViewProjectionLight = mViewLight * mProjectionLight;
 
-			for (const auto& gameObject : m_renderables)
+			for (size_t i = 0; i < renderables.size(); i++)
 			{
-				if (gameObject.expired())
+				if (!m_renderablesCastShadows[i])
 					continue;
 
-				auto meshRenderer = gameObject._Get()->GetComponent<MeshRenderer>();
-				auto material = meshRenderer->GetMaterial();
-				auto meshFilter = gameObject._Get()->GetComponent<MeshFilter>();
+				const auto& gameObject = renderables[i];
+				auto meshFilter = gameObject._Get()->GetMeshFilter();
 				auto mesh = meshFilter->GetMesh();
 
-				// Make sure we have everything
-				if (mesh.expired() || !meshFilter || !meshRenderer || material.expired())
-					continue;
-
-				// Skip meshes that don't cast shadows
-				if (!meshRenderer->GetCastShadows())
-					continue;
-
-				// Skip transparent meshes (for now)
-				if (material._Get()->GetOpacity() < 1.0f)
-					continue;
-
 				if (meshFilter->SetBuffers())
 				{
 					// Set shader's buffer
@@ -340,6 +377,8 @@ namespace Directus
 
 	void Renderer::GBufferPass()
 	{
+		PROFILE_FUNCTION();
+
 		if (!m_graphics)
 			return;
 
@@ -347,35 +386,45 @@ namespace Directus
 		m_graphics->ResetViewport();
 		m_GBuffer->Clear();
 
-		vector<weak_ptr<Material>> materials = m_resourceMng->GetResourcesByType<Material>();
-		vector<weak_ptr<ShaderVariation>> shaders = m_resourceMng->GetResourcesByType<ShaderVariation>();
+		auto materials = m_resourceMng->GetResourcesByType<Material>();
+		auto shaders = m_resourceMng->GetResourcesByType<ShaderVariation>();
+
+		// Frustum culling, done once for all the renderables instead of once per material
+		const auto& renderables = *m_renderables;
+		m_renderablesVisible.resize(renderables.size());
+		m_threading->ParallelFor(0, renderables.size(), 128, [this, &renderables](size_t i)
+		{
+			const auto& gameObj = renderables[i];
+			MeshFilter* meshFilter = !gameObj.expired() ? gameObj._Get()->GetMeshFilter() : nullptr;
+			m_renderablesVisible[i] = meshFilter && m_camera->IsInViewFrustrum(meshFilter);
+		});
 
 		for (const auto& shader : shaders) // SHADER ITERATION
 		{
 			// Set the shader
-			shader._Get()->Set();
+			shader->Set();
 
 			// UPDATE PER FRAME BUFFER
-			shader._Get()->UpdatePerFrameBuffer(m_directionalLight, m_camera);
+			shader->UpdatePerFrameBuffer(m_directionalLight, m_camera);
 
 			for (const auto& material : materials) // MATERIAL ITERATION
 			{
 				// Continue only if the material at hand happens to use the already set shader
-				if (material._Get()->GetShader()._Get()->GetResourceID() != shader._Get()->GetResourceID())
+				if (material->GetShader()._Get()->GetResourceID() != shader->GetResourceID())
 					continue;
 
 				// UPDATE PER MATERIAL BUFFER
-				shader._Get()->UpdatePerMaterialBuffer(material);
+				shader->UpdatePerMaterialBuffer(material);
 
 				// Order the textures they way the shader expects them
-				m_textures.push_back((ID3D11ShaderResourceView*)material._Get()->GetShaderResource(Albedo_Texture));
-				m_textures.push_back((ID3D11ShaderResourceView*)material._Get()->GetShaderResource(Roughness_Texture));
-				m_textures.push_back((ID3D11ShaderResourceView*)material._Get()->GetShaderResource(Metallic_Texture));
-				m_textures.push_back((ID3D11ShaderResourceView*)material._Get()->GetShaderResource(Normal_Texture));
-				m_textures.push_back((ID3D11ShaderResourceView*)material._Get()->GetShaderResource(Height_Texture));
-				m_textures.push_back((ID3D11ShaderResourceView*)material._Get()->GetShaderResource(Occlusion_Texture));
-				m_textures.push_back((ID3D11ShaderResourceView*)material._Get()->GetShaderResource(Emission_Texture));
-				m_textures.push_back((ID3D11ShaderResourceView*)material._Get()->GetShaderResource(Mask_Texture));
+				m_textures.push_back((ID3D11ShaderResourceView*)material->GetShaderResource(Albedo_Texture));
+				m_textures.push_back((ID3D11ShaderResourceView*)material->GetShaderResource(Roughness_Texture));
+				m_textures.push_back((ID3D11ShaderResourceView*)material->GetShaderResource(Metallic_Texture));
+				m_textures.push_back((ID3D11ShaderResourceView*)material->GetShaderResource(Normal_Texture));
+				m_textures.push_back((ID3D11ShaderResourceView*)material->GetShaderResource(Height_Texture));
+				m_textures.push_back((ID3D11ShaderResourceView*)material->GetShaderResource(Occlusion_Texture));
+				m_textures.push_back((ID3D11ShaderResourceView*)material->GetShaderResource(Emission_Texture));
+				m_textures.push_back((ID3D11ShaderResourceView*)material->GetShaderResource(Mask_Texture));
 
 				if (m_directionalLight)
 				{
@@ -393,14 +442,17 @@ namespace Directus
 				}
 
 				// UPDATE TEXTURE BUFFER
-				shader._Get()->UpdateTextures(m_textures);
+				shader->UpdateTextures(m_textures);
 				//==================================================================================
 
-				for (const auto& gameObj : m_renderables) // GAMEOBJECT/MESH ITERATION
+				for (size_t i = 0; i < renderables.size(); i++) // GAMEOBJECT/MESH ITERATION
 				{
-					if (gameObj.expired())
+					// skip objects outside of the view frustrum
+					if (!m_renderablesVisible[i])
 						continue;
 
+					const auto& gameObj = renderables[i];
+
 					//= Get all that we need =========================================
 					MeshFilter* meshFilter = gameObj._Get()->GetMeshFilter();
 					MeshRenderer* meshRenderer = gameObj._Get()->GetMeshRenderer();
@@ -414,19 +466,15 @@ namespace Directus
 						continue;
 
 					// skip objects that use a different material
-					if (material._Get()->GetResourceID() != objMaterial->GetResourceID())
+					if (material->GetResourceID() != objMaterial->GetResourceID())
 						continue;
 
 					// skip transparent objects (for now)
 					if (objMaterial->GetOpacity() < 1.0f)
 						continue;
 
-					// skip objects outside of the view frustrum
-					if (!m_camera->IsInViewFrustrum(meshFilter))
-						continue;
-
 					// UPDATE PER OBJECT BUFFER
-					shader._Get()->UpdatePerObjectBuffer(mWorld, mView, mProjection, meshRenderer->GetReceiveShadows());
+					shader->UpdatePerObjectBuffer(mWorld, mView, mProjection, meshRenderer->GetReceiveShadows());
 
 					// Set mesh buffer
 					if (meshFilter->HasMesh())
@@ -453,6 +501,8 @@ namespace Directus
 	//= HELPER FUNCTIONS ==============================================================================================
 	void Renderer::DeferredPass()
 	{
+		PROFILE_FUNCTION();
+
 		m_fullScreenQuad->SetBuffers();
 		m_graphics->SetCullMode(CullBack);
 
@@ -488,7 +538,7 @@ namespace Directus
 
 		// Update buffers
 		m_shaderDeferred->UpdateMatrixBuffer(Matrix::Identity, mView, mBaseView, mProjection, mOrthographicProjection);
-		m_shaderDeferred->UpdateMiscBuffer(m_lights, m_camera);
+		m_shaderDeferred->UpdateMiscBuffer(*m_lights, m_camera);
 
 		//= Update textures ===========================================================
 		m_texArray.clear();
@@ -509,6 +559,8 @@ namespace Directus
 
 	void Renderer::PostProcessing()
 	{
+		PROFILE_FUNCTION();
+
 		m_graphics->SetCullMode(CullBack);
 
 		if (m_renderOutput != Render_Default)
@@ -575,6 +627,8 @@ namespace Directus
 
 	void Renderer::DebugDraw()
 	{
+		PROFILE_FUNCTION();
+
 		if (!DEBUG_DRAW)
 			return;
 
@@ -594,7 +648,7 @@ namespace Directus
 		m_lineRenderer->AddLines(m_camera->GetPickingRay());
 
 		// Pass bounding spheres
-		for (const auto& gameObject : m_renderables) 
+		for (const auto& gameObject : *m_renderables) 
 		{
 			auto meshFilter = gameObject._Get()->GetComponent<MeshFilter>();
 			m_lineRenderer->AddBoundigBox(meshFilter->GetBoundingBoxTransformed(), Vector4(0.41f, 0.86f, 1.0f, 1.0f));
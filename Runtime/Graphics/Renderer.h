@@ -52,6 +52,7 @@ namespace Directus
 	class ResourceManager;
 	class D3D11RenderTexture;
 	class D3D11GraphicsDevice;
+	class Threading;
 
 	namespace Math
 	{
@@ -87,7 +88,7 @@ namespace Directus
 		void SetViewport(float width, float height);
 
 		void Clear();
-		const std::vector<weakGameObj>& GetRenderables() { return m_renderables; }
+		const std::vector<weakGameObj>& GetRenderables() { return *m_renderables; }
 
 		//= STATS =======================================================
 		void StartCalculatingStats();
@@ -111,8 +112,11 @@ namespace Directus
 		std::shared_ptr<GBuffer> m_GBuffer;
 
 		// GAMEOBJECTS ========================
-		std::vector<weakGameObj> m_renderables;
-		std::vector<Light*> m_lights;
+		// Owned by the scene
+		const std::vector<weakGameObj>* m_renderables;
+		std::vector<char> m_renderablesVisible; // filled in parallel, hence not vector<bool>
+		std::vector<char> m_renderablesCastShadows;
+		const std::vector<Light*>* m_lights;
 		Light* m_directionalLight;
 		//=====================================
 
@@ -157,6 +161,7 @@ namespace Directus
 		std::vector<ID3D11ShaderResourceView*> m_textures;
 		Graphics* m_graphics;
 		ResourceManager* m_resourceMng;
+		Threading* m_threading;
 		RenderOutput m_renderOutput;
 		//================================================
 	};
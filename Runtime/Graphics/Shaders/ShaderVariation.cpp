@@ -24,7 +24,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Core/GUIDGenerator.h"
 #include "../../Logging/Log.h"
 #include "../../Core/Settings.h"
-#include "../../IO/StreamIO.h"
+#include "../../IO/BinaryWriter.h"
+#include "../../IO/BinaryReader.h"
 //===================================
 
 //= NAMESPACES ================
@@ -95,25 +96,24 @@ namespace Directus
 
 	bool ShaderVariation::LoadFromFile(const string& filePath)
 	{
-		if (!StreamIO::StartReading(filePath))
+		BinaryReader reader;
+		if (!reader.LoadFromFile(filePath))
 			return false;
 
-		m_resourceID = StreamIO::ReadSTR();
-		m_resourceName = StreamIO::ReadSTR();
-		m_resourceFilePath = StreamIO::ReadSTR();
-		m_hasAlbedoTexture = StreamIO::ReadBool();
-		m_hasRoughnessTexture = StreamIO::ReadBool();
-		m_hasMetallicTexture = StreamIO::ReadBool();
-		m_hasNormalTexture = StreamIO::ReadBool();
-		m_hasHeightTexture = StreamIO::ReadBool();
-		m_hasOcclusionTexture = StreamIO::ReadBool();
-		m_hasEmissionTexture = StreamIO::ReadBool();
-		m_hasMaskTexture = StreamIO::ReadBool();
-		m_hasCubeMap = StreamIO::ReadBool();
-
-		StreamIO::StopReading();
-
-		return true;
+		m_resourceID = reader.ReadSTR();
+		m_resourceName = reader.ReadSTR();
+		m_resourceFilePath = reader.ReadSTR();
+		m_hasAlbedoTexture = reader.ReadBool();
+		m_hasRoughnessTexture = reader.ReadBool();
+		m_hasMetallicTexture = reader.ReadBool();
+		m_hasNormalTexture = reader.ReadBool();
+		m_hasHeightTexture = reader.ReadBool();
+		m_hasOcclusionTexture = reader.ReadBool();
+		m_hasEmissionTexture = reader.ReadBool();
+		m_hasMaskTexture = reader.ReadBool();
+		m_hasCubeMap = reader.ReadBool();
+
+		return reader.IsValid();
 	}
 
 	bool ShaderVariation::SaveToFile(const string& filePath)
@@ -131,25 +131,21 @@ namespace Directus
 			savePath += SHADER_EXTENSION;
 		}
 
-		if (!StreamIO::StartWriting(savePath))
-			return false;
-
-		StreamIO::WriteSTR(m_resourceID);
-		StreamIO::WriteSTR(m_resourceName);
-		StreamIO::WriteSTR(m_resourceFilePath);
-		StreamIO::WriteBool(m_hasAlbedoTexture);
-		StreamIO::WriteBool(m_hasRoughnessTexture);
-		StreamIO::WriteBool(m_hasMetallicTexture);
-		StreamIO::WriteBool(m_hasNormalTexture);
-		StreamIO::WriteBool(m_hasHeightTexture);
-		StreamIO::WriteBool(m_hasOcclusionTexture);
-		StreamIO::WriteBool(m_hasEmissionTexture);
-		StreamIO::WriteBool(m_hasMaskTexture);
-		StreamIO::WriteBool(m_hasCubeMap);
-	
-		StreamIO::StopWriting();
-
-		return true;
+		BinaryWriter writer;
+		writer.WriteSTR(m_resourceID);
+		writer.WriteSTR(m_resourceName);
+		writer.WriteSTR(m_resourceFilePath);
+		writer.WriteBool(m_hasAlbedoTexture);
+		writer.WriteBool(m_hasRoughnessTexture);
+		writer.WriteBool(m_hasMetallicTexture);
+		writer.WriteBool(m_hasNormalTexture);
+		writer.WriteBool(m_hasHeightTexture);
+		writer.WriteBool(m_hasOcclusionTexture);
+		writer.WriteBool(m_hasEmissionTexture);
+		writer.WriteBool(m_hasMaskTexture);
+		writer.WriteBool(m_hasCubeMap);
+
+		return writer.SaveToFile(savePath);
 	}
 
 	void ShaderVariation::Set()
@@ -35,6 +35,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Resource/ResourceManager.h"
 #include "D3D11/D3D11Texture.h"
 #include "../IO/XmlDocument.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/BinaryReader.h"
 //================================================
 
 //= NAMESPACES =====
@@ -43,6 +45,68 @@ using namespace std;
 
 namespace Directus
 {
+	//= DERIVED DATA =============================================================================
+	static const char* DERIVED_IMAGE_EXTENSION = ".image";
+
+	static void WritePixels(BinaryWriter& writer, const vector<unsigned char>& pixels)
+	{
+		writer.WriteUINT((unsigned int)pixels.size());
+		writer.WriteArray(pixels.data(), pixels.size());
+	}
+
+	static bool ReadPixels(BinaryReader& reader, vector<unsigned char>& pixels)
+	{
+		// Never trust a size beyond what's left to read
+		size_t size = reader.ReadUINT();
+		if (!reader.IsValid() || size > reader.GetSize() - reader.GetPosition())
+			return false;
+
+		pixels.resize(size);
+		return reader.ReadArray(pixels.data(), size);
+	}
+
+	static void WriteImage(BinaryWriter& writer, const ImageData& image)
+	{
+		writer.WriteUINT(image.width);
+		writer.WriteUINT(image.height);
+		writer.WriteUINT(image.bpp);
+		writer.WriteInt(image.channels);
+		writer.WriteBool(image.grayscale);
+		writer.WriteBool(image.transparent);
+		WritePixels(writer, image.dataRGBA);
+		writer.WriteUINT((unsigned int)image.mipchainDataRGBA.size());
+		for (const auto& mip : image.mipchainDataRGBA)
+		{
+			WritePixels(writer, mip);
+		}
+	}
+
+	static bool ReadImage(BinaryReader& reader, ImageData& image)
+	{
+		image.width = reader.ReadUINT();
+		image.height = reader.ReadUINT();
+		image.bpp = reader.ReadUINT();
+		image.channels = reader.ReadInt();
+		image.grayscale = reader.ReadBool();
+		image.transparent = reader.ReadBool();
+		if (!ReadPixels(reader, image.dataRGBA))
+			return false;
+
+		unsigned int mipCount = reader.ReadUINT();
+		if (!reader.IsValid() || mipCount > 32)
+			return false;
+
+		image.mipchainDataRGBA.resize(mipCount);
+		for (auto& mip : image.mipchainDataRGBA)
+		{
+			if (!ReadPixels(reader, mip))
+				return false;
+		}
+
+		return reader.IsValid();
+	}
+	//============================================================================================
+
 	Texture::Texture(Context* context)
 	{
 		//= RESOURCE INTERFACE ===========
@@ -100,42 +164,74 @@ namespace Directus
 
 	bool Texture::LoadFromFile(const string& filePath)
 	{
-		bool engineFormat = FileSystem::GetExtensionFromFilePath(filePath) == METADATA_EXTENSION;
-		return engineFormat ? LoadMetadata(filePath) : LoadFromForeignFormat(filePath);	
+		return DecodeFromFile(filePath) && FinalizeLoad();
 	}
-	//==============================================================================================
 
-	void Texture::SetTextureType(TextureType type)
+	bool Texture::DecodeFromFile(const string& filePath)
 	{
-		m_textureType = type;
+		if (FileSystem::GetExtensionFromFilePath(filePath) == METADATA_EXTENSION)
+			return LoadMetadata(filePath);
 
-		// Some models (or Assimp) pass a normal map as a height map
-		// and others pass a height map as a normal map, we try to fix that.
-		if (m_textureType == Height_Texture && !GetGrayscale())
+		// DDS is loaded straight into a texture by the graphics device (too bored to implement dds cubemap support in the ImageImporter)
+		if (FileSystem::GetExtensionFromFilePath(filePath) == ".dds")
 		{
-			m_textureType = Normal_Texture;
+			m_decodedDDS = filePath;
+			return true;
 		}
 
-		if (m_textureType == Normal_Texture && GetGrayscale())
+		// Decoded into an image of its own, any number of textures can decode at the same time
+		auto image = make_unique<ImageData>();
+		auto resourceManager = m_context->GetSubsystem<ResourceManager>();
+		DerivedDataCache* derivedData = resourceManager->GetDerivedDataCache();
+		uint64_t key = 0;
+		bool keyed = derivedData && derivedData->MakeKey(filePath, m_generateMipchain ? 1 : 0, ImageImporter::VERSION, key);
+
+		// An unchanged image is served as it was decoded (mip chain included) the last time
+		BinaryReader reader;
+		if (keyed && derivedData->Load(key, DERIVED_IMAGE_EXTENSION, reader) && ReadImage(reader, *image))
 		{
-			m_textureType = Height_Texture;
+			image->path = filePath;
 		}
-	}
+		else
+		{
+			*image = ImageData();
+			if (!resourceManager->GetImageImporter()._Get()->Load(filePath, m_generateMipchain, *image))
+			{
+				LOG_WARNING("Failed to load texture \"" + filePath + "\".");
+				return false;
+			}
 
-	void** Texture::GetShaderResource()
-	{
-		return (void**)m_texture->GetShaderResourceView();
+			if (keyed)
+			{
+				BinaryWriter writer;
+				WriteImage(writer, *image);
+				derivedData->Save(key, DERIVED_IMAGE_EXTENSION, writer);
+			}
+		}
+
+		// Extract any metadata we can from the image
+		m_resourceFilePath = image->path;
+		m_resourceName = FileSystem::GetFileNameNoExtensionFromFilePath(GetFilePathTexture());
+		m_width = image->width;
+		m_height = image->height;
+		m_grayscale = image->grayscale;
+		m_transparency = image->transparent;
+		m_decoded = move(image);
+
+		return true;
 	}
 
-	bool Texture::LoadFromForeignFormat(const string& filePath)
+	bool Texture::FinalizeLoad()
 	{
-		auto graphicsDevice = m_context->GetSubsystem<Graphics>()->GetDevice();
-		if (!graphicsDevice)
-			return false;
-
-		// Load DDS (too bored to implement dds cubemap support in the ImageImporter)
-		if (FileSystem::GetExtensionFromFilePath(filePath) == ".dds")
+		if (!m_decodedDDS.empty())
 		{
+			string filePath;
+			filePath.swap(m_decodedDDS);
+
+			auto graphicsDevice = m_context->GetSubsystem<Graphics>()->GetDevice();
+			if (!graphicsDevice)
+				return false;
+
 			ID3D11ShaderResourceView* ddsTex = nullptr;
 			wstring widestr = wstring(filePath.begin(), filePath.end());
 			HRESULT hr = DirectX::CreateDDSTextureFromFile(graphicsDevice, widestr.c_str(), nullptr, &ddsTex);
@@ -149,36 +245,61 @@ namespace Directus
 			return true;
 		}
 
-		// Load texture
-		auto imageImp = m_context->GetSubsystem<ResourceManager>()->GetImageImporter();
-		bool loaded = m_generateMipchain ? imageImp._Get()->Load(filePath, true) : imageImp._Get()->Load(filePath);
-		if (!loaded)
-		{
-			LOG_WARNING("Failed to load texture \"" + filePath + "\".");
-			imageImp._Get()->Clear();
-			return false;
-		}
-
-		// Extract any metadata we can from the ImageImporter
-		m_resourceFilePath = imageImp._Get()->GetPath();
-		m_resourceName = FileSystem::GetFileNameNoExtensionFromFilePath(GetFilePathTexture());
-		m_width = imageImp._Get()->GetWidth();
-		m_height = imageImp._Get()->GetHeight();
-		m_grayscale = imageImp._Get()->IsGrayscale();
-		m_transparency = imageImp._Get()->IsTransparent();
+		// Loaded from metadata
+		if (!m_decoded)
+			return true;
 
-		if (!CreateShaderResource())
+		// The decoded image is freed either way
+		unique_ptr<ImageData> image = move(m_decoded);
+		if (!CreateShaderResource(*image))
 			return false;
 
-		// Free any memory allocated by the ImageImporter
-		imageImp._Get()->Clear();
-
 		if (!SaveToFile(m_resourceFilePath + METADATA_EXTENSION)) // Create a metadata file
 			return false;
 
 		return true;
 	}
 
+	bool Texture::LoadFromImage(const ImageData& image)
+	{
+		m_width = image.width;
+		m_height = image.height;
+		m_grayscale = image.grayscale;
+		m_transparency = image.transparent;
+
+		return CreateShaderResource(image);
+	}
+
+	unsigned long long Texture::GetMemoryUsageGPU()
+	{
+		// RGBA8, a full mip chain adds a third
+		unsigned long long size = (unsigned long long)m_width * m_height * 4;
+		return m_generateMipchain ? size * 4 / 3 : size;
+	}
+	//==============================================================================================
+
+	void Texture::SetTextureType(TextureType type)
+	{
+		m_textureType = type;
+
+		// Some models (or Assimp) pass a normal map as a height map
+		// and others pass a height map as a normal map, we try to fix that.
+		if (m_textureType == Height_Texture && !GetGrayscale())
+		{
+			m_textureType = Normal_Texture;
+		}
+
+		if (m_textureType == Normal_Texture && GetGrayscale())
+		{
+			m_textureType = Height_Texture;
+		}
+	}
+
+	void** Texture::GetShaderResource()
+	{
+		return (void**)m_texture->GetShaderResourceView();
+	}
+
 	bool Texture::LoadMetadata(const string& filePath)
 	{
 		if (!XmlDocument::Load(filePath))
@@ -199,25 +320,25 @@ namespace Directus
 		return true;
 	}
 
-	bool Texture::CreateShaderResource()
+	bool Texture::CreateShaderResource(const ImageData& image)
 	{
 		if (!m_context)
 			return false;
 
-		auto imageImp = m_context->GetSubsystem<ResourceManager>()->GetImageImporter();
-		if (m_generateMipchain)
+		// An image decoded without a mip chain (e.g. a placeholder) gets a single level
+		if (m_generateMipchain && !image.mipchainDataRGBA.empty())
 		{
-			if (!m_texture->CreateFromMipchain(m_width, m_height, imageImp._Get()->GetChannels(), imageImp._Get()->GetRGBAMipChain()))
+			if (!m_texture->CreateFromMipchain(m_width, m_height, image.channels, image.mipchainDataRGBA))
 			{
-				LOG_ERROR("Failed to create texture from loaded image \"" + imageImp._Get()->GetPath() + "\".");
+				LOG_ERROR("Failed to create texture from loaded image \"" + image.path + "\".");
 				return false;
 			}
 		}
 		else
 		{
-			if (!m_texture->Create(m_width, m_height, imageImp._Get()->GetChannels(), imageImp._Get()->GetRGBA()))
+			if (!m_texture->Create(m_width, m_height, image.channels, (unsigned char*)image.dataRGBA.data()))
 			{
-				LOG_ERROR("Failed to create texture from loaded image \"" + imageImp._Get()->GetPath() + "\".");
+				LOG_ERROR("Failed to create texture from loaded image \"" + image.path + "\".");
 				return false;
 			}
 		}
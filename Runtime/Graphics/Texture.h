@@ -30,6 +30,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace Directus
 {
 	class D3D11Texture;
+	struct ImageData;
 
 	enum TextureType
 	{
@@ -53,8 +54,14 @@ namespace Directus
 		//= RESOURCE INTERFACE ========================
 		bool SaveToFile(const std::string& filePath);
 		bool LoadFromFile(const std::string& filePath);
+		bool DecodeFromFile(const std::string& filePath);
+		bool FinalizeLoad();
+		unsigned long long GetMemoryUsageGPU();
 		//=============================================
 
+		// Creates the texture from an image in memory (main thread only)
+		bool LoadFromImage(const ImageData& image);
+
 		//= PROPERTIES ===============================================================================
 		std::string GetFilePathTexture() { return m_resourceFilePath; }
 		void SetFilePathTexture(const std::string& filepath) { m_resourceFilePath = filepath; }
@@ -78,9 +85,8 @@ namespace Directus
 		//=============================================================================================
 
 	private:
-		bool LoadFromForeignFormat(const std::string& filePath);
 		bool LoadMetadata(const std::string& filePath);
-		bool CreateShaderResource();
+		bool CreateShaderResource(const ImageData& image);
 
 		int m_width;
 		int m_height;
@@ -90,5 +96,9 @@ namespace Directus
 		bool m_alphaIsTransparency;
 		bool m_generateMipchain;
 		std::unique_ptr<D3D11Texture> m_texture;
+
+		// Decoded and waiting for FinalizeLoad()
+		std::unique_ptr<ImageData> m_decoded;
+		std::string m_decodedDDS;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,197 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "BinaryReader.h"
+#include <fstream>
+#include "BlockCompression.h"
+#include "../Logging/Log.h"
+#include "../Math/Vector2.h"
+#include "../Math/Vector3.h"
+#include "../Math/Vector4.h"
+#include "../Math/Quaternion.h"
+//=============================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Directus::Math;
+//=============================
+
+namespace Directus
+{
+	BinaryReader::BinaryReader()
+	{
+		m_data = nullptr;
+		m_size = 0;
+		m_position = 0;
+		m_failed = false;
+	}
+
+	BinaryReader::BinaryReader(const char* data, size_t size)
+	{
+		m_data = data;
+		m_size = data ? size : 0;
+		m_position = 0;
+		m_failed = false;
+	}
+
+	BinaryReader::~BinaryReader()
+	{
+
+	}
+
+	bool BinaryReader::LoadFromFile(const string& filePath, Threading* threading)
+	{
+		m_buffer.clear();
+		m_data = nullptr;
+		m_size = 0;
+		m_position = 0;
+		m_failed = true;
+
+		ifstream in(filePath, ios::in | ios::binary | ios::ate);
+		if (in.fail())
+		{
+			LOG_ERROR("BinaryReader: Failed to open \"" + filePath + "\" for reading.");
+			return false;
+		}
+
+		streamoff size = in.tellg();
+		if (size < 0)
+		{
+			LOG_ERROR("BinaryReader: Failed to get the size of \"" + filePath + "\".");
+			return false;
+		}
+
+		m_buffer.resize((size_t)size);
+		in.seekg(0, ios::beg);
+		if (size > 0 && !in.read(m_buffer.data(), size))
+		{
+			LOG_ERROR("BinaryReader: Failed to read \"" + filePath + "\".");
+			m_buffer.clear();
+			return false;
+		}
+
+		if (BlockCompression::IsCompressed(m_buffer.data(), m_buffer.size()))
+		{
+			vector<char> decompressed;
+			if (!BlockCompression::Decompress(m_buffer.data(), m_buffer.size(), decompressed, threading))
+			{
+				LOG_ERROR("BinaryReader: Failed to decompress \"" + filePath + "\".");
+				m_buffer.clear();
+				return false;
+			}
+			m_buffer.swap(decompressed);
+		}
+
+		m_data = m_buffer.data();
+		m_size = m_buffer.size();
+		m_failed = false;
+
+		return true;
+	}
+
+	bool BinaryReader::LoadFromMemory(const char* data, size_t size, Threading* threading)
+	{
+		m_buffer.clear();
+		m_data = data;
+		m_size = data ? size : 0;
+		m_position = 0;
+		m_failed = false;
+
+		if (!BlockCompression::IsCompressed(data, size))
+			return true;
+
+		if (!BlockCompression::Decompress(data, size, m_buffer, threading))
+		{
+			LOG_ERROR("BinaryReader: Failed to decompress the data.");
+			m_buffer.clear();
+			m_data = nullptr;
+			m_size = 0;
+			m_failed = true;
+			return false;
+		}
+
+		m_data = m_buffer.data();
+		m_size = m_buffer.size();
+
+		return true;
+	}
+
+	string BinaryReader::ReadSTR()
+	{
+		int size = ReadInt();
+		if (m_failed || size < 0 || (size_t)size > m_size - m_position)
+		{
+			m_failed = true;
+			return string();
+		}
+
+		string value(m_data + m_position, (size_t)size);
+		m_position += (size_t)size;
+
+		return value;
+	}
+
+	vector<string> BinaryReader::ReadVectorSTR()
+	{
+		vector<string> vector;
+
+		int count = ReadInt();
+		for (int i = 0; i < count && !m_failed; i++)
+		{
+			vector.push_back(ReadSTR());
+		}
+
+		return vector;
+	}
+
+	Vector2 BinaryReader::ReadVector2()
+	{
+		float values[2];
+		ReadBytes(values, sizeof(values));
+
+		return Vector2(values[0], values[1]);
+	}
+
+	Vector3 BinaryReader::ReadVector3()
+	{
+		float values[3];
+		ReadBytes(values, sizeof(values));
+
+		return Vector3(values[0], values[1], values[2]);
+	}
+
+	Vector4 BinaryReader::ReadVector4()
+	{
+		float values[4];
+		ReadBytes(values, sizeof(values));
+
+		return Vector4(values[0], values[1], values[2], values[3]);
+	}
+
+	Quaternion BinaryReader::ReadQuaternion()
+	{
+		float values[4];
+		ReadBytes(values, sizeof(values));
+
+		return Quaternion(values[0], values[1], values[2], values[3]);
+	}
+}
\ No newline at end of file
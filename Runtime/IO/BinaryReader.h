@@ -0,0 +1,122 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==============
+#include <cstring>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include "../Core/Helper.h"
+//=========================
+
+namespace Directus
+{
+	namespace Math
+	{
+		class Vector2;
+		class Vector3;
+		class Vector4;
+		class Quaternion;
+	}
+
+	class Threading;
+
+	// Deserializes from memory, either a file read with a single call or a buffer the caller
+	// keeps alive. Reading past the end fails the reader, from then on every read returns zeros.
+	// Block compressed files are decompressed on load, in parallel if threading is given.
+	class DLL_API BinaryReader
+	{
+	public:
+		BinaryReader();
+		BinaryReader(const char* data, size_t size);
+		~BinaryReader();
+		BinaryReader(const BinaryReader&) = delete;
+		BinaryReader& operator=(const BinaryReader&) = delete;
+
+		bool LoadFromFile(const std::string& filePath, Threading* threading = nullptr);
+		// Reads in place from a buffer the caller keeps alive, unless it's compressed
+		bool LoadFromMemory(const char* data, size_t size, Threading* threading = nullptr);
+
+		bool IsValid() const { return !m_failed; }
+		// For data which reads fine but can't be used, later reads fail like they would past the end
+		void Invalidate() { m_failed = true; }
+		const char* GetData() const { return m_data; }
+		size_t GetPosition() const { return m_position; }
+		size_t GetSize() const { return m_size; }
+
+		//= READING ======================================================================
+		bool ReadBool() { bool value = false; ReadBytes(&value, sizeof(value)); return value; }
+		int ReadInt() { int value = 0; ReadBytes(&value, sizeof(value)); return value; }
+		unsigned int ReadUINT() { unsigned int value = 0; ReadBytes(&value, sizeof(value)); return value; }
+		float ReadFloat() { float value = 0.0f; ReadBytes(&value, sizeof(value)); return value; }
+		std::string ReadSTR();
+		std::vector<std::string> ReadVectorSTR();
+		Math::Vector2 ReadVector2();
+		Math::Vector3 ReadVector3();
+		Math::Vector4 ReadVector4();
+		Math::Quaternion ReadQuaternion();
+
+		// Reads a span of plain data written with BinaryWriter::WriteArray()
+		template <typename T>
+		bool ReadArray(T* data, size_t count)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "ReadArray() copies the bytes, it only takes trivially copyable types");
+			return ReadBytes(data, sizeof(T) * count);
+		}
+
+		// Moves past data without reading it
+		bool Skip(size_t size)
+		{
+			if (m_failed || size > m_size - m_position)
+			{
+				m_failed = true;
+				return false;
+			}
+
+			m_position += size;
+			return true;
+		}
+
+		bool ReadBytes(void* data, size_t size)
+		{
+			if (m_failed || size > m_size - m_position)
+			{
+				m_failed = true;
+				memset(data, 0, size);
+				return false;
+			}
+
+			memcpy(data, m_data + m_position, size);
+			m_position += size;
+			return true;
+		}
+		//================================================================================
+
+	private:
+		std::vector<char> m_buffer; // only used when the reader owns the data
+		const char* m_data;
+		size_t m_size;
+		size_t m_position;
+		bool m_failed;
+	};
+}
\ No newline at end of file
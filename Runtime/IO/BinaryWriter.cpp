@@ -0,0 +1,150 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "BinaryWriter.h"
+#include <fstream>
+#include "BlockCompression.h"
+#include "../Logging/Log.h"
+#include "../Math/Vector2.h"
+#include "../Math/Vector3.h"
+#include "../Math/Vector4.h"
+#include "../Math/Quaternion.h"
+//=============================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Directus::Math;
+//=============================
+
+namespace Directus
+{
+	BinaryWriter::BinaryWriter()
+	{
+		m_size = 0;
+		m_capacity = 0;
+	}
+
+	BinaryWriter::~BinaryWriter()
+	{
+
+	}
+
+	bool BinaryWriter::SaveToFile(const string& filePath, bool compress, Threading* threading)
+	{
+		vector<char> compressed;
+		if (compress)
+		{
+			BlockCompression::Compress(m_data.get(), m_size, compressed, threading);
+		}
+		const char* data = compress ? compressed.data() : m_data.get();
+		size_t size = compress ? compressed.size() : m_size;
+
+		ofstream out(filePath, ios::out | ios::binary | ios::trunc);
+		if (out.fail())
+		{
+			LOG_ERROR("BinaryWriter: Failed to open \"" + filePath + "\" for writing.");
+			return false;
+		}
+
+		if (size != 0)
+		{
+			out.write(data, size);
+		}
+		out.close();
+
+		if (out.fail())
+		{
+			LOG_ERROR("BinaryWriter: Failed to write \"" + filePath + "\".");
+			return false;
+		}
+
+		return true;
+	}
+
+	void BinaryWriter::Reserve(size_t capacity)
+	{
+		if (capacity <= m_capacity)
+			return;
+
+		// Grow geometrically, so that appending stays cheap
+		size_t newCapacity = m_capacity < 4096 ? 4096 : m_capacity * 2;
+		newCapacity = newCapacity < capacity ? capacity : newCapacity;
+
+		unique_ptr<char[]> data(new char[newCapacity]);
+		if (m_size != 0)
+		{
+			memcpy(data.get(), m_data.get(), m_size);
+		}
+		m_data = move(data);
+		m_capacity = newCapacity;
+	}
+
+	void BinaryWriter::Align(size_t alignment)
+	{
+		size_t padding = (alignment - (m_size & (alignment - 1))) & (alignment - 1);
+		if (padding == 0)
+			return;
+
+		Reserve(m_size + padding);
+		memset(m_data.get() + m_size, 0, padding);
+		m_size += padding;
+	}
+
+	void BinaryWriter::WriteSTR(const string& value)
+	{
+		WriteInt((int)value.size());
+		WriteBytes(value.data(), value.size());
+	}
+
+	void BinaryWriter::WriteVectorSTR(const vector<string>& vector)
+	{
+		WriteInt((int)vector.size());
+		for (const auto& value : vector)
+		{
+			WriteSTR(value);
+		}
+	}
+
+	void BinaryWriter::WriteVector2(const Vector2& vector)
+	{
+		float values[2] = { vector.x, vector.y };
+		WriteBytes(values, sizeof(values));
+	}
+
+	void BinaryWriter::WriteVector3(const Vector3& vector)
+	{
+		float values[3] = { vector.x, vector.y, vector.z };
+		WriteBytes(values, sizeof(values));
+	}
+
+	void BinaryWriter::WriteVector4(const Vector4& vector)
+	{
+		float values[4] = { vector.x, vector.y, vector.z, vector.w };
+		WriteBytes(values, sizeof(values));
+	}
+
+	void BinaryWriter::WriteQuaternion(const Quaternion& quaternion)
+	{
+		float values[4] = { quaternion.x, quaternion.y, quaternion.z, quaternion.w };
+		WriteBytes(values, sizeof(values));
+	}
+}
\ No newline at end of file
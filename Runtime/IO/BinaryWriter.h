@@ -0,0 +1,103 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==============
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include "../Core/Helper.h"
+//=========================
+
+namespace Directus
+{
+	namespace Math
+	{
+		class Vector2;
+		class Vector3;
+		class Vector4;
+		class Quaternion;
+	}
+
+	// Serializes into a growable memory buffer, which reaches the disk with a single write.
+	// Every instance is independent, so any number of them can be in use at once.
+	class Threading;
+
+	class DLL_API BinaryWriter
+	{
+	public:
+		BinaryWriter();
+		~BinaryWriter();
+		BinaryWriter(const BinaryWriter&) = delete;
+		BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+		// Optionally block compressed (see BlockCompression), in parallel if threading is given
+		bool SaveToFile(const std::string& filePath, bool compress = false, Threading* threading = nullptr);
+
+		const char* GetData() const { return m_data.get(); }
+		size_t GetSize() const { return m_size; }
+		void Reserve(size_t capacity);
+		void Clear() { m_size = 0; }
+
+		//= WRITING ======================================================================
+		void WriteBool(bool value) { WriteBytes(&value, sizeof(value)); }
+		void WriteInt(int value) { WriteBytes(&value, sizeof(value)); }
+		void WriteUINT(unsigned int value) { WriteBytes(&value, sizeof(value)); }
+		void WriteFloat(float value) { WriteBytes(&value, sizeof(value)); }
+		void WriteSTR(const std::string& value);
+		void WriteVectorSTR(const std::vector<std::string>& vector);
+		void WriteVector2(const Math::Vector2& vector);
+		void WriteVector3(const Math::Vector3& vector);
+		void WriteVector4(const Math::Vector4& vector);
+		void WriteQuaternion(const Math::Quaternion& quaternion);
+
+		// Pads with zeros until the size is a multiple of alignment (a power of two)
+		void Align(size_t alignment);
+
+		// Writes a span of plain data as it is laid out in memory
+		template <typename T>
+		void WriteArray(const T* data, size_t count)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "WriteArray() copies the bytes, it only takes trivially copyable types");
+			WriteBytes(data, sizeof(T) * count);
+		}
+
+		void WriteBytes(const void* data, size_t size)
+		{
+			if (size > m_capacity - m_size)
+			{
+				Reserve(m_size + size);
+			}
+
+			memcpy(m_data.get() + m_size, data, size);
+			m_size += size;
+		}
+		//================================================================================
+
+	private:
+		std::unique_ptr<char[]> m_data;
+		size_t m_size;
+		size_t m_capacity;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,445 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ========================
+#include "BlockCompression.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include "../Logging/Log.h"
+#include "../Threading/Threading.h"
+//===================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	// [header][block table, one entry per block][compressed blocks, back to back]
+	static const char BLOCK_MAGIC[4] = { 'D', 'B', 'L', 'K' };
+	static const uint32_t BLOCK_VERSION = 1;
+	static const uint32_t BLOCK_SIZE = 256 * 1024;
+	static const uint32_t MAX_BLOCK_SIZE = 16 * 1024 * 1024;
+
+	struct BlockFileHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t blockSize;
+		uint32_t blockCount;
+		uint64_t size; // uncompressed
+	};
+
+	enum BlockFlags : uint32_t
+	{
+		Block_Stored	= 1 << 0, // didn't compress, kept raw
+		Block_Shuffled	= 1 << 1  // bytes grouped by their position in 4 byte words before compressing
+	};
+
+	struct BlockEntry
+	{
+		uint32_t compressedSize;
+		uint32_t flags;
+	};
+
+	static_assert(sizeof(BlockFileHeader) == 24 && sizeof(BlockEntry) == 8, "The block file structures must not contain padding");
+
+	//= LZ77 ===========================================================================================
+	// A sequence is a token (literal count : match length - MIN_MATCH, 4 bits each), lengths of 15 and
+	// over continued in bytes of 255 and a remainder, the literals, and a 16 bit offset to the match.
+	// The last sequence of a block only has literals.
+	static const size_t MIN_MATCH = 4;
+	static const size_t MAX_OFFSET = 65535;
+	static const int HASH_BITS = 14;
+
+	static size_t CompressBound(size_t size)
+	{
+		return size + size / 255 + 16;
+	}
+
+	static uint32_t Read32(const uint8_t* data)
+	{
+		uint32_t value;
+		memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	static uint8_t* WriteLength(uint8_t* out, size_t length)
+	{
+		for (; length >= 255; length -= 255)
+		{
+			*out++ = 255;
+		}
+		*out++ = (uint8_t)length;
+
+		return out;
+	}
+
+	static bool ReadLength(const uint8_t*& in, const uint8_t* end, size_t& length)
+	{
+		uint8_t value;
+		do
+		{
+			if (in == end)
+				return false;
+
+			value = *in++;
+			length += value;
+		} while (value == 255);
+
+		return true;
+	}
+
+	static uint8_t* WriteSequence(uint8_t* out, const uint8_t* literals, size_t literalCount, size_t offset, size_t matchLength)
+	{
+		uint8_t* token = out++;
+		*token = (uint8_t)((literalCount < 15 ? literalCount : 15) << 4);
+		if (literalCount >= 15)
+		{
+			out = WriteLength(out, literalCount - 15);
+		}
+
+		memcpy(out, literals, literalCount);
+		out += literalCount;
+
+		// The last sequence
+		if (matchLength == 0)
+			return out;
+
+		uint16_t offset16 = (uint16_t)offset;
+		memcpy(out, &offset16, sizeof(offset16));
+		out += sizeof(offset16);
+
+		size_t length = matchLength - MIN_MATCH;
+		*token |= (uint8_t)(length < 15 ? length : 15);
+		if (length >= 15)
+		{
+			out = WriteLength(out, length - 15);
+		}
+
+		return out;
+	}
+
+	// dst must hold CompressBound(size) bytes
+	static size_t CompressBlock(const uint8_t* src, size_t size, uint8_t* dst)
+	{
+		vector<uint32_t> table(1 << HASH_BITS, 0);
+		uint8_t* out = dst;
+		size_t anchor = 0;
+		size_t position = 0;
+
+		// Matches never reach into the last bytes, that keeps the reads in bounds
+		size_t limit = size > MIN_MATCH * 2 ? size - MIN_MATCH * 2 : 0;
+		while (position < limit)
+		{
+			uint32_t sequence = Read32(src + position);
+			uint32_t hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+			size_t candidate = table[hash];
+			table[hash] = (uint32_t)position;
+
+			if (candidate >= position || position - candidate > MAX_OFFSET || Read32(src + candidate) != sequence)
+			{
+				// Skip faster through data that doesn't compress
+				position += 1 + ((position - anchor) >> 6);
+				continue;
+			}
+
+			size_t matchLength = MIN_MATCH;
+			while (position + matchLength < size && src[candidate + matchLength] == src[position + matchLength])
+			{
+				matchLength++;
+			}
+
+			out = WriteSequence(out, src + anchor, position - anchor, position - candidate, matchLength);
+			position += matchLength;
+			anchor = position;
+		}
+
+		out = WriteSequence(out, src + anchor, size - anchor, 0, 0);
+		return out - dst;
+	}
+
+	static bool DecompressBlock(const uint8_t* src, size_t size, uint8_t* dst, size_t dstSize)
+	{
+		const uint8_t* in = src;
+		const uint8_t* end = src + size;
+		uint8_t* out = dst;
+		uint8_t* outEnd = dst + dstSize;
+
+		while (in < end)
+		{
+			uint8_t token = *in++;
+
+			size_t literalCount = token >> 4;
+			if (literalCount == 15 && !ReadLength(in, end, literalCount))
+				return false;
+
+			if (literalCount > (size_t)(end - in) || literalCount > (size_t)(outEnd - out))
+				return false;
+
+			memcpy(out, in, literalCount);
+			in += literalCount;
+			out += literalCount;
+
+			// The last sequence
+			if (in == end)
+				break;
+
+			if (end - in < 2)
+				return false;
+
+			uint16_t offset;
+			memcpy(&offset, in, sizeof(offset));
+			in += sizeof(offset);
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15 && !ReadLength(in, end, matchLength))
+				return false;
+			matchLength += MIN_MATCH;
+
+			if (offset == 0 || offset > (size_t)(out - dst) || matchLength > (size_t)(outEnd - out))
+				return false;
+
+			// Overlapping matches repeat what they have just written
+			const uint8_t* match = out - offset;
+			if (offset >= matchLength)
+			{
+				memcpy(out, match, matchLength);
+				out += matchLength;
+			}
+			else
+			{
+				for (size_t i = 0; i < matchLength; i++)
+				{
+					*out++ = *match++;
+				}
+			}
+		}
+
+		return out == outEnd;
+	}
+	//==================================================================================================
+
+	//= SHUFFLE ========================================================================================
+	// Floats that are close in value share their high bytes, grouping those bytes together
+	// turns vertex data into long runs which compress far better.
+	static void Shuffle(const uint8_t* src, size_t size, uint8_t* dst)
+	{
+		size_t words = size / 4;
+		for (size_t i = 0; i < words; i++)
+		{
+			for (size_t k = 0; k < 4; k++)
+			{
+				dst[k * words + i] = src[i * 4 + k];
+			}
+		}
+		memcpy(dst + words * 4, src + words * 4, size - words * 4);
+	}
+
+	static void Unshuffle(const uint8_t* src, size_t size, uint8_t* dst)
+	{
+		size_t words = size / 4;
+		for (size_t i = 0; i < words; i++)
+		{
+			for (size_t k = 0; k < 4; k++)
+			{
+				dst[i * 4 + k] = src[k * words + i];
+			}
+		}
+		memcpy(dst + words * 4, src + words * 4, size - words * 4);
+	}
+	//==================================================================================================
+
+	template <typename Function>
+	static void ForEachBlock(size_t blockCount, Threading* threading, Function&& function)
+	{
+		if (threading)
+		{
+			threading->ParallelFor(0, blockCount, 1, function);
+			return;
+		}
+
+		for (size_t i = 0; i < blockCount; i++)
+		{
+			function(i);
+		}
+	}
+
+	bool BlockCompression::IsCompressed(const char* data, size_t size)
+	{
+		return data && size >= sizeof(BlockFileHeader) && memcmp(data, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) == 0;
+	}
+
+	void BlockCompression::Compress(const char* data, size_t size, vector<char>& output, Threading* threading)
+	{
+		BlockFileHeader header;
+		memcpy(header.magic, BLOCK_MAGIC, sizeof(header.magic));
+		header.version = BLOCK_VERSION;
+		header.blockSize = BLOCK_SIZE;
+		header.blockCount = (uint32_t)((size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+		header.size = size;
+
+		// Every block keeps whichever is smallest: compressed as is, compressed after a shuffle, or raw
+		vector<BlockEntry> entries(header.blockCount);
+		vector<vector<uint8_t>> blocks(header.blockCount);
+		ForEachBlock(header.blockCount, threading, [data, size, &entries, &blocks](size_t i)
+		{
+			const uint8_t* src = (const uint8_t*)data + i * BLOCK_SIZE;
+			size_t srcSize = (size - i * BLOCK_SIZE) < BLOCK_SIZE ? size - i * BLOCK_SIZE : BLOCK_SIZE;
+
+			vector<uint8_t> plain(CompressBound(srcSize));
+			plain.resize(CompressBlock(src, srcSize, plain.data()));
+
+			vector<uint8_t> shuffled(srcSize);
+			vector<uint8_t> shuffledCompressed(CompressBound(srcSize));
+			Shuffle(src, srcSize, shuffled.data());
+			shuffledCompressed.resize(CompressBlock(shuffled.data(), srcSize, shuffledCompressed.data()));
+
+			if (shuffledCompressed.size() < plain.size() && shuffledCompressed.size() < srcSize)
+			{
+				entries[i].flags = Block_Shuffled;
+				blocks[i] = move(shuffledCompressed);
+			}
+			else if (plain.size() < srcSize)
+			{
+				entries[i].flags = 0;
+				blocks[i] = move(plain);
+			}
+			else
+			{
+				entries[i].flags = Block_Stored;
+				blocks[i].assign(src, src + srcSize);
+			}
+			entries[i].compressedSize = (uint32_t)blocks[i].size();
+		});
+
+		size_t outputSize = sizeof(header) + entries.size() * sizeof(BlockEntry);
+		for (const auto& block : blocks)
+		{
+			outputSize += block.size();
+		}
+
+		output.resize(outputSize);
+		char* out = output.data();
+		memcpy(out, &header, sizeof(header));
+		out += sizeof(header);
+		if (!entries.empty())
+		{
+			memcpy(out, entries.data(), entries.size() * sizeof(BlockEntry));
+			out += entries.size() * sizeof(BlockEntry);
+		}
+		for (const auto& block : blocks)
+		{
+			memcpy(out, block.data(), block.size());
+			out += block.size();
+		}
+	}
+
+	bool BlockCompression::Decompress(const char* data, size_t size, vector<char>& output, Threading* threading)
+	{
+		if (!IsCompressed(data, size))
+			return false;
+
+		BlockFileHeader header;
+		memcpy(&header, data, sizeof(header));
+		if (header.version != BLOCK_VERSION || header.blockSize == 0 || header.blockSize > MAX_BLOCK_SIZE ||
+			header.blockCount != (header.size + header.blockSize - 1) / header.blockSize ||
+			(uint64_t)header.blockCount * sizeof(BlockEntry) > size - sizeof(header))
+		{
+			LOG_ERROR("BlockCompression: Unsupported or corrupt header.");
+			return false;
+		}
+
+		vector<BlockEntry> entries(header.blockCount);
+		if (!entries.empty())
+		{
+			memcpy(entries.data(), data + sizeof(header), entries.size() * sizeof(BlockEntry));
+		}
+
+		// Blocks are back to back, their offsets follow from the sizes
+		vector<uint64_t> offsets(header.blockCount);
+		uint64_t offset = sizeof(header) + entries.size() * sizeof(BlockEntry);
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			uint64_t blockSize = (header.size - i * header.blockSize) < header.blockSize ? header.size - i * header.blockSize : header.blockSize;
+			bool stored = (entries[i].flags & Block_Stored) != 0;
+
+			// A sequence can't expand to more than 255 bytes per input byte, which
+			// also bounds the allocation below by what's actually in the file
+			if ((stored && entries[i].compressedSize != blockSize) || blockSize > (uint64_t)entries[i].compressedSize * 255)
+			{
+				LOG_ERROR("BlockCompression: Corrupt block table.");
+				return false;
+			}
+
+			offsets[i] = offset;
+			offset += entries[i].compressedSize;
+		}
+
+		if (offset > size)
+		{
+			LOG_ERROR("BlockCompression: The data is truncated.");
+			return false;
+		}
+
+		output.resize((size_t)header.size);
+		atomic<bool> valid(true);
+		ForEachBlock(header.blockCount, threading, [data, &header, &entries, &offsets, &output, &valid](size_t i)
+		{
+			const uint8_t* src = (const uint8_t*)data + offsets[i];
+			uint8_t* dst = (uint8_t*)output.data() + i * header.blockSize;
+			size_t dstSize = (size_t)((header.size - i * header.blockSize) < header.blockSize ? header.size - i * header.blockSize : header.blockSize);
+
+			if (entries[i].flags & Block_Stored)
+			{
+				memcpy(dst, src, dstSize);
+				return;
+			}
+
+			if (!(entries[i].flags & Block_Shuffled))
+			{
+				if (!DecompressBlock(src, entries[i].compressedSize, dst, dstSize))
+				{
+					valid = false;
+				}
+				return;
+			}
+
+			vector<uint8_t> shuffled(dstSize);
+			if (!DecompressBlock(src, entries[i].compressedSize, shuffled.data(), dstSize))
+			{
+				valid = false;
+				return;
+			}
+			Unshuffle(shuffled.data(), dstSize, dst);
+		});
+
+		if (!valid)
+		{
+			LOG_ERROR("BlockCompression: Corrupt block data.");
+			output.clear();
+			return false;
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==============
+#include <cstddef>
+#include <vector>
+#include "../Core/Helper.h"
+//=========================
+
+namespace Directus
+{
+	class Threading;
+
+	// Optional compression for the engine's binary files. The data is split into fixed size blocks which
+	// are compressed independently (LZ77, with a byte shuffle for float heavy blocks), so that they can be
+	// (de)compressed in parallel. Compressed data is recognized by its header, anything else is left as is.
+	class DLL_API BlockCompression
+	{
+	public:
+		static bool IsCompressed(const char* data, size_t size);
+
+		// The threading subsystem is optional, without it the blocks are processed one after the other
+		static void Compress(const char* data, size_t size, std::vector<char>& output, Threading* threading = nullptr);
+		static bool Decompress(const char* data, size_t size, std::vector<char>& output, Threading* threading = nullptr);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,199 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ========================
+#include "ContentHash.h"
+#include <cstring>
+#include <vector>
+#include "MemoryMappedFile.h"
+#include "../Threading/Threading.h"
+//===================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	//= XXHASH64 =======================================================================================
+	static const uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+	static const uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+	static const uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+	static const uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+	static const uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+	static const size_t BLOCK_SIZE = 1024 * 1024;
+
+	static uint64_t RotateLeft(uint64_t value, int bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	static uint64_t Read64(const uint8_t* data)
+	{
+		uint64_t value;
+		memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	static uint32_t Read32(const uint8_t* data)
+	{
+		uint32_t value;
+		memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	static uint64_t Round(uint64_t accumulator, uint64_t input)
+	{
+		accumulator += input * PRIME2;
+		accumulator = RotateLeft(accumulator, 31);
+		return accumulator * PRIME1;
+	}
+
+	static uint64_t MergeRound(uint64_t accumulator, uint64_t value)
+	{
+		accumulator ^= Round(0, value);
+		return accumulator * PRIME1 + PRIME4;
+	}
+
+	static uint64_t XXHash64(const uint8_t* data, size_t size, uint64_t seed)
+	{
+		const uint8_t* end = data + size;
+		uint64_t hash;
+
+		if (size >= 32)
+		{
+			uint64_t v1 = seed + PRIME1 + PRIME2;
+			uint64_t v2 = seed + PRIME2;
+			uint64_t v3 = seed;
+			uint64_t v4 = seed - PRIME1;
+
+			const uint8_t* limit = end - 32;
+			do
+			{
+				v1 = Round(v1, Read64(data));
+				v2 = Round(v2, Read64(data + 8));
+				v3 = Round(v3, Read64(data + 16));
+				v4 = Round(v4, Read64(data + 24));
+				data += 32;
+			} while (data <= limit);
+
+			hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+			hash = MergeRound(hash, v1);
+			hash = MergeRound(hash, v2);
+			hash = MergeRound(hash, v3);
+			hash = MergeRound(hash, v4);
+		}
+		else
+		{
+			hash = seed + PRIME5;
+		}
+
+		hash += (uint64_t)size;
+
+		for (; data + 8 <= end; data += 8)
+		{
+			hash ^= Round(0, Read64(data));
+			hash = RotateLeft(hash, 27) * PRIME1 + PRIME4;
+		}
+
+		if (data + 4 <= end)
+		{
+			hash ^= (uint64_t)Read32(data) * PRIME1;
+			hash = RotateLeft(hash, 23) * PRIME2 + PRIME3;
+			data += 4;
+		}
+
+		for (; data < end; data++)
+		{
+			hash ^= (*data) * PRIME5;
+			hash = RotateLeft(hash, 11) * PRIME1;
+		}
+
+		hash ^= hash >> 33;
+		hash *= PRIME2;
+		hash ^= hash >> 29;
+		hash *= PRIME3;
+		hash ^= hash >> 32;
+
+		return hash;
+	}
+	//==================================================================================================
+
+	uint64_t ContentHash::Compute(const void* data, size_t size, Threading* threading)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+		size_t blockCount = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+		if (blockCount <= 1)
+			return XXHash64(bytes, size, 0);
+
+		// Every block on its own, then the block hashes, so that the blocks can be spread across the workers
+		vector<uint64_t> blockHashes(blockCount);
+		auto hashBlock = [bytes, size, &blockHashes](size_t i)
+		{
+			size_t offset = i * BLOCK_SIZE;
+			size_t blockSize = size - offset < BLOCK_SIZE ? size - offset : BLOCK_SIZE;
+			blockHashes[i] = XXHash64(bytes + offset, blockSize, 0);
+		};
+
+		if (threading)
+		{
+			threading->ParallelFor(0, blockCount, 1, hashBlock);
+		}
+		else
+		{
+			for (size_t i = 0; i < blockCount; i++)
+			{
+				hashBlock(i);
+			}
+		}
+
+		return XXHash64((const uint8_t*)blockHashes.data(), blockHashes.size() * sizeof(uint64_t), (uint64_t)size);
+	}
+
+	bool ContentHash::ComputeFromFile(const string& filePath, uint64_t& hash, Threading* threading)
+	{
+		MemoryMappedFile file;
+		if (!file.Open(filePath))
+			return false;
+
+		hash = Compute(file.GetData(), file.GetSize(), threading);
+		return true;
+	}
+
+	uint64_t ContentHash::Combine(uint64_t hash, uint64_t value)
+	{
+		return XXHash64((const uint8_t*)&value, sizeof(value), hash);
+	}
+
+	string ContentHash::ToString(uint64_t hash)
+	{
+		static const char digits[] = "0123456789abcdef";
+
+		string text(16, '0');
+		for (int i = 15; i >= 0; i--)
+		{
+			text[i] = digits[hash & 0xF];
+			hash >>= 4;
+		}
+
+		return text;
+	}
+}
\ No newline at end of file
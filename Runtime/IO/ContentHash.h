@@ -0,0 +1,49 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==============
+#include <cstdint>
+#include <string>
+#include "../Core/Helper.h"
+//=========================
+
+namespace Directus
+{
+	class Threading;
+
+	// A fast, non-cryptographic 64-bit hash of file contents (xxHash64 over 1 MB blocks, then over
+	// the block hashes), meant to tell whether source data changed. The blocks are hashed in
+	// parallel when a threading subsystem is given, the result is the same either way.
+	class DLL_API ContentHash
+	{
+	public:
+		static uint64_t Compute(const void* data, size_t size, Threading* threading = nullptr);
+		static bool ComputeFromFile(const std::string& filePath, uint64_t& hash, Threading* threading = nullptr);
+
+		// Order dependent, for folding settings and versions into a hash
+		static uint64_t Combine(uint64_t hash, uint64_t value);
+
+		// 16 hex digits, usable as a file name
+		static std::string ToString(uint64_t hash);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==================
+#include "MemoryMappedFile.h"
+#include "../Logging/Log.h"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+//=============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	MemoryMappedFile::MemoryMappedFile()
+	{
+		m_data = nullptr;
+		m_size = 0;
+		m_isOpen = false;
+	}
+
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		Close();
+	}
+
+	bool MemoryMappedFile::Open(const string& filePath)
+	{
+		Close();
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			LOG_ERROR("MemoryMappedFile: Failed to open \"" + filePath + "\".");
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size))
+		{
+			LOG_ERROR("MemoryMappedFile: Failed to get the size of \"" + filePath + "\".");
+			CloseHandle(file);
+			return false;
+		}
+
+		// An empty file can't be mapped, but it's still a valid (empty) view
+		if (size.QuadPart != 0)
+		{
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+			// The view keeps the mapping and the file alive, the handles aren't needed anymore
+			if (mapping)
+			{
+				CloseHandle(mapping);
+			}
+			CloseHandle(file);
+
+			if (!data)
+			{
+				LOG_ERROR("MemoryMappedFile: Failed to map \"" + filePath + "\".");
+				return false;
+			}
+
+			m_data = (const char*)data;
+			m_size = (size_t)size.QuadPart;
+		}
+		else
+		{
+			CloseHandle(file);
+		}
+#else
+		int file = open(filePath.c_str(), O_RDONLY);
+		if (file == -1)
+		{
+			LOG_ERROR("MemoryMappedFile: Failed to open \"" + filePath + "\".");
+			return false;
+		}
+
+		struct stat info;
+		if (fstat(file, &info) != 0)
+		{
+			LOG_ERROR("MemoryMappedFile: Failed to get the size of \"" + filePath + "\".");
+			close(file);
+			return false;
+		}
+
+		if (info.st_size != 0)
+		{
+			void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			close(file);
+
+			if (data == MAP_FAILED)
+			{
+				LOG_ERROR("MemoryMappedFile: Failed to map \"" + filePath + "\".");
+				return false;
+			}
+
+			m_data = (const char*)data;
+			m_size = (size_t)info.st_size;
+		}
+		else
+		{
+			close(file);
+		}
+#endif
+
+		m_isOpen = true;
+		m_filePath = filePath;
+
+		return true;
+	}
+
+	void MemoryMappedFile::Close()
+	{
+		if (m_data)
+		{
+#ifdef _WIN32
+			UnmapViewOfFile(m_data);
+#else
+			munmap((void*)m_data, m_size);
+#endif
+		}
+
+		m_data = nullptr;
+		m_size = 0;
+		m_isOpen = false;
+		m_filePath.clear();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==============
+#include <string>
+#include "../Core/Helper.h"
+//=========================
+
+namespace Directus
+{
+	// A read-only view of a whole file, the OS pages it in on demand and nothing gets
+	// copied. Pointers into GetData() stay valid for as long as the file stays open.
+	class DLL_API MemoryMappedFile
+	{
+	public:
+		MemoryMappedFile();
+		~MemoryMappedFile();
+		MemoryMappedFile(const MemoryMappedFile&) = delete;
+		MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+		bool Open(const std::string& filePath);
+		void Close();
+
+		bool IsOpen() const { return m_isOpen; }
+		const char* GetData() const { return m_data; }
+		size_t GetSize() const { return m_size; }
+		const std::string& GetFilePath() const { return m_filePath; }
+
+	private:
+		const char* m_data;
+		size_t m_size;
+		bool m_isOpen;
+		std::string m_filePath;
+	};
+}
\ No newline at end of file
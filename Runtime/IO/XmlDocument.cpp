@@ -37,8 +37,8 @@ using namespace Directus::Math;
 
 namespace Directus
 {
-	unique_ptr<xml_document> XmlDocument::m_document;
-	vector<shared_ptr<xml_node>> XmlDocument::m_nodes;
+	thread_local unique_ptr<xml_document> XmlDocument::m_document;
+	thread_local vector<shared_ptr<xml_node>> XmlDocument::m_nodes;
 
 	void XmlDocument::Create()
 	{
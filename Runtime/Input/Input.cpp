@@ -23,7 +23,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Input.h"
 #include "../Core/Settings.h"
 #include "../Logging/Log.h"
-#include "../EventSystem/EventSystem.h"
+#include "../Core/Context.h"
+#include "../Core/Scheduler.h"
 //=====================================
 
 //= NAMESPACES ================
@@ -38,8 +39,10 @@ namespace Directus
 		m_DX8Input = nullptr;
 		m_initialized = false;
 
-		// Subscribe to update event
-		SUBSCRIBE_TO_EVENT(EVENT_UPDATE, this, Input::Update);
+		// DirectInput is bound to the window's thread
+		m_context->GetSubsystem<Scheduler>()->AddJob("Input", Stage_Update,
+			Frame_None, Frame_Input, true,
+			bind(&Input::Update, this));
 	}
 
 	Input::~Input()
@@ -66,7 +66,7 @@ namespace Directus
 			min = Vector3::Infinity;
 			max = Vector3::InfinityNeg;
 
-			auto vertices = mesh->GetVertices();
+			const VertexPosTexNorTan* vertices = mesh->GetVertexData();
 			for (unsigned int i = 0; i < mesh->GetVertexCount(); i++)
 			{
 				max.x = Max(max.x, vertices[i].position.x);
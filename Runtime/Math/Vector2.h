@@ -45,7 +45,7 @@ namespace Directus
 				this->y = y;
 			}
 
-			Vector2::~Vector2() {}
+			~Vector2() = default;
 
 			Vector2 Vector2::operator+(const Vector2& b)
 			{
@@ -41,13 +41,8 @@ namespace Directus
 				z = 0;
 			}
 
-			// Copy-constructor
-			Vector3(const Vector3& vector)
-			{
-				x = vector.x;
-				y = vector.y;
-				z = vector.z;
-			}
+			// Copy-constructor, trivial so that vectors (and vertices) can be copied as bytes
+			Vector3(const Vector3& vector) = default;
 
 			// Construct from coordinates.
 			Vector3(float x, float y, float z)
@@ -35,6 +35,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Core/Context.h"
 #include "../Core/Timer.h"
 #include "../Core/Engine.h"
+#include "../Core/Scheduler.h"
+#include "../Profiling/Profiler.h"
 //==============================================================================
 
 namespace Directus
@@ -46,8 +48,10 @@ namespace Directus
 		m_gravity = Math::Vector3(0.0f, -9.81f, 0.0f);
 		m_simulating = false;
 
-		// Subscribe to update event
-		SUBSCRIBE_TO_EVENT(EVENT_UPDATE, this, Physics::Step);
+		// The simulation writes back to the transforms of the rigid bodies
+		m_context->GetSubsystem<Scheduler>()->AddJob("Physics", Stage_Update,
+			Frame_None, Frame_Physics | Frame_Transforms, false,
+			bind(&Physics::Step, this));
 	}
 
 	Physics::~Physics()
@@ -98,6 +102,7 @@ namespace Directus
 		m_simulating = true;
 
 		// Step the physics world. 
+		PROFILE_SCOPE("Physics::Step");
 		m_world->stepSimulation(timeStep, m_maxSubSteps, fixedTimeStep);
 
 		m_simulating = false;
@@ -0,0 +1,317 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==============
+#include "Profiler.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+#include "../Logging/Log.h"
+//=========================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	static_assert((Profiler::MAX_EVENTS_PER_THREAD & (Profiler::MAX_EVENTS_PER_THREAD - 1)) == 0, "MAX_EVENTS_PER_THREAD must be a power of two");
+
+	atomic<bool> Profiler::m_enabled(false);
+
+	struct ProfilerEvent
+	{
+		const char* name;
+		int64_t start;
+		int64_t end;
+	};
+
+	// Every thread that records a zone gets one. They live as long as the process,
+	// so that a trace still shows the work of threads that have already exited.
+	struct ProfilerThread
+	{
+		int id = 0;
+		string name;
+
+		// Completed zones, a ring written by the owning thread and allocated on the
+		// first one. The mutex is only ever contended while a trace is being saved.
+		mutex eventsMutex;
+		unique_ptr<ProfilerEvent[]> events;
+		int64_t eventCount = 0;
+
+		// Open zones, only touched by the owning thread
+		ProfilerEvent open[Profiler::MAX_DEPTH];
+		int depth = 0;
+	};
+
+	struct ProfilerState
+	{
+		mutex threadsMutex;
+		vector<unique_ptr<ProfilerThread>> threads;
+
+		mutex framesMutex;
+		int64_t frameStarts[Profiler::MAX_FRAMES];
+		int64_t frameCount = 0;
+
+		mutex namesMutex;
+		unordered_set<string> names;
+	};
+
+	static ProfilerState& GetState()
+	{
+		static ProfilerState state;
+		return state;
+	}
+
+	static thread_local ProfilerThread* t_profilerThread = nullptr;
+
+	static ProfilerThread* GetProfilerThread()
+	{
+		if (t_profilerThread)
+			return t_profilerThread;
+
+		ProfilerState& state = GetState();
+		lock_guard<mutex> lock(state.threadsMutex);
+
+		auto thread = make_unique<ProfilerThread>();
+		thread->id = (int)state.threads.size() + 1;
+		thread->name = "Thread " + to_string(thread->id);
+
+		t_profilerThread = thread.get();
+		state.threads.push_back(move(thread));
+
+		return t_profilerThread;
+	}
+
+	// Names end up in a JSON string
+	static void WriteEscaped(ofstream& out, const char* text)
+	{
+		for (const char* c = text; *c; c++)
+		{
+			if (*c == '"' || *c == '\\')
+			{
+				out << '\\' << *c;
+			}
+			else if ((unsigned char)*c >= 0x20)
+			{
+				out << *c;
+			}
+		}
+	}
+
+	void Profiler::SetEnabled(bool enabled)
+	{
+		m_enabled.store(enabled, memory_order_relaxed);
+	}
+
+	void Profiler::BeginFrame()
+	{
+		if (!IsEnabled())
+			return;
+
+		ProfilerState& state = GetState();
+		lock_guard<mutex> lock(state.framesMutex);
+		state.frameStarts[state.frameCount % MAX_FRAMES] = Now();
+		state.frameCount++;
+	}
+
+	void Profiler::SetThreadName(const string& name)
+	{
+		ProfilerThread* thread = GetProfilerThread();
+		lock_guard<mutex> lock(thread->eventsMutex);
+		thread->name = name;
+	}
+
+	bool Profiler::SaveTrace(const string& filePath)
+	{
+		ProfilerState& state = GetState();
+
+		// Anything that ended before the oldest frame we still know about is left out
+		int64_t frameCount;
+		int64_t frameStarts[MAX_FRAMES];
+		{
+			lock_guard<mutex> lock(state.framesMutex);
+			frameCount = state.frameCount;
+			for (int i = 0; i < MAX_FRAMES; i++)
+			{
+				frameStarts[i] = state.frameStarts[i];
+			}
+		}
+		int64_t firstFrame = frameCount > MAX_FRAMES ? frameCount - MAX_FRAMES : 0;
+		int64_t cutoff = frameCount != 0 ? frameStarts[firstFrame % MAX_FRAMES] : INT64_MIN;
+
+		// Copy the events out, so that no thread is held up while we write
+		struct ThreadSnapshot
+		{
+			int id;
+			string name;
+			vector<ProfilerEvent> events;
+		};
+		vector<ThreadSnapshot> snapshots;
+		{
+			lock_guard<mutex> threadsLock(state.threadsMutex);
+			for (const auto& thread : state.threads)
+			{
+				ThreadSnapshot snapshot;
+				snapshot.id = thread->id;
+
+				lock_guard<mutex> eventsLock(thread->eventsMutex);
+				snapshot.name = thread->name;
+				int64_t first = thread->eventCount > MAX_EVENTS_PER_THREAD ? thread->eventCount - MAX_EVENTS_PER_THREAD : 0;
+				for (int64_t i = first; i < thread->eventCount; i++)
+				{
+					const ProfilerEvent& event = thread->events[i & (MAX_EVENTS_PER_THREAD - 1)];
+					if (event.end >= cutoff)
+					{
+						snapshot.events.push_back(event);
+					}
+				}
+				snapshots.push_back(move(snapshot));
+			}
+		}
+
+		// Timestamps are relative to the start of the trace
+		int64_t origin = cutoff;
+		if (frameCount == 0)
+		{
+			origin = INT64_MAX;
+			for (const auto& snapshot : snapshots)
+			{
+				for (const auto& event : snapshot.events)
+				{
+					origin = event.start < origin ? event.start : origin;
+				}
+			}
+		}
+
+		ofstream out(filePath, ios::out | ios::trunc);
+		if (!out.is_open())
+		{
+			LOG_ERROR("Profiler: Failed to open \"" + filePath + "\" for writing");
+			return false;
+		}
+
+		// Chrome's trace event format, timestamps and durations are in microseconds
+		out << fixed << setprecision(3);
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		bool first = true;
+		auto separate = [&out, &first]()
+		{
+			out << (first ? "" : ",\n");
+			first = false;
+		};
+
+		for (const auto& snapshot : snapshots)
+		{
+			separate();
+			out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << snapshot.id << ",\"args\":{\"name\":\"";
+			WriteEscaped(out, snapshot.name.c_str());
+			out << "\"}}";
+
+			for (const auto& event : snapshot.events)
+			{
+				separate();
+				out << "{\"name\":\"";
+				WriteEscaped(out, event.name);
+				out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << snapshot.id;
+				out << ",\"ts\":" << (event.start - origin) / 1000.0;
+				out << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+			}
+		}
+
+		for (int64_t i = firstFrame; i < frameCount; i++)
+		{
+			separate();
+			out << "{\"name\":\"Frame " << i << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0";
+			out << ",\"ts\":" << (frameStarts[i % MAX_FRAMES] - origin) / 1000.0 << "}";
+		}
+
+		out << "\n]}\n";
+		out.close();
+
+		return !out.fail();
+	}
+
+	void Profiler::Clear()
+	{
+		ProfilerState& state = GetState();
+		{
+			lock_guard<mutex> lock(state.framesMutex);
+			state.frameCount = 0;
+		}
+
+		lock_guard<mutex> threadsLock(state.threadsMutex);
+		for (const auto& thread : state.threads)
+		{
+			lock_guard<mutex> eventsLock(thread->eventsMutex);
+			thread->eventCount = 0;
+		}
+	}
+
+	int64_t Profiler::Now()
+	{
+		return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	const char* Profiler::Intern(const string& name)
+	{
+		ProfilerState& state = GetState();
+		lock_guard<mutex> lock(state.namesMutex);
+
+		// Elements of an unordered_set don't move when it rehashes
+		return state.names.insert(name).first->c_str();
+	}
+
+	bool Profiler::BeginZone(const char* name)
+	{
+		ProfilerThread* thread = GetProfilerThread();
+		if (thread->depth >= MAX_DEPTH)
+			return false;
+
+		ProfilerEvent& event = thread->open[thread->depth++];
+		event.name = name;
+		event.start = Now();
+
+		return true;
+	}
+
+	void Profiler::EndZone()
+	{
+		ProfilerThread* thread = t_profilerThread;
+		if (!thread || thread->depth == 0)
+			return;
+
+		ProfilerEvent event = thread->open[--thread->depth];
+		event.end = Now();
+
+		lock_guard<mutex> lock(thread->eventsMutex);
+		if (!thread->events)
+		{
+			thread->events = make_unique<ProfilerEvent[]>(MAX_EVENTS_PER_THREAD);
+		}
+		thread->events[thread->eventCount & (MAX_EVENTS_PER_THREAD - 1)] = event;
+		thread->eventCount++;
+	}
+}
\ No newline at end of file
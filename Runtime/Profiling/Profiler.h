@@ -0,0 +1,117 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==========
+#include "../Core/Helper.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+//=====================
+
+namespace Directus
+{
+// Zones measure the scope they are declared in. Defining PROFILER_DISABLED
+// compiles all of them out, otherwise a zone costs a single relaxed load
+// for as long as the profiler is not enabled at runtime.
+#ifndef PROFILER_DISABLED
+	#define PROFILE_CONCAT_INNER(a, b) a##b
+	#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+	#define PROFILE_SCOPE(name) ProfilerZone PROFILE_CONCAT(profilerZone, __LINE__)(name)
+	#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+	#define PROFILE_FRAME() Profiler::BeginFrame()
+#else
+	#define PROFILE_SCOPE(name)
+	#define PROFILE_FUNCTION()
+	#define PROFILE_FRAME()
+#endif
+
+	class DLL_API Profiler
+	{
+	public:
+		// How many of the most recent frames a trace covers
+		static const int MAX_FRAMES = 8;
+		// Completed zones kept per thread, the oldest ones get overwritten first
+		static const int MAX_EVENTS_PER_THREAD = 65536;
+		// Zones nested deeper than this are not recorded
+		static const int MAX_DEPTH = 64;
+
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+		// Marks the start of a new frame, call once per frame from the main thread
+		static void BeginFrame();
+
+		// Names the calling thread in exported traces
+		static void SetThreadName(const std::string& name);
+
+		// Writes the recorded frames as a Chrome trace (chrome://tracing, ui.perfetto.dev)
+		static bool SaveTrace(const std::string& filePath);
+
+		// Drops everything recorded so far
+		static void Clear();
+
+		// Nanoseconds on a monotonic clock
+		static int64_t Now();
+
+		// Returns a copy of the name that lives as long as the process,
+		// zones only keep the pointer so dynamic names have to go through here.
+		static const char* Intern(const std::string& name);
+
+		// Zones must end on the thread that began them, in reverse order.
+		// Prefer PROFILE_SCOPE() which takes care of that.
+		static bool BeginZone(const char* name);
+		static void EndZone();
+
+	private:
+		static std::atomic<bool> m_enabled;
+	};
+
+	class DLL_API ProfilerZone
+	{
+	public:
+		ProfilerZone(const char* name)
+		{
+			m_active = Profiler::IsEnabled() && Profiler::BeginZone(name);
+		}
+
+		// The name is only copied when the profiler is enabled
+		ProfilerZone(const std::string& name)
+		{
+			m_active = Profiler::IsEnabled() && Profiler::BeginZone(Profiler::Intern(name));
+		}
+
+		~ProfilerZone()
+		{
+			if (m_active)
+			{
+				Profiler::EndZone();
+			}
+		}
+
+		ProfilerZone(const ProfilerZone&) = delete;
+		ProfilerZone& operator=(const ProfilerZone&) = delete;
+
+	private:
+		bool m_active;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ===========================
+#include "DerivedDataCache.h"
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include "../Core/Context.h"
+#include "../Core/Settings.h"
+#include "../FileSystem/FileSystem.h"
+#include "../IO/BinaryReader.h"
+#include "../IO/BinaryWriter.h"
+#include "../IO/ContentHash.h"
+#include "../Logging/Log.h"
+#include "../Threading/Threading.h"
+//======================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Directus
+{
+	DerivedDataCache::DerivedDataCache(Context* context)
+	{
+		m_context = context;
+		m_directory = "Cache//DerivedData//";
+		FileSystem::CreateDirectory_(m_directory);
+	}
+
+	DerivedDataCache::~DerivedDataCache()
+	{
+
+	}
+
+	bool DerivedDataCache::MakeKey(const string& sourceFilePath, uint64_t settings, uint32_t importerVersion, uint64_t& key)
+	{
+		uint64_t sourceHash = 0;
+		if (!ContentHash::ComputeFromFile(sourceFilePath, sourceHash, m_context->GetSubsystem<Threading>()))
+			return false;
+
+		key = ContentHash::Combine(ContentHash::Combine(sourceHash, settings), importerVersion);
+		return true;
+	}
+
+	string DerivedDataCache::GetFilePath(uint64_t key, const string& extension)
+	{
+		return m_directory + ContentHash::ToString(key) + extension;
+	}
+
+	bool DerivedDataCache::Contains(uint64_t key, const string& extension)
+	{
+		return FileSystem::FileExists(GetFilePath(key, extension));
+	}
+
+	bool DerivedDataCache::Load(uint64_t key, const string& extension, BinaryReader& reader)
+	{
+		string filePath = GetFilePath(key, extension);
+		if (!FileSystem::FileExists(filePath))
+			return false;
+
+		return reader.LoadFromFile(filePath, m_context->GetSubsystem<Threading>());
+	}
+
+	bool DerivedDataCache::Save(uint64_t key, const string& extension, BinaryWriter& writer)
+	{
+		string temporaryFilePath = GetTemporaryFilePath(key, extension);
+		if (!writer.SaveToFile(temporaryFilePath, Settings::GetCompressAssets(), m_context->GetSubsystem<Threading>()))
+			return false;
+
+		return Commit(temporaryFilePath, key, extension);
+	}
+
+	string DerivedDataCache::GetTemporaryFilePath(uint64_t key, const string& extension)
+	{
+		// Unique per thread, two imports of the same source may well run at the same time
+		size_t threadID = hash<thread::id>()(this_thread::get_id());
+		return GetFilePath(key, extension) + "." + to_string(threadID) + ".tmp";
+	}
+
+	bool DerivedDataCache::Commit(const string& temporaryFilePath, uint64_t key, const string& extension)
+	{
+		string filePath = GetFilePath(key, extension);
+		if (rename(temporaryFilePath.c_str(), filePath.c_str()) == 0)
+			return true;
+
+		// Renaming fails if another import committed the same entry first, which holds the same data
+		FileSystem::DeleteFile_(temporaryFilePath);
+		if (FileSystem::FileExists(filePath))
+			return true;
+
+		LOG_WARNING("DerivedDataCache: Failed to store \"" + filePath + "\".");
+		return false;
+	}
+}
\ No newline at end of file
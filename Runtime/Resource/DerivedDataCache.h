@@ -0,0 +1,66 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==============
+#include <cstdint>
+#include <string>
+#include "../Core/Helper.h"
+//=========================
+
+namespace Directus
+{
+	class Context;
+	class BinaryReader;
+	class BinaryWriter;
+
+	// What an importer derives from a source asset (decoded images, processed geometry, ...), stored on
+	// disk under a key made of the source's content hash, the import settings and the importer's version.
+	// An unchanged source is served from here instead of being imported again, a changed source, other
+	// settings or a new importer version all lead to a new key. Entries are written to a temporary file
+	// which is then renamed, so any number of threads can use the cache and a reader never sees half an entry.
+	class DLL_API DerivedDataCache
+	{
+	public:
+		DerivedDataCache(Context* context);
+		~DerivedDataCache();
+
+		// False if the source file can't be read
+		bool MakeKey(const std::string& sourceFilePath, uint64_t settings, uint32_t importerVersion, uint64_t& key);
+
+		// An entry can have several parts (e.g. ".model" and ".hierarchy"), told apart by their extension
+		std::string GetFilePath(uint64_t key, const std::string& extension);
+		bool Contains(uint64_t key, const std::string& extension);
+
+		bool Load(uint64_t key, const std::string& extension, BinaryReader& reader);
+		bool Save(uint64_t key, const std::string& extension, BinaryWriter& writer);
+
+		// For parts written by something else (e.g. Model::SaveToFile()), write to
+		// the temporary file path and then commit it to make it part of the entry
+		std::string GetTemporaryFilePath(uint64_t key, const std::string& extension);
+		bool Commit(const std::string& temporaryFilePath, uint64_t key, const std::string& extension);
+
+	private:
+		std::string m_directory;
+		Context* m_context;
+	};
+}
\ No newline at end of file
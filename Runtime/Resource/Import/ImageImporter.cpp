@@ -23,9 +23,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "ImageImporter.h"
 #include "../../Logging/Log.h"
 #include "../../FileSystem/FileSystem.h"
+#include "../../Core/Context.h"
+#include "../ResourceManager.h"
 #include "FreeImagePlus.h"
-#include <future>
-#include <functional>
 //======================================
 
 //= NAMESPACES =====
@@ -36,14 +36,8 @@ namespace Directus
 {
 	ImageImporter::ImageImporter()
 	{
-		m_bpp = 0;
-		m_width = 0;
-		m_height = 0;
-		m_path.clear();
-		m_channels = 4;
-		m_grayscale = false;
-		m_transparent = false;
 		m_isLoading = false;
+		m_context = nullptr;
 
 		FreeImage_Initialise(true);
 	}
@@ -54,10 +48,28 @@ namespace Directus
 		FreeImage_DeInitialise();
 	}
 
-	void ImageImporter::LoadAsync(const string& filePath)
+	bool ImageImporter::Initialize(Context* context)
 	{
-		m_path = filePath;
-		auto future = async(launch::async, [this] {return Load(m_path); });
+		m_context = context;
+		return true;
+	}
+
+	TaskHandle ImageImporter::LoadAsync(const string& filePath, TaskPriority priority)
+	{
+		// Without a context (e.g. a standalone importer) there is no thread pool to use
+		if (!m_context)
+		{
+			Load(filePath);
+			return TaskHandle();
+		}
+
+		ResourceManager* resourceMng = m_context->GetSubsystem<ResourceManager>();
+		CancellationToken token = resourceMng->GetLoadingToken(filePath);
+		return m_context->GetSubsystem<Threading>()->AddTask([this, resourceMng, filePath, token]
+		{
+			Load(filePath);
+			resourceMng->FinishLoading(filePath, token);
+		}, priority, token);
 	}
 
 	bool ImageImporter::Load(const string& path, int width, int height, bool scale, bool generateMipchain)
@@ -65,11 +77,17 @@ namespace Directus
 		m_isLoading = true;
 
 		Clear();
+		bool loaded = Load(path, width, height, scale, generateMipchain, m_image);
+
+		m_isLoading = false;
+		return loaded;
+	}
 
+	bool ImageImporter::Load(const string& path, int width, int height, bool scale, bool generateMipchain, ImageData& image)
+	{
 		if (!FileSystem::FileExists(path))
 		{
 			LOG_WARNING("Texture \"" + path + "\" doesn't exist.");
-			m_isLoading = false;
 			return false;
 		}
 
@@ -87,7 +105,6 @@ namespace Directus
 			if (!FreeImage_FIFSupportsReading(format))
 			{
 				LOG_WARNING("Failed to detect the image format.");
-				m_isLoading = false;
 				return false;
 			}
 
@@ -97,10 +114,7 @@ namespace Directus
 		// Get image format, format == -1 means the file was not found
 		// but I am checking against it also, just in case.
 		if (format == -1 || format == FIF_UNKNOWN)
-		{
-			m_isLoading = false;
 			return false;
-		}
 
 		// Create FIBITMAP pointers that will be used below
 		FIBITMAP* bitmapOriginal;
@@ -117,24 +131,24 @@ namespace Directus
 		bitmapScaled = scale ? FreeImage_Rescale(bitmapOriginal, width, height, FILTER_LANCZOS3) : bitmapOriginal;
 
 		// Convert it to 32 bits (if neccessery)
-		m_bpp = FreeImage_GetBPP(bitmapOriginal);
-		bitmap32 = m_bpp != 32 ? FreeImage_ConvertTo32Bits(bitmapScaled) : bitmapScaled;
+		image.bpp = FreeImage_GetBPP(bitmapOriginal);
+		bitmap32 = image.bpp != 32 ? FreeImage_ConvertTo32Bits(bitmapScaled) : bitmapScaled;
 
 		// Store some useful data	
-		m_transparent = bool(FreeImage_IsTransparent(bitmap32));
-		m_path = path;
-		m_width = FreeImage_GetWidth(bitmap32);
-		m_height = FreeImage_GetHeight(bitmap32);
+		image.transparent = bool(FreeImage_IsTransparent(bitmap32));
+		image.path = path;
+		image.width = FreeImage_GetWidth(bitmap32);
+		image.height = FreeImage_GetHeight(bitmap32);
 
 		// Fill RGBA vector with the data from the FIBITMAP
-		GetDataRGBAFromFIBITMAP(bitmap32, &m_dataRGBA);
+		GetDataRGBAFromFIBITMAP(bitmap32, &image.dataRGBA);
 
 		// Check if the image is grayscale
-		m_grayscale = GrayscaleCheck(m_dataRGBA, m_width, m_height);
+		image.grayscale = GrayscaleCheck(image.dataRGBA, image.width, image.height);
 
 		if (generateMipchain)
 		{
-			GenerateMipChainFromFIBITMAP(bitmap32, &m_mipchainDataRGBA);
+			GenerateMipChainFromFIBITMAP(bitmap32, image.dataRGBA, &image.mipchainDataRGBA);
 		}
 
 		//= Free memory =====================================
@@ -142,7 +156,7 @@ namespace Directus
 		FreeImage_Unload(bitmap32);
 
 		// unload the scaled bitmap only if it was converted
-		if (m_bpp != 32)
+		if (image.bpp != 32)
 			FreeImage_Unload(bitmapScaled);
 
 		// unload the non 32-bit bitmap only if it was scaled
@@ -150,22 +164,12 @@ namespace Directus
 			FreeImage_Unload(bitmapOriginal);
 		//====================================================
 
-		m_isLoading = false;
 		return true;
 	}
 
 	void ImageImporter::Clear()
 	{
-		m_dataRGBA.clear();
-		m_dataRGBA.shrink_to_fit();
-		m_mipchainDataRGBA.clear();
-		m_mipchainDataRGBA.shrink_to_fit();
-		m_bpp = 0;
-		m_width = 0;
-		m_height = 0;
-		m_path.clear();
-		m_grayscale = false;
-		m_transparent = false;
+		m_image = ImageData();
 	}
 
 	bool ImageImporter::GetDataRGBAFromFIBITMAP(FIBITMAP* fibtimap, vector<unsigned char>* data)
@@ -196,9 +200,9 @@ namespace Directus
 		return true;
 	}
 
-	void ImageImporter::GenerateMipChainFromFIBITMAP(FIBITMAP* original, vector<vector<unsigned char>>* mipchain)
+	void ImageImporter::GenerateMipChainFromFIBITMAP(FIBITMAP* original, const vector<unsigned char>& dataRGBA, vector<vector<unsigned char>>* mipchain)
 	{
-		mipchain->push_back(m_dataRGBA);
+		mipchain->push_back(dataRGBA);
 		int width = FreeImage_GetWidth(original);
 		int height = FreeImage_GetHeight(original);
 		int levels = 1;
@@ -223,25 +227,26 @@ namespace Directus
 
 	bool ImageImporter::GrayscaleCheck(const vector<unsigned char>& dataRGBA, int width, int height)
 	{
-		int grayPixels = 0;
-		int scannedPixels = 0;
-
-		for (int i = 0; i < height; i++)
-			for (int j = 0; j < width; j++)
-			{
-				scannedPixels++;
+		// Checks a range of rows, bails out on the first colored pixel
+		auto rowsAreGray = [&dataRGBA, width](size_t rowBegin, size_t rowEnd)
+		{
+			for (size_t i = rowBegin; i < rowEnd; i++)
+				for (int j = 0; j < width; j++)
+				{
+					int red = dataRGBA[(i * width + j) * 4 + 0];
+					int green = dataRGBA[(i * width + j) * 4 + 1];
+					int blue = dataRGBA[(i * width + j) * 4 + 2];
 
-				int red = dataRGBA[(i * width + j) * 4 + 0];
-				int green = dataRGBA[(i * width + j) * 4 + 1];
-				int blue = dataRGBA[(i * width + j) * 4 + 2];
+					if (red != green || red != blue)
+						return false;
+				}
 
-				if (red == green && red == blue)
-					grayPixels++;
-			}
-
-		if (grayPixels == scannedPixels)
 			return true;
+		};
+
+		if (!m_context)
+			return rowsAreGray(0, height);
 
-		return false;
+		return m_context->GetSubsystem<Threading>()->ParallelReduce(0, height, 64, true, rowsAreGray, [](bool a, bool b) { return a && b; });
 	}
 }
\ No newline at end of file
@@ -60,56 +60,73 @@ XPM files[reading, writing]
 
 #define FREEIMAGE_LIB
 
-//= INCLUDES =================
+//= INCLUDES ========================
 #include <vector>
 #include "../../Core/Helper.h"
-//============================
+#include "../../Threading/Threading.h"
+//===================================
 
 class FIBITMAP;
 
 namespace Directus
 {
+	// A decoded image, RGBA with 8 bits per channel
+	struct ImageData
+	{
+		std::vector<unsigned char> dataRGBA;
+		std::vector<std::vector<unsigned char>> mipchainDataRGBA;
+		unsigned int bpp = 0;
+		unsigned int width = 0;
+		unsigned int height = 0;
+		int channels = 4;
+		std::string path;
+		bool grayscale = false;
+		bool transparent = false;
+	};
+
 	class DLL_API ImageImporter
 	{
 	public:
 		ImageImporter();
 		~ImageImporter();
 
-		void LoadAsync(const std::string& filePath);
+		// Bump whenever what Load() produces changes, it invalidates the images in the DerivedDataCache
+		static const unsigned int VERSION = 1;
+
+		bool Initialize(Context* context);
+		// Can be cancelled through ResourceManager::CancelLoading()
+		TaskHandle LoadAsync(const std::string& filePath, TaskPriority priority = Priority_Normal);
 		bool Load(const std::string filePath) { return Load(filePath, 0, 0, false, false); }
 		bool Load(const std::string& filePath, int width, int height) { return Load(filePath, width, height, true, false); }
 		bool Load(const std::string& filePath, bool generateMipchain) { return Load(filePath, 0, 0, false, generateMipchain); }
 		bool Load(const std::string& filePath, int width, int height, bool scale, bool generateMipchain);
+		// Thread safe, decodes into the given image instead of the importer
+		bool Load(const std::string& filePath, bool generateMipchain, ImageData& image) { return Load(filePath, 0, 0, false, generateMipchain, image); }
 		
 		void Clear();
 
 		//= PROPERTIES ==================================================
-		unsigned char* GetRGBA() { return m_dataRGBA.data(); }
-		const std::vector<std::vector<unsigned char>>& GetRGBAMipChain() { return m_mipchainDataRGBA; }
-		unsigned int GetBPP() { return m_bpp; }
-		unsigned int GetWidth() { return m_width; }
-		unsigned int GetHeight() { return m_height; }
-		bool IsGrayscale() { return m_grayscale; }
-		bool IsTransparent() { return m_transparent; }
-		const std::string& GetPath() { return m_path; }
-		int GetChannels() { return m_channels; }
+		unsigned char* GetRGBA() { return m_image.dataRGBA.data(); }
+		const std::vector<std::vector<unsigned char>>& GetRGBAMipChain() { return m_image.mipchainDataRGBA; }
+		unsigned int GetBPP() { return m_image.bpp; }
+		unsigned int GetWidth() { return m_image.width; }
+		unsigned int GetHeight() { return m_image.height; }
+		bool IsGrayscale() { return m_image.grayscale; }
+		bool IsTransparent() { return m_image.transparent; }
+		const std::string& GetPath() { return m_image.path; }
+		int GetChannels() { return m_image.channels; }
+		const ImageData& GetImage() { return m_image; }
 		//===============================================================
 
 	private:
-		
+		bool Load(const std::string& filePath, int width, int height, bool scale, bool generateMipchain, ImageData& image);
 		bool GetDataRGBAFromFIBITMAP(FIBITMAP* fibtimap, std::vector<unsigned char>* data);
-		void GenerateMipChainFromFIBITMAP(FIBITMAP* original, std::vector<std::vector<unsigned char>>*);
+		void GenerateMipChainFromFIBITMAP(FIBITMAP* original, const std::vector<unsigned char>& dataRGBA, std::vector<std::vector<unsigned char>>*);
 		bool GrayscaleCheck(const std::vector<unsigned char>& dataRGBA, int width, int height);
 
-		std::vector<unsigned char> m_dataRGBA;
-		std::vector<std::vector<unsigned char>> m_mipchainDataRGBA;
-		unsigned int m_bpp;
-		unsigned int m_width;
-		unsigned int m_height;
-		int m_channels;
-		std::string m_path;
-		bool m_grayscale;
-		bool m_transparent;
-		bool m_isLoading;	
+		ImageData m_image;
+		bool m_isLoading;
+
+		Context* m_context;
 	};
 }
\ No newline at end of file
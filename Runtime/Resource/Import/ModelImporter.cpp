@@ -35,7 +35,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Logging/Log.h"
 #include "../../Resource/ResourceManager.h"
 #include "../../Graphics/Model.h"
-#include <future>
 //=================================================
 
 //= NAMESPACES ================
@@ -52,6 +51,7 @@ namespace Directus
 		m_context = nullptr;
 		m_isLoading = false;
 		m_model = nullptr;
+		m_token = nullptr;
 	}
 
 	ModelImporter::~ModelImporter()
@@ -64,14 +64,36 @@ namespace Directus
 		return true;
 	}
 
-	void ModelImporter::LoadAsync(Model* model, const string& filePath)
+	TaskHandle ModelImporter::LoadAsync(Model* model, const string& filePath)
 	{
-		m_model = model;
-		m_modelPath = filePath;
-		auto future = async(launch::async, [this] {return Load(m_model, m_modelPath); });
+		if (!m_context)
+		{
+			LOG_ERROR("Aborting loading. ModelImporter requires an initialized Context");
+			return TaskHandle();
+		}
+
+		CancellationToken token = m_context->GetSubsystem<ResourceManager>()->GetLoadingToken(filePath);
+		return m_context->GetSubsystem<Threading>()->AddTask([this, model, filePath, token]
+		{
+			// Build the hierarchy off to the side, it joins the scene at the next frame boundary
+			Scene* scene = m_context->GetSubsystem<Scene>();
+			scene->BeginStaging();
+			Load(model, filePath, &token);
+
+			// A half finished hierarchy never makes it to the scene
+			if (token.IsCancelled())
+			{
+				scene->DiscardStaging();
+			}
+			else
+			{
+				scene->CommitStaging();
+			}
+			m_context->GetSubsystem<ResourceManager>()->FinishLoading(filePath, token);
+		}, Priority_Normal, token);
 	}
 
-	bool ModelImporter::Load(Model* model, const string& filePath)
+	bool ModelImporter::Load(Model* model, const string& filePath, const CancellationToken* token)
 	{
 		if (!m_context)
 		{
@@ -81,6 +103,7 @@ namespace Directus
 
 		m_model = model;
 		m_modelPath = filePath;
+		m_token = token;
 		m_isLoading = true;
 
 		// Set up Assimp importer
@@ -122,6 +145,7 @@ namespace Directus
 		ProcessNode(model, scene, scene->mRootNode, weakGameObj(), weakGameObj());
 		importer.FreeScene();
 		m_isLoading = false;
+		m_token = nullptr;
 
 		return true;
 	}
@@ -176,6 +200,9 @@ namespace Directus
 	//= PROCESSING ===============================================================================
 	void ModelImporter::ProcessNode(Model* model, const aiScene* assimpScene, aiNode* assimpNode, weak_ptr<GameObject> parentNode, weak_ptr<GameObject> newNode)
 	{
+		if (m_token && m_token->IsCancelled())
+			return;
+
 		if (newNode.expired())
 			newNode = m_context->GetSubsystem<Scene>()->CreateGameObject();
 
@@ -280,7 +307,7 @@ namespace Directus
 		}
 
 		// Add a mesh component and pass the data
-		weak_ptr<Mesh> mesh = model->AddMesh(gameobject._Get()->GetID(), assimpMesh->mName.C_Str(), vertices, indices);
+		weak_ptr<Mesh> mesh = model->AddMesh(to_string(gameobject._Get()->GetID()), assimpMesh->mName.C_Str(), vertices, indices);
 		MeshFilter* meshFilter = gameobject._Get()->AddComponent<MeshFilter>();
 		meshFilter->SetMesh(mesh);
 
@@ -21,10 +21,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
-//= INCLUDES ======================
+//= INCLUDES ========================
 #include "../../Graphics/Texture.h"
 #include "../../Graphics/Model.h"
-//=================================
+#include "../../Threading/Threading.h"
+//====================================
 
 struct aiNode;
 struct aiScene;
@@ -44,9 +45,14 @@ namespace Directus
 		ModelImporter();
 		~ModelImporter();
 
+		// Bump whenever what Load() produces changes, it invalidates the models in the DerivedDataCache
+		static const unsigned int VERSION = 1;
+
 		bool Initialize(Context* context);
-		void LoadAsync(Model* model, const std::string& filePath);
-		bool Load(Model* model, const std::string& filePath);
+		// Can be cancelled through ResourceManager::CancelLoading()
+		TaskHandle LoadAsync(Model* model, const std::string& filePath);
+		// Stops processing nodes as soon as the token (if any) gets cancelled
+		bool Load(Model* model, const std::string& filePath, const CancellationToken* token = nullptr);
 
 	private:
 		// PROCESSING
@@ -62,6 +68,7 @@ namespace Directus
 		bool m_isLoading;
 		Model* m_model;
 		std::string m_modelPath;
+		const CancellationToken* m_token;
 		
 		Context* m_context;
 	};
@@ -39,9 +39,24 @@ namespace Directus
 		Shader_Resource,
 		Model_Resource,
 		Cubemap_Resource,
-		Script_Resource
+		Script_Resource,
+		Prefab_Resource
 	};
 
+	class Texture;
+	class Material;
+	class ShaderVariation;
+	class Model;
+	class Prefab;
+
+	// The ResourceType of a resource class, for the queries by type
+	template <class T> struct ResourceTypeOf;
+	template <> struct ResourceTypeOf<Texture> { static const ResourceType value = Texture_Resource; };
+	template <> struct ResourceTypeOf<Material> { static const ResourceType value = Material_Resource; };
+	template <> struct ResourceTypeOf<ShaderVariation> { static const ResourceType value = Shader_Resource; };
+	template <> struct ResourceTypeOf<Model> { static const ResourceType value = Model_Resource; };
+	template <> struct ResourceTypeOf<Prefab> { static const ResourceType value = Prefab_Resource; };
+
 	class DLL_API Resource
 	{
 	public:
@@ -66,6 +81,15 @@ namespace Directus
 		virtual bool SaveToFile(const std::string& filePath) = 0;
 		virtual bool LoadFromFile(const std::string& filePath) = 0;
 
+		// Loading in two steps, see ResourceManager::LoadAsync(). The file is read and decoded on a worker,
+		// then whatever needs the graphics device is created on the main thread.
+		virtual bool DecodeFromFile(const std::string& filePath) { return LoadFromFile(filePath); }
+		virtual bool FinalizeLoad() { return true; }
+
+		// Approximate memory footprint in bytes, what counts against the memory budgets
+		virtual unsigned long long GetMemoryUsageCPU() { return 0; }
+		virtual unsigned long long GetMemoryUsageGPU() { return 0; }
+
 	protected:
 		std::string m_resourceID = DATA_NOT_ASSIGNED;	
 		std::string m_resourceName = DATA_NOT_ASSIGNED;
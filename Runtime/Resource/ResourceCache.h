@@ -18,29 +18,115 @@ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
 IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
-
 #pragma once
 
 //= INCLUDES ==============
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <mutex>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include "Resource.h"
 #include "../Logging/Log.h"
 //========================
 
 namespace Directus
 {
+	// Cached resources, in the order they were added. A list is a snapshot which stays valid and unchanged
+	// while the cache is modified, taking one doesn't copy or allocate anything. All resources of a list
+	// are of type T, see ResourceCache::GetByType().
+	template <class T>
+	class ResourceList
+	{
+	public:
+		typedef std::vector<std::shared_ptr<Resource>> Resources;
+
+		class Iterator
+		{
+		public:
+			Iterator(Resources::const_iterator it) : m_it(it) {}
+			std::shared_ptr<T> operator*() const { return std::static_pointer_cast<T>(*m_it); }
+			Iterator& operator++() { ++m_it; return *this; }
+			bool operator!=(const Iterator& other) const { return m_it != other.m_it; }
+
+		private:
+			Resources::const_iterator m_it;
+		};
+
+		ResourceList(std::shared_ptr<const Resources> resources) : m_resources(std::move(resources)) {}
+
+		Iterator begin() const { return Iterator(m_resources->begin()); }
+		Iterator end() const { return Iterator(m_resources->end()); }
+		size_t size() const { return m_resources->size(); }
+		bool empty() const { return m_resources->empty(); }
+
+	private:
+		std::shared_ptr<const Resources> m_resources;
+	};
+
+	// What the resources of a type cost, see ResourceCache::GetStats()
+	struct ResourceMemoryStats
+	{
+		int resourceCount = 0;
+		unsigned long long memoryCPU = 0;
+		unsigned long long memoryGPU = 0;
+		unsigned long long budget = 0; // bytes, 0 means unlimited
+		int evictions = 0;
+		int reloads = 0;
+	};
+
+	// Thread safe, resources are loaded (and looked up) from the workers too. Lookups by ID, name and
+	// file path are hashed. The keys are indexed when a resource is added, so they should be set by then.
+	// The memory footprint of a resource is taken when it's added and refreshed before anything is evicted.
 	class DLL_API ResourceCache
 	{
 	public:
-		ResourceCache() {}
+		typedef ResourceList<Resource>::Resources Resources;
+
+		ResourceCache() : m_resources(std::make_shared<Resources>()) {}
 		~ResourceCache() { Unload(); }
 
 		// Unloads all resources
 		void Unload()
 		{
-			m_resources.clear();
-			m_resources.shrink_to_fit();
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_resources = std::make_shared<Resources>();
+			m_resourcesByType.clear();
+			m_residency.clear();
+			for (auto& stats : m_stats)
+			{
+				stats.second.resourceCount = 0;
+				stats.second.memoryCPU = 0;
+				stats.second.memoryGPU = 0;
+			}
+			m_generation++;
+			Reindex();
+		}
+
+		// Unloads all resources except the ones with the given file paths
+		void UnloadExcept(const std::vector<std::string>& filePaths)
+		{
+			std::unordered_set<std::string> keep(filePaths.begin(), filePaths.end());
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			Remove([&keep](const std::shared_ptr<Resource>& resource)
+			{
+				return keep.find(resource->GetResourceFilePath()) == keep.end();
+			});
+		}
+
+		// Unloads the resources with the given file paths
+		void Unload(const std::vector<std::string>& filePaths)
+		{
+			std::unordered_set<std::string> unload(filePaths.begin(), filePaths.end());
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			Remove([&unload](const std::shared_ptr<Resource>& resource)
+			{
+				return unload.find(resource->GetResourceFilePath()) != unload.end();
+			});
 		}
 
 		// Adds a resource
@@ -49,14 +135,20 @@ namespace Directus
 			if (!resource)
 				return;
 
-			m_resources.push_back(resource);
+			std::lock_guard<std::mutex> lock(m_mutex);
+			Writable(m_resources).push_back(resource);
+			Writable(m_resourcesByType[resource->GetResourceType()]).push_back(resource);
+			Index(resource);
+			Track(resource);
 		}
 
 		// Returns the file paths of all the resources
 		std::vector<std::string> GetResourceFilePaths()
 		{
+			std::lock_guard<std::mutex> lock(m_mutex);
 			std::vector<std::string> filePaths;
-			for (const auto& resource : m_resources)
+			filePaths.reserve(m_resources->size());
+			for (const auto& resource : *m_resources)
 			{
 				filePaths.push_back(resource->GetResourceFilePath());
 			}
@@ -67,52 +159,55 @@ namespace Directus
 		// Returns a resource by ID
 		std::shared_ptr<Resource> GetByID(const std::string& ID)
 		{
-			for (const auto& resource : m_resources)
-			{
-				if (resource->GetResourceID() == ID)
-					return resource;
-			}
-
-			return std::shared_ptr<Resource>();
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return Touch(Find(m_byID, ID, &Resource::GetResourceID));
 		}
 
 		// Returns a resource by name
 		std::shared_ptr<Resource> GetByName(const std::string& name)
 		{
-			for (const auto& resource : m_resources)
-			{
-				if (resource->GetResourceName() == name)
-					return resource;
-			}
-
-			return std::shared_ptr<Resource>();
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return Touch(Find(m_byName, name, &Resource::GetResourceName));
 		}
 
 		// Returns a resource by file path
 		std::shared_ptr<Resource> GetByPath(const std::string& filePath)
 		{
-			for (const auto& resource : m_resources)
-			{
-				if (resource->GetResourceFilePath() == filePath)
-					return resource;
-			}
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return Touch(Find(m_byPath, filePath, &Resource::GetResourceFilePath));
+		}
+
+		// Returns the resources of a type, the order in which they were added is kept
+		template <class T>
+		ResourceList<T> GetByType(ResourceType type)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = m_resourcesByType.find(type);
+			if (it == m_resourcesByType.end())
+				return ResourceList<T>(GetEmpty());
 
-			return std::shared_ptr<Resource>();
+			return ResourceList<T>(it->second);
 		}
 
 		// Makes the resources save their metadata
 		void SaveResourceMetadata()
 		{
-			for (const auto& resource : m_resources)
+			// Saving can take a while, it happens on a snapshot so that the cache stays usable
+			for (const auto& resource : GetAll())
 			{
 				resource->SaveToFile(RESOURCE_SAVE);
 			}
+
+			// Saving may have given resources new file paths
+			std::lock_guard<std::mutex> lock(m_mutex);
+			Reindex();
 		}
 
 		// Returns all the resources
-		std::vector<std::shared_ptr<Resource>> GetAll()
+		ResourceList<Resource> GetAll()
 		{
-			return m_resources;
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return ResourceList<Resource>(m_resources);
 		}
 
 		// Checks whether a resource is already in the cache
@@ -121,13 +216,7 @@ namespace Directus
 			if (filePath.empty())
 				return false;
 
-			for (const auto& resource : m_resources)
-			{
-				if (resource->GetResourceFilePath() == filePath)
-					return true;
-			}
-
-			return false;
+			return GetByPath(filePath) != nullptr;
 		}
 
 		// Checks whether a resource is already in the cache
@@ -136,13 +225,7 @@ namespace Directus
 			if (!resourceIn)
 				return false;
 
-			for (const auto& resource : m_resources)
-			{
-				if (resource->GetResourceID() == resourceIn->GetResourceID())
-					return true;
-			}
-
-			return false;
+			return GetByID(resourceIn->GetResourceID()) != nullptr;
 		}
 
 		// Checks whether a resource is already in the cache
@@ -156,16 +239,308 @@ namespace Directus
 				LOG_INFO("CachedByName() might fail as no name has been assigned to the resource");
 			}
 
-			for (const auto& resource : m_resources)
+			return GetByName(resourceIn->GetResourceName()) != nullptr;
+		}
+
+		//= MEMORY BUDGETS ========================================================================
+		void SetBudget(ResourceType type, unsigned long long bytes)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stats[type].budget = bytes;
+			m_generation++;
+		}
+
+		unsigned long long GetBudget(ResourceType type)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = m_stats.find(type);
+			return it != m_stats.end() ? it->second.budget : 0;
+		}
+
+		ResourceMemoryStats GetStats(ResourceType type)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = m_stats.find(type);
+			return it != m_stats.end() ? it->second : ResourceMemoryStats();
+		}
+
+		void RecordReload(ResourceType type)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stats[type].reloads++;
+		}
+
+		// Whether a type exceeds its budget. Once an eviction couldn't get everything under budget,
+		// this stays false until resources come or go, so that nobody retries it every frame.
+		bool IsOverBudget()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_generation == m_exhaustedGeneration)
+				return false;
+
+			for (const auto& stats : m_stats)
 			{
-				if (resource->GetResourceName() == resourceIn->GetResourceName())
+				if (IsOverBudget(stats.second))
 					return true;
 			}
 
 			return false;
 		}
 
+		// Removes resources of the types which exceed their budget, least recently used first, until
+		// they fit. Only resources nothing outside the cache holds, and canEvict() agrees to, are removed.
+		// canEvict() is called with the mutex locked. The evicted resources are returned, they are
+		// destroyed when the caller lets go of them.
+		template <typename Predicate>
+		std::vector<std::shared_ptr<Resource>> Evict(Predicate canEvict)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			Measure();
+
+			std::unordered_set<const Resource*> evict;
+			std::vector<std::shared_ptr<Resource>> evicted;
+			bool exhausted = false;
+			for (const auto& bucket : m_resourcesByType)
+			{
+				ResourceMemoryStats& stats = m_stats[bucket.first];
+				if (!IsOverBudget(stats))
+					continue;
+
+				std::vector<const std::shared_ptr<Resource>*> candidates;
+				candidates.reserve(bucket.second->size());
+				for (const auto& resource : *bucket.second)
+				{
+					candidates.push_back(&resource);
+				}
+				std::sort(candidates.begin(), candidates.end(), [this](const std::shared_ptr<Resource>* a, const std::shared_ptr<Resource>* b)
+				{
+					return m_residency[a->get()].lastUsed < m_residency[b->get()].lastUsed;
+				});
+
+				unsigned long long used = stats.memoryCPU + stats.memoryGPU;
+				for (const auto* candidate : candidates)
+				{
+					if (used <= stats.budget)
+						break;
+
+					const std::shared_ptr<Resource>& resource = *candidate;
+					if (resource.use_count() > CacheReferences(resource) || !canEvict(resource))
+						continue;
+
+					const Residency& residency = m_residency[resource.get()];
+					used -= std::min(used, residency.memoryCPU + residency.memoryGPU);
+					evict.insert(resource.get());
+					evicted.push_back(resource);
+					stats.evictions++;
+				}
+				exhausted = exhausted || used > stats.budget;
+			}
+
+			if (!evict.empty())
+			{
+				Remove([&evict](const std::shared_ptr<Resource>& resource)
+				{
+					return evict.find(resource.get()) != evict.end();
+				});
+			}
+
+			if (exhausted)
+			{
+				m_exhaustedGeneration = m_generation;
+			}
+
+			return evicted;
+		}
+		//========================================================================================
+
 	private:
-		std::vector<std::shared_ptr<Resource>> m_resources;
+		typedef std::unordered_map<std::string, std::shared_ptr<Resource>> ResourceIndex;
+
+		struct Residency
+		{
+			unsigned long long lastUsed = 0;
+			unsigned long long memoryCPU = 0;
+			unsigned long long memoryGPU = 0;
+		};
+
+		// Called with the mutex locked. A key which changed after the resource was added is
+		// caught when it's hit, then the indices are rebuilt from the current keys.
+		std::shared_ptr<Resource> Find(ResourceIndex& index, const std::string& key, std::string& (Resource::*getKey)())
+		{
+			auto it = index.find(key);
+			if (it != index.end() && ((*it->second).*getKey)() != key)
+			{
+				Reindex();
+				it = index.find(key);
+			}
+
+			return it != index.end() ? it->second : std::shared_ptr<Resource>();
+		}
+
+		// Called with the mutex locked. The first resource added with a key is the one found.
+		void Index(const std::shared_ptr<Resource>& resource)
+		{
+			m_byID.emplace(resource->GetResourceID(), resource);
+			m_byName.emplace(resource->GetResourceName(), resource);
+			m_byPath.emplace(resource->GetResourceFilePath(), resource);
+		}
+
+		// Called with the mutex locked
+		void Track(const std::shared_ptr<Resource>& resource)
+		{
+			Residency& residency = m_residency[resource.get()];
+			residency.lastUsed = ++m_clock;
+			residency.memoryCPU = resource->GetMemoryUsageCPU();
+			residency.memoryGPU = resource->GetMemoryUsageGPU();
+
+			ResourceMemoryStats& stats = m_stats[resource->GetResourceType()];
+			stats.resourceCount++;
+			stats.memoryCPU += residency.memoryCPU;
+			stats.memoryGPU += residency.memoryGPU;
+			m_generation++;
+		}
+
+		// Called with the mutex locked
+		void Forget(const std::shared_ptr<Resource>& resource)
+		{
+			auto it = m_residency.find(resource.get());
+			if (it == m_residency.end())
+				return;
+
+			ResourceMemoryStats& stats = m_stats[resource->GetResourceType()];
+			stats.resourceCount--;
+			stats.memoryCPU -= std::min(stats.memoryCPU, it->second.memoryCPU);
+			stats.memoryGPU -= std::min(stats.memoryGPU, it->second.memoryGPU);
+			m_residency.erase(it);
+			m_generation++;
+		}
+
+		// Called with the mutex locked
+		std::shared_ptr<Resource> Touch(std::shared_ptr<Resource> resource)
+		{
+			if (resource)
+			{
+				auto it = m_residency.find(resource.get());
+				if (it != m_residency.end())
+				{
+					it->second.lastUsed = ++m_clock;
+				}
+			}
+
+			return resource;
+		}
+
+		// Called with the mutex locked. Footprints can change after a resource was added.
+		void Measure()
+		{
+			for (auto& stats : m_stats)
+			{
+				stats.second.memoryCPU = 0;
+				stats.second.memoryGPU = 0;
+			}
+
+			for (const auto& resource : *m_resources)
+			{
+				Residency& residency = m_residency[resource.get()];
+				residency.memoryCPU = resource->GetMemoryUsageCPU();
+				residency.memoryGPU = resource->GetMemoryUsageGPU();
+
+				ResourceMemoryStats& stats = m_stats[resource->GetResourceType()];
+				stats.memoryCPU += residency.memoryCPU;
+				stats.memoryGPU += residency.memoryGPU;
+			}
+		}
+
+		// Called with the mutex locked. How many references to the resource the cache holds itself,
+		// lists handed out which still share a resource vector only ever add to the count.
+		long CacheReferences(const std::shared_ptr<Resource>& resource)
+		{
+			long count = 2; // m_resources and the type's list
+			count += IsIndexed(m_byID, resource->GetResourceID(), resource) ? 1 : 0;
+			count += IsIndexed(m_byName, resource->GetResourceName(), resource) ? 1 : 0;
+			count += IsIndexed(m_byPath, resource->GetResourceFilePath(), resource) ? 1 : 0;
+
+			return count;
+		}
+
+		static bool IsIndexed(const ResourceIndex& index, const std::string& key, const std::shared_ptr<Resource>& resource)
+		{
+			auto it = index.find(key);
+			return it != index.end() && it->second == resource;
+		}
+
+		static bool IsOverBudget(const ResourceMemoryStats& stats)
+		{
+			return stats.budget != 0 && stats.memoryCPU + stats.memoryGPU > stats.budget;
+		}
+
+		// Called with the mutex locked
+		void Reindex()
+		{
+			m_byID.clear();
+			m_byName.clear();
+			m_byPath.clear();
+			for (const auto& resource : *m_resources)
+			{
+				Index(resource);
+			}
+		}
+
+		// Called with the mutex locked, keeps the order of the remaining resources
+		template <typename Predicate>
+		void Remove(Predicate remove)
+		{
+			Resources& resources = Writable(m_resources);
+			resources.erase(std::remove_if(resources.begin(), resources.end(), [this, &remove](const std::shared_ptr<Resource>& resource)
+			{
+				if (!remove(resource))
+					return false;
+
+				Forget(resource);
+				return true;
+			}), resources.end());
+			for (auto& bucket : m_resourcesByType)
+			{
+				Resources& typed = Writable(bucket.second);
+				typed.erase(std::remove_if(typed.begin(), typed.end(), remove), typed.end());
+			}
+			Reindex();
+		}
+
+		// Called with the mutex locked. Lists handed out are never modified, a resource vector
+		// which is still referenced by one is copied first (copy on write).
+		static Resources& Writable(std::shared_ptr<Resources>& resources)
+		{
+			if (!resources)
+			{
+				resources = std::make_shared<Resources>();
+			}
+			else if (resources.use_count() > 1)
+			{
+				resources = std::make_shared<Resources>(*resources);
+			}
+
+			return *resources;
+		}
+
+		static const std::shared_ptr<Resources>& GetEmpty()
+		{
+			static std::shared_ptr<Resources> empty = std::make_shared<Resources>();
+			return empty;
+		}
+
+		std::shared_ptr<Resources> m_resources;
+		std::map<ResourceType, std::shared_ptr<Resources>> m_resourcesByType;
+		ResourceIndex m_byID;
+		ResourceIndex m_byName;
+		ResourceIndex m_byPath;
+
+		std::unordered_map<const Resource*, Residency> m_residency;
+		std::map<ResourceType, ResourceMemoryStats> m_stats;
+		unsigned long long m_clock = 0;
+		// Bumped whenever resources come or go, or a budget changes
+		unsigned long long m_generation = 0;
+		unsigned long long m_exhaustedGeneration = ~0ull;
+		std::mutex m_mutex;
 	};
 }
\ No newline at end of file
@@ -19,10 +19,13 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ==================
+//= INCLUDES ======================
 #include "ResourceManager.h"
 #include "../Core/GameObject.h"
-//=============================
+#include "../Core/Settings.h"
+#include "../FileSystem/FileSystem.h"
+#include "Import/ImageImporter.h"
+//==================================
 
 //= NAMESPACES ================
 using namespace std;
@@ -31,6 +34,9 @@ using namespace Directus::Math;
 
 namespace Directus
 {
+	// Finalizing creates GPU resources, a scene's worth of them would stall the frame
+	static const int MAX_FINALIZED_LOADS_PER_FRAME = 16;
+
 	ResourceManager::ResourceManager(Context* context) : Subsystem(context)
 	{
 		m_resourceCache = nullptr;
@@ -43,7 +49,9 @@ namespace Directus
 		m_resourceCache = make_unique<ResourceCache>();
 
 		// Importers
+		m_derivedDataCache = make_unique<DerivedDataCache>(m_context);
 		m_imageImporter = make_shared<ImageImporter>();
+		m_imageImporter->Initialize(m_context);
 		m_modelImporter = make_shared<ModelImporter>();
 		m_modelImporter->Initialize(m_context);
 		
@@ -56,6 +64,339 @@ namespace Directus
 		AddResourceDirectory(Model_Resource, "Standard Assets//Models//");
 		AddResourceDirectory(Material_Resource, "Standard Assets//Materials//");
 
+		// Memory budgets
+		const unsigned long long megabyte = 1024 * 1024;
+		SetMemoryBudget(Texture_Resource, Settings::GetTextureMemoryBudgetMB() * megabyte);
+		SetMemoryBudget(Model_Resource, Settings::GetModelMemoryBudgetMB() * megabyte);
+		SetMemoryBudget(Material_Resource, Settings::GetMaterialMemoryBudgetMB() * megabyte);
+
+		return true;
+	}
+
+	void ResourceManager::Unload()
+	{
+		{
+			lock_guard<mutex> lock(m_referencesMutex);
+			m_references.clear();
+		}
+		{
+			lock_guard<mutex> lock(m_evictedMutex);
+			m_evictedPaths.clear();
+			m_evictedIDs.clear();
+		}
+		m_resourceCache->Unload();
+	}
+
+	void ResourceManager::UnloadExcept(const vector<string>& filePaths)
+	{
+		{
+			lock_guard<mutex> lock(m_referencesMutex);
+			m_references.clear();
+		}
+		{
+			lock_guard<mutex> lock(m_evictedMutex);
+			m_evictedPaths.clear();
+			m_evictedIDs.clear();
+		}
+		m_resourceCache->UnloadExcept(filePaths);
+	}
+
+	bool ResourceManager::AcquireResources(const vector<string>& filePaths, const CancellationToken* token)
+	{
+		// Checked under the lock, so that an acquisition can't slip in after the references were dropped
+		lock_guard<mutex> lock(m_referencesMutex);
+		if (token && token->IsCancelled())
+			return false;
+
+		for (const auto& filePath : filePaths)
+		{
+			m_references[filePath]++;
+		}
+
+		return true;
+	}
+
+	void ResourceManager::ReleaseResources(const vector<string>& filePaths)
+	{
+		// The resources are unloaded under the lock too, or a concurrent acquisition could lose them
+		lock_guard<mutex> lock(m_referencesMutex);
+		vector<string> unreferenced;
+		for (const auto& filePath : filePaths)
+		{
+			auto it = m_references.find(filePath);
+			if (it == m_references.end())
+				continue;
+
+			if (--it->second <= 0)
+			{
+				unreferenced.push_back(filePath);
+				m_references.erase(it);
+			}
+		}
+
+		if (!unreferenced.empty())
+		{
+			m_resourceCache->Unload(unreferenced);
+		}
+	}
+
+	void ResourceManager::AddLoaded(const string& filePath, const shared_ptr<Resource>& resource)
+	{
+		m_resourceCache->Add(resource);
+		if (ForgetEvicted(filePath))
+		{
+			m_resourceCache->RecordReload(resource->GetResourceType());
+		}
+
+		// Loads also happen on worker threads, so the event is posted
+		if (EventSystem::HasSubscribers<ResourceLoadedEvent>())
+		{
+			EventSystem::Post(ResourceLoadedEvent{ filePath, resource });
+		}
+	}
+
+	shared_ptr<AsyncLoad> ResourceManager::FindLoad(const string& filePath)
+	{
+		shared_ptr<Resource> resource = m_resourceCache->GetByPath(filePath);
+		if (resource)
+		{
+			auto load = make_shared<AsyncLoad>();
+			load->filePath = filePath;
+			load->resource = resource;
+			load->state = AsyncLoad_Ready;
+			return load;
+		}
+
+		lock_guard<mutex> lock(m_loadsMutex);
+		auto it = m_loads.find(filePath);
+		if (it == m_loads.end() || it->second->token.IsCancelled())
+			return nullptr;
+
+		return it->second;
+	}
+
+	shared_ptr<AsyncLoad> ResourceManager::StartLoad(const string& filePath, shared_ptr<Resource> resource, TaskPriority priority)
+	{
+		auto load = make_shared<AsyncLoad>();
+		load->filePath = filePath;
+		load->token = GetLoadingToken(filePath);
+		load->loading = move(resource);
+		load->state = AsyncLoad_Loading;
+		shared_ptr<AsyncLoad> inFlight;
+		{
+			// Somebody may have started the same load meanwhile. A cancelled load is replaced, it only has yet to notice.
+			lock_guard<mutex> lock(m_loadsMutex);
+			auto& slot = m_loads[filePath];
+			if (slot && !slot->token.IsCancelled())
+			{
+				inFlight = slot;
+			}
+			else
+			{
+				slot = load;
+			}
+		}
+
+		// Joined, the load in flight holds the token on its own
+		if (inFlight)
+		{
+			FinishLoading(filePath, load->token);
+			return inFlight;
+		}
+
+		// The token is checked by the task itself, a task that got skipped would leave the load hanging
+		m_context->GetSubsystem<Threading>()->AddTask([this, load]
+		{
+			if (load->token.IsCancelled() || !load->loading->DecodeFromFile(load->filePath))
+			{
+				if (!load->token.IsCancelled())
+				{
+					LOG_WARNING("Resource \"" + load->filePath + "\" failed to load");
+				}
+				ResolveLoad(load, nullptr);
+				return;
+			}
+
+			lock_guard<mutex> lock(m_loadsMutex);
+			m_decodedLoads.push_back(load);
+		}, vector<TaskHandle>(), priority, nullptr);
+
+		return load;
+	}
+
+	void ResourceManager::FinalizeLoads()
+	{
+		for (int i = 0; i < MAX_FINALIZED_LOADS_PER_FRAME; i++)
+		{
+			shared_ptr<AsyncLoad> load;
+			{
+				lock_guard<mutex> lock(m_loadsMutex);
+				if (m_decodedLoads.empty())
+					return;
+
+				load = move(m_decodedLoads.front());
+				m_decodedLoads.pop_front();
+			}
+
+			if (load->token.IsCancelled())
+			{
+				ResolveLoad(load, nullptr);
+				continue;
+			}
+
+			// A synchronous Load() may have got there first
+			shared_ptr<Resource> resource = m_resourceCache->GetByPath(load->filePath);
+			if (!resource)
+			{
+				if (!load->loading->FinalizeLoad())
+				{
+					LOG_WARNING("Resource \"" + load->filePath + "\" failed to load");
+					ResolveLoad(load, nullptr);
+					continue;
+				}
+
+				resource = load->loading;
+				AddLoaded(load->filePath, resource);
+			}
+
+			ResolveLoad(load, resource);
+		}
+	}
+
+	void ResourceManager::ResolveLoad(const shared_ptr<AsyncLoad>& load, const shared_ptr<Resource>& resource)
+	{
+		{
+			lock_guard<mutex> lock(m_loadsMutex);
+			auto it = m_loads.find(load->filePath);
+			if (it != m_loads.end() && it->second == load)
+			{
+				m_loads.erase(it);
+			}
+		}
+
+		// An evicted file which fails to load again isn't retried every time it's asked for
+		if (!resource && !load->token.IsCancelled())
+		{
+			ForgetEvicted(load->filePath);
+		}
+
+		// What didn't make it into the cache goes now
+		load->resource = resource;
+		load->loading.reset();
+		load->state.store(resource ? AsyncLoad_Ready : AsyncLoad_Failed, memory_order_release);
+
+		FinishLoading(load->filePath, load->token);
+	}
+
+	const shared_ptr<Texture>& ResourceManager::GetPlaceholderTexture(TextureType type)
+	{
+		auto& placeholder = m_placeholderTextures[type];
+		if (placeholder)
+			return placeholder;
+
+		// A single texel which leaves the material as it is
+		unsigned char texel[4] = { 255, 255, 255, 255 };
+		switch (type)
+		{
+		case Normal_Texture:
+			texel[0] = 128; texel[1] = 128;
+			break;
+		case Metallic_Texture:
+		case Height_Texture:
+		case Emission_Texture:
+		case CubeMap_Texture:
+			texel[0] = texel[1] = texel[2] = 0;
+			break;
+		default:
+			break;
+		}
+
+		ImageData image;
+		image.dataRGBA.assign(texel, texel + 4);
+		image.width = 1;
+		image.height = 1;
+		image.path = "Placeholder";
+
+		placeholder = make_shared<Texture>(m_context);
+		placeholder->LoadFromImage(image);
+
+		return placeholder;
+	}
+
+	bool ResourceManager::IsOverMemoryBudget()
+	{
+		{
+			lock_guard<mutex> lock(m_loadingMutex);
+			if (!m_loadingTokens.empty())
+				return false;
+		}
+
+		return m_resourceCache->IsOverBudget();
+	}
+
+	int ResourceManager::EnforceMemoryBudgets(const unordered_set<string>& filePathsInUse)
+	{
+		// A copy, the cache asks about every candidate with its own mutex locked
+		unordered_set<string> referenced;
+		{
+			lock_guard<mutex> lock(m_referencesMutex);
+			for (const auto& reference : m_references)
+			{
+				referenced.insert(reference.first);
+			}
+		}
+
+		auto evicted = m_resourceCache->Evict([&filePathsInUse, &referenced](const shared_ptr<Resource>& resource)
+		{
+			// Shaders are compiled per material and cost next to nothing, scripts keep state
+			ResourceType type = resource->GetResourceType();
+			if (type != Texture_Resource && type != Model_Resource && type != Material_Resource && type != Prefab_Resource)
+				return false;
+
+			const string& filePath = resource->GetResourceFilePath();
+			if (filePath == DATA_NOT_ASSIGNED || filePathsInUse.count(filePath) || referenced.count(filePath))
+				return false;
+
+			// Generated resources can't be loaded again
+			return FileSystem::FileExists(filePath);
+		});
+
+		if (evicted.empty())
+			return 0;
+
+		lock_guard<mutex> lock(m_evictedMutex);
+		for (const auto& resource : evicted)
+		{
+			m_evictedPaths[resource->GetResourceFilePath()] = resource->GetResourceID();
+			m_evictedIDs[resource->GetResourceID()] = resource->GetResourceFilePath();
+		}
+		LOG_INFO("Evicted " + to_string(evicted.size()) + " resources to stay within the memory budgets.");
+
+		return (int)evicted.size();
+	}
+
+	bool ResourceManager::WasEvicted(const string& filePath)
+	{
+		lock_guard<mutex> lock(m_evictedMutex);
+		return m_evictedPaths.find(filePath) != m_evictedPaths.end();
+	}
+
+	string ResourceManager::GetEvictedPath(const string& ID)
+	{
+		lock_guard<mutex> lock(m_evictedMutex);
+		auto it = m_evictedIDs.find(ID);
+		return it != m_evictedIDs.end() ? it->second : string();
+	}
+
+	bool ResourceManager::ForgetEvicted(const string& filePath)
+	{
+		lock_guard<mutex> lock(m_evictedMutex);
+		auto it = m_evictedPaths.find(filePath);
+		if (it == m_evictedPaths.end())
+			return false;
+
+		m_evictedIDs.erase(it->second);
+		m_evictedPaths.erase(it);
 		return true;
 	}
 
@@ -74,4 +415,44 @@ namespace Directus
 
 		return DATA_NOT_ASSIGNED;
 	}
+
+	CancellationToken ResourceManager::GetLoadingToken(const string& filePath)
+	{
+		lock_guard<mutex> lock(m_loadingMutex);
+		LoadingToken& loadingToken = m_loadingTokens[filePath];
+		loadingToken.users++;
+		return loadingToken.token;
+	}
+
+	void ResourceManager::CancelLoading(const string& filePath)
+	{
+		lock_guard<mutex> lock(m_loadingMutex);
+		auto it = m_loadingTokens.find(filePath);
+		if (it == m_loadingTokens.end())
+			return;
+
+		// Any later work for this path gets a fresh token
+		it->second.token.Cancel();
+		m_loadingTokens.erase(it);
+	}
+
+	void ResourceManager::CancelAllLoading()
+	{
+		lock_guard<mutex> lock(m_loadingMutex);
+		for (auto& loadingToken : m_loadingTokens)
+		{
+			loadingToken.second.token.Cancel();
+		}
+		m_loadingTokens.clear();
+	}
+
+	void ResourceManager::FinishLoading(const string& filePath, const CancellationToken& token)
+	{
+		lock_guard<mutex> lock(m_loadingMutex);
+		auto it = m_loadingTokens.find(filePath);
+		if (it != m_loadingTokens.end() && it->second.token == token && --it->second.users <= 0)
+		{
+			m_loadingTokens.erase(it);
+		}
+	}
 }
\ No newline at end of file
@@ -24,16 +24,70 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ====================
 #include <memory>
 #include <map>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <type_traits>
 #include "../Core/SubSystem.h"
 #include "ResourceCache.h"
+#include "DerivedDataCache.h"
 #include "../Graphics/Mesh.h"
+#include "../Graphics/Texture.h"
 #include "../Core/GameObject.h"
 #include "Import/ModelImporter.h"
 #include "Import/ImageImporter.h"
+#include "../Profiling/Profiler.h"
+#include "../EventSystem/EventSystem.h"
 //===============================
 
 namespace Directus
 {
+	//= ASYNC LOADING =========================================================================
+	enum AsyncLoadState
+	{
+		AsyncLoad_Loading,
+		AsyncLoad_Ready,
+		AsyncLoad_Failed
+	};
+
+	// Shared by everybody that asked for the same file while it was loading
+	struct AsyncLoad
+	{
+		std::string filePath;
+		CancellationToken token;
+		std::shared_ptr<Resource> loading; // until it's finalized
+		std::weak_ptr<Resource> resource; // once it's ready, the cache owns it
+		std::atomic<int> state;
+	};
+
+	// What ResourceManager::LoadAsync() returns, the resource is available once it's ready
+	template <class T>
+	class AsyncResource
+	{
+	public:
+		AsyncResource() {}
+		AsyncResource(std::shared_ptr<AsyncLoad> load) : m_load(std::move(load)) {}
+
+		bool IsReady() const { return m_load && m_load->state.load(std::memory_order_acquire) == AsyncLoad_Ready; }
+		bool HasFailed() const { return !m_load || m_load->state.load(std::memory_order_acquire) == AsyncLoad_Failed; }
+		bool IsDone() const { return !m_load || m_load->state.load(std::memory_order_acquire) != AsyncLoad_Loading; }
+
+		// Empty until the resource is ready
+		std::weak_ptr<T> Get() const
+		{
+			if (!IsReady())
+				return std::weak_ptr<T>();
+
+			return std::dynamic_pointer_cast<T>(m_load->resource.lock());
+		}
+
+	private:
+		std::shared_ptr<AsyncLoad> m_load;
+	};
+	//=========================================================================================
+
 	class DLL_API ResourceManager : public Subsystem
 	{
 	public:
@@ -44,8 +98,11 @@ namespace Directus
 		virtual bool Initialize();
 		//========================
 
-		// Unloads all resources
-		void Unload() { m_resourceCache->Unload(); }
+		// Unloads all resources, their references go with them
+		void Unload();
+
+		// Unloads all resources except the ones with the given file paths, all references are dropped
+		void UnloadExcept(const std::vector<std::string>& filePaths);
 
 		// Loads a resource and adds it to the resource cache
 		template <class T>
@@ -55,22 +112,43 @@ namespace Directus
 			if (m_resourceCache->CachedByFilePath(filePath))
 				return GetResourceByPath<T>(filePath);
 
+			PROFILE_SCOPE(filePath);
 			std::shared_ptr<T> derivedResource = std::make_shared<T>(m_context);
 			std::shared_ptr<Resource> resource = ToBaseResourceShared(derivedResource);
 
 			if (resource->LoadFromFile(filePath))
 			{
-				m_resourceCache->Add(resource);
+				AddLoaded(filePath, resource);
 			}
 			else
 			{
 				LOG_WARNING("Resource \"" + filePath + "\" failed to load");
 			}
 
-			auto typedResource = GetResourceByPath<T>(filePath);
-			return typedResource;
+			return ToDerivedResourceWeak<T>(m_resourceCache->GetByPath(filePath));
+		}
+
+		// Returns at once, the file is read and decoded on a worker and the resource is finalized (e.g.
+		// its GPU resources created) on the main thread, see FinalizeLoads(). Asking for a file that's
+		// already loading joins that load. Can be cancelled through CancelLoading().
+		template <class T>
+		AsyncResource<T> LoadAsync(const std::string& filePath, TaskPriority priority = Priority_Normal)
+		{
+			std::shared_ptr<AsyncLoad> load = FindLoad(filePath);
+			if (!load)
+			{
+				load = StartLoad(filePath, ToBaseResourceShared(std::make_shared<T>(m_context)), priority);
+			}
+
+			return AsyncResource<T>(load);
 		}
 
+		// Main thread only, once per frame. Finalizes a few of the resources which finished decoding.
+		void FinalizeLoads();
+
+		// Main thread only. Stands in for a texture of the given type while it loads.
+		const std::shared_ptr<Texture>& GetPlaceholderTexture(TextureType type);
+
 		// Adds a resource into the resource cache
 		template <class T>
 		std::weak_ptr<T> Add(std::shared_ptr<T> resource)
@@ -89,42 +167,40 @@ namespace Directus
 			return resource;
 		}
 
-		// Returns cached resource by ID
+		// Returns cached resource by ID, one that was evicted is loaded again
 		template <class T>
 		std::weak_ptr<T> GetResourceByID(const std::string& ID)
 		{
 			std::shared_ptr<Resource> baseResource = m_resourceCache->GetByID(ID);
+			if (!baseResource)
+			{
+				std::string filePath = GetEvictedPath(ID);
+				if (!filePath.empty())
+					return ReloadEvicted<T>(filePath);
+			}
+
 			std::weak_ptr<T> derivedResource = ToDerivedResourceWeak<T>(baseResource);
 
 			return derivedResource;
 		}
 
-		// Returns cached resource by Path
+		// Returns cached resource by Path, one that was evicted is loaded again
 		template <class T>
 		std::weak_ptr<T> GetResourceByPath(const std::string& filePath)
 		{
 			std::shared_ptr<Resource> resource = m_resourceCache->GetByPath(filePath);
-			auto typedResource = ToDerivedResourceWeak<T>(resource);
+			if (!resource && WasEvicted(filePath))
+				return ReloadEvicted<T>(filePath);
 
 			return ToDerivedResourceWeak<T>(resource);
 		}
 
-		// Returns cached resource by Type
+		// Returns cached resources by Type, in the order they were cached. The list is a
+		// snapshot, getting it doesn't allocate, so it's fine to do every frame.
 		template <class T>
-		std::vector<std::weak_ptr<T>> GetResourcesByType()
+		ResourceList<T> GetResourcesByType()
 		{
-			std::vector<std::weak_ptr<T>> typedResources;
-			for (const auto& resource : m_resourceCache->GetAll())
-			{
-				std::weak_ptr<T> typedResource = ToDerivedResourceWeak<T>(resource);
-				bool validCasting = !typedResource.expired();
-
-				if (validCasting)
-				{
-					typedResources.push_back(typedResource);
-				}
-			}
-			return typedResources;
+			return m_resourceCache->GetByType<T>(ResourceTypeOf<T>::value);
 		}
 
 		void SaveResourceMetadata()
@@ -140,17 +216,101 @@ namespace Directus
 		void AddResourceDirectory(ResourceType type, const std::string& directory);
 		std::string GetResourceDirectory(ResourceType type);
 
+		//= REFERENCES ===========================================================================
+		// Parts of the scene that come and go (streamed cells) hold references to the resources
+		// they use, a resource is unloaded when its last reference is released. Resources which
+		// were never referenced aren't affected. Acquiring fails if the token has been cancelled.
+		bool AcquireResources(const std::vector<std::string>& filePaths, const CancellationToken* token = nullptr);
+		void ReleaseResources(const std::vector<std::string>& filePaths);
+		//========================================================================================
+
+		//= MEMORY BUDGETS =======================================================================
+		// Resources of a type are evicted, least recently used first, while their footprint exceeds
+		// the budget of the type (in bytes, 0 means unlimited). Only resources which can be loaded
+		// from their file again are evicted, they are reloaded when they are asked for again.
+		void SetMemoryBudget(ResourceType type, unsigned long long bytes) { m_resourceCache->SetBudget(type, bytes); }
+		unsigned long long GetMemoryBudget(ResourceType type) { return m_resourceCache->GetBudget(type); }
+		ResourceMemoryStats GetMemoryStats(ResourceType type) { return m_resourceCache->GetStats(type); }
+		// False while anything loads in the background, what it loads isn't in use yet
+		bool IsOverMemoryBudget();
+		// Evicts what the budgets call for, except the resources with the given file paths (the ones
+		// in use) and referenced ones. Returns how many resources were evicted.
+		int EnforceMemoryBudgets(const std::unordered_set<std::string>& filePathsInUse);
+		//========================================================================================
+
+		//= BACKGROUND LOADING ===================================================================
+		// The token shared by all the background work for the given path, each call has to be
+		// matched by a FinishLoading() once that work is done (or has been cancelled)
+		CancellationToken GetLoadingToken(const std::string& filePath);
+		// Cancels all the pending background work for the given path
+		void CancelLoading(const std::string& filePath);
+		void CancelAllLoading();
+		// Forgets the token once all the work which got it is done, unless it has been replaced meanwhile
+		void FinishLoading(const std::string& filePath, const CancellationToken& token);
+		//========================================================================================
+
 		// Importers
 		const std::weak_ptr<ModelImporter>& GetModelImporter() { return m_modelImporter; }
 		const std::weak_ptr<ImageImporter>& GetImageImporter() { return m_imageImporter; }
 
+		// What the importers derived from source assets, see DerivedDataCache
+		DerivedDataCache* GetDerivedDataCache() { return m_derivedDataCache.get(); }
+
 	private:
 		std::unique_ptr<ResourceCache> m_resourceCache;
 		std::map<ResourceType, std::string> m_resourceDirectories;
 
+		struct LoadingToken
+		{
+			CancellationToken token;
+			int users = 0; // GetLoadingToken() calls yet to be matched by FinishLoading()
+		};
+		std::map<std::string, LoadingToken> m_loadingTokens;
+		std::mutex m_loadingMutex;
+
+		std::map<std::string, int> m_references;
+		std::mutex m_referencesMutex;
+
+		// Evicted resources, by file path and by ID, until they are loaded again
+		std::unordered_map<std::string, std::string> m_evictedPaths;
+		std::unordered_map<std::string, std::string> m_evictedIDs;
+		std::mutex m_evictedMutex;
+
+		// Loads in flight by file path, and the ones waiting to be finalized
+		std::unordered_map<std::string, std::shared_ptr<AsyncLoad>> m_loads;
+		std::deque<std::shared_ptr<AsyncLoad>> m_decodedLoads;
+		std::mutex m_loadsMutex;
+
+		std::map<TextureType, std::shared_ptr<Texture>> m_placeholderTextures;
+
+		// Caches a resource which loaded from the given file
+		void AddLoaded(const std::string& filePath, const std::shared_ptr<Resource>& resource);
+		std::shared_ptr<AsyncLoad> FindLoad(const std::string& filePath);
+		std::shared_ptr<AsyncLoad> StartLoad(const std::string& filePath, std::shared_ptr<Resource> resource, TaskPriority priority);
+		void ResolveLoad(const std::shared_ptr<AsyncLoad>& load, const std::shared_ptr<Resource>& resource);
+
+		// A texture is finalized on the GPU, which only the main thread can do and which would stall it mid-frame,
+		// so it comes back through LoadAsync() and the caller goes without (e.g. a placeholder) until it's ready
+		template <class T>
+		std::weak_ptr<T> ReloadEvicted(const std::string& filePath)
+		{
+			if (std::is_same<T, Texture>::value)
+			{
+				LoadAsync<T>(filePath);
+				return std::weak_ptr<T>();
+			}
+
+			return Load<T>(filePath);
+		}
+
+		bool WasEvicted(const std::string& filePath);
+		std::string GetEvictedPath(const std::string& ID);
+		bool ForgetEvicted(const std::string& filePath);
+
 		// Importers
 		std::shared_ptr<ModelImporter> m_modelImporter;
 		std::shared_ptr<ImageImporter> m_imageImporter;
+		std::unique_ptr<DerivedDataCache> m_derivedDataCache;
 
 		// Derived -> Resource (as a shared pointer)
 		template <class T>
@@ -28,6 +28,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Logging/Log.h"
 #include "../Core/GameObject.h"
 #include "../Graphics/Shaders/DeferredShader.h"
+#include "../Profiling/Profiler.h"
 //===================================
 
 //= NAMESPACES =====
@@ -44,6 +45,7 @@ namespace Directus
 		m_scriptObject = nullptr;
 		m_module = nullptr;
 		m_scriptEngine = nullptr;
+		m_profilerName = "Script";
 		m_isInstantiated = false;
 	}
 
@@ -73,8 +75,9 @@ namespace Directus
 		m_scriptPath = path;
 		m_gameObject = gameObject;
 		m_className = FileSystem::GetFileNameNoExtensionFromFilePath(m_scriptPath);
-		m_moduleName = m_className + m_gameObject.lock()->GetID();
+		m_moduleName = m_className + to_string(m_gameObject.lock()->GetID());
 		m_constructorDeclaration = m_className + " @" + m_className + "(GameObject @)";
+		m_profilerName = Profiler::Intern("Script " + m_className);
 
 		// Instantiate the script
 		m_isInstantiated = CreateScriptObject();
@@ -84,11 +87,13 @@ namespace Directus
 
 	void ScriptInstance::ExecuteStart()
 	{
+		PROFILE_SCOPE(m_profilerName);
 		m_scriptEngine->ExecuteCall(m_startFunction, m_scriptObject);
 	}
 
 	void ScriptInstance::ExecuteUpdate()
 	{
+		PROFILE_SCOPE(m_profilerName);
 		m_scriptEngine->ExecuteCall(m_updateFunction, m_scriptObject);
 	}
 
@@ -54,6 +54,7 @@ namespace Directus
 		std::string m_className;
 		std::string m_constructorDeclaration;
 		std::string m_moduleName;
+		const char* m_profilerName;
 		std::weak_ptr<GameObject> m_gameObject;
 		std::shared_ptr<Module> m_module;
 		asIScriptObject* m_scriptObject;
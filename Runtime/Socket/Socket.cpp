@@ -28,6 +28,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Resource/ResourceManager.h"
 #include "../Resource/Import/ImageImporter.h"
 #include "../Resource/Import/ModelImporter.h"
+#include "../Threading/Threading.h"
+#include "../Profiling/Profiler.h"
 //===========================================
 
 //= NAMESPACES =====
@@ -41,6 +43,8 @@ namespace Directus
 	Socket::Socket(Context* context) : Subsystem(context)
 	{
 		m_engine = nullptr;
+		m_lastWorkerBusyMs = 0.0;
+		m_lastWorkerElapsedMs = 0.0;
 	}
 
 	Socket::~Socket()
@@ -160,7 +164,7 @@ namespace Directus
 		return m_context->GetSubsystem<Scene>()->GetRootGameObjects();
 	}
 
-	weakGameObj Socket::GetGameObjectByID(string gameObjectID)
+	weakGameObj Socket::GetGameObjectByID(unsigned long long gameObjectID)
 	{
 		return m_context->GetSubsystem<Scene>()->GetGameObjectByID(gameObjectID);
 	}
@@ -211,5 +215,47 @@ namespace Directus
 	{
 		return m_context->GetSubsystem<Timer>()->GetDeltaTime();
 	}
+
+	vector<WorkerStats> Socket::GetThreadingStats()
+	{
+		return m_context->GetSubsystem<Threading>()->GetWorkerStats();
+	}
+
+	float Socket::GetWorkerUtilization()
+	{
+		vector<WorkerStats> stats = GetThreadingStats();
+		if (stats.size() < 2)
+			return 0.0f;
+
+		// The last entry is for threads which are not workers
+		double busyMs = 0.0;
+		for (size_t i = 0; i < stats.size() - 1; i++)
+		{
+			busyMs += stats[i].busyMs;
+		}
+		double elapsedMs = stats[0].elapsedMs * (stats.size() - 1);
+
+		double deltaBusy = busyMs - m_lastWorkerBusyMs;
+		double deltaElapsed = elapsedMs - m_lastWorkerElapsedMs;
+		m_lastWorkerBusyMs = busyMs;
+		m_lastWorkerElapsedMs = elapsedMs;
+
+		return deltaElapsed > 0.0 ? (float)(deltaBusy / deltaElapsed) : 0.0f;
+	}
+
+	void Socket::SetThreadingStatsFile(const string& filePath)
+	{
+		m_context->GetSubsystem<Threading>()->SetStatsFilePath(filePath);
+	}
+
+	void Socket::SetProfilerEnabled(bool enabled)
+	{
+		Profiler::SetEnabled(enabled);
+	}
+
+	bool Socket::SaveProfilerTrace(const string& filePath)
+	{
+		return Profiler::SaveTrace(filePath);
+	}
 	//==============================================================================
 }
\ No newline at end of file
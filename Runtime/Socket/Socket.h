@@ -31,6 +31,7 @@ namespace Directus
 	class Engine;
 	class GameObject;
 	class ImageImporter;
+	struct WorkerStats;
 
 	class DLL_API Socket : public Subsystem
 	{
@@ -74,7 +75,7 @@ namespace Directus
 		//= GAMEOBJECTS ======================================================
 		std::vector<std::shared_ptr<GameObject>> GetAllGameObjects();
 		std::vector<std::weak_ptr<GameObject>> GetRootGameObjects();
-		std::weak_ptr<GameObject> GetGameObjectByID(std::string gameObjectID);
+		std::weak_ptr<GameObject> GetGameObjectByID(unsigned long long gameObjectID);
 		int GetGameObjectCount();
 		void DestroyGameObject(std::weak_ptr<GameObject> gameObject);
 		bool GameObjectExists(std::weak_ptr<GameObject> gameObject);
@@ -85,9 +86,18 @@ namespace Directus
 		int GetRenderTime();
 		int GetRenderedMeshesCount();
 		float GetDeltaTime();
+		std::vector<WorkerStats> GetThreadingStats();
+		// Average worker utilization (0-1) since the last call
+		float GetWorkerUtilization();
+		void SetThreadingStatsFile(const std::string& filePath);
+		void SetProfilerEnabled(bool enabled);
+		// Writes the last few profiled frames as a Chrome trace
+		bool SaveProfilerTrace(const std::string& filePath);
 		//======================================================
 
 	private:
 		Engine* m_engine;
+		double m_lastWorkerBusyMs;
+		double m_lastWorkerElapsedMs;
 	};
 }
\ No newline at end of file
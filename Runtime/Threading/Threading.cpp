@@ -19,9 +19,16 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ==============
+//= INCLUDES ========================
 #include "Threading.h"
-//=========================
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include "../FileSystem/FileSystem.h"
+#include "../Logging/Log.h"
+#include "../Profiling/Profiler.h"
+//===================================
 
 //= NAMESPACES ======
 using namespace  std;
@@ -29,9 +36,145 @@ using namespace  std;
 
 namespace Directus
 {
-	Threading::Threading(Context* context) : Subsystem(context)
+	// Index of the worker running on this thread, -1 for any other thread
+	static thread_local int t_workerIndex = -1;
+
+	// Priority of the task running on this thread, a thread outside of any task is as urgent as it gets
+	static thread_local TaskPriority t_taskPriority = Priority_Critical;
+
+	// Max tasks a worker moves from the shared queue to its own deque at once,
+	// this keeps it from hitting the shared mutex for every single task.
+	static const int SHARED_QUEUE_BATCH = 16;
+
+	static int64_t Now()
+	{
+		return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	//= TASK POOL ========================================================================
+	// Tasks are carved out of blocks that live as long as the process. Every thread keeps
+	// a cache of free tasks, a cache that grows too big (e.g. a worker releasing tasks the
+	// main thread allocated) hands a batch over to the shared list, where it can be picked
+	// up by a thread that ran dry.
+	static const int TASK_BLOCK_SIZE = 256;
+	static const int TASK_CACHE_MAX = 512;
+	static const int TASK_CACHE_BATCH = 256;
+
+	struct TaskPool
+	{
+		mutex freeMutex;
+		vector<Task*> free;
+		vector<unique_ptr<Task[]>> blocks;
+	};
+
+	static TaskPool& GetTaskPool()
+	{
+		static TaskPool pool;
+		return pool;
+	}
+
+	struct TaskCache
 	{
+		vector<Task*> free;
 
+		// Give everything back when the thread exits
+		~TaskCache()
+		{
+			TaskPool& pool = GetTaskPool();
+			lock_guard<mutex> lock(pool.freeMutex);
+			pool.free.insert(pool.free.end(), free.begin(), free.end());
+		}
+	};
+	static thread_local TaskCache t_taskCache;
+
+	Task::Task()
+	{
+		m_invoke = nullptr;
+		m_destroy = nullptr;
+		m_refCount = 0;
+		m_unfinishedDependencies = 0;
+		m_done = false;
+	}
+
+	Task::~Task()
+	{
+		ResetFunction();
+	}
+
+	Task* Task::Allocate()
+	{
+		vector<Task*>& cache = t_taskCache.free;
+		if (cache.empty())
+		{
+			TaskPool& pool = GetTaskPool();
+			lock_guard<mutex> lock(pool.freeMutex);
+
+			if (pool.free.empty())
+			{
+				pool.blocks.emplace_back(new Task[TASK_BLOCK_SIZE]);
+				Task* block = pool.blocks.back().get();
+				for (int i = 0; i < TASK_BLOCK_SIZE; i++)
+				{
+					cache.push_back(&block[i]);
+				}
+			}
+			else
+			{
+				size_t count = min(pool.free.size(), (size_t)TASK_CACHE_BATCH);
+				cache.insert(cache.end(), pool.free.end() - count, pool.free.end());
+				pool.free.resize(pool.free.size() - count);
+			}
+		}
+
+		Task* task = cache.back();
+		cache.pop_back();
+
+		task->m_priority = Priority_Normal;
+		task->m_refCount.store(0, memory_order_relaxed);
+		task->m_unfinishedDependencies.store(0, memory_order_relaxed);
+		task->m_done.store(false, memory_order_relaxed);
+
+		return task;
+	}
+
+	void Task::Free(Task* task)
+	{
+		// Normally gone already, unless the task never ran
+		task->ResetFunction();
+		task->m_dependents.clear();
+		task->m_cancelled.reset();
+
+		vector<Task*>& cache = t_taskCache.free;
+		cache.push_back(task);
+
+		if (cache.size() > TASK_CACHE_MAX)
+		{
+			TaskPool& pool = GetTaskPool();
+			lock_guard<mutex> lock(pool.freeMutex);
+			pool.free.insert(pool.free.end(), cache.end() - TASK_CACHE_BATCH, cache.end());
+			cache.resize(cache.size() - TASK_CACHE_BATCH);
+		}
+	}
+	//====================================================================================
+
+	Threading::Threading(Context* context, int threadCount) : Subsystem(context)
+	{
+		// Leave a core for the main thread
+		int hardwareThreads = (int)thread::hardware_concurrency();
+		m_threadCount = threadCount > 0 ? threadCount : max(hardwareThreads - 1, 1);
+		m_mainThreadID = this_thread::get_id();
+
+		m_pendingTasks = 0;
+		m_sleepingThreads = 0;
+		m_stopping = false;
+		for (auto& count : m_taskCounts)
+		{
+			count = 0;
+		}
+
+		// The extra slot is for threads which are not workers
+		m_counters = make_unique<WorkerCounters[]>(m_threadCount + 1);
+		ResetStats();
 	}
 
 	Threading::~Threading()
@@ -53,45 +196,454 @@ namespace Directus
 			thread.join();
 
 		// Empty workers vector.
-		m_threads.empty();
+		m_threads.clear();
+		m_workerQueues.clear();
+
+		if (!m_statsFilePath.empty())
+		{
+			SaveStats(m_statsFilePath);
+		}
 	}
 
 	bool Threading::Initialize()
 	{
+		// Create all the deques before any thread starts stealing from them
+		for (int i = 0; i < m_threadCount * Priority_Count; i++)
+		{
+			m_workerQueues.emplace_back(make_unique<WorkStealingQueue<Task>>());
+		}
+
 		for (int i = 0; i < m_threadCount; i++)
 		{
-			m_threads.emplace_back(thread(&Threading::Invoke, this));
+			m_threads.emplace_back(thread(&Threading::Invoke, this, i));
 		}
 
 		return true;
 	}
 
-	void Threading::Invoke()
+	void Threading::Invoke(int workerIndex)
 	{
-		shared_ptr<Task> task;
+		t_workerIndex = workerIndex;
+		Profiler::SetThreadName("Worker " + to_string(workerIndex));
+
 		while (true)
 		{
-			// Lock tasks mutex
-			unique_lock<mutex> lock(m_tasksMutex);
+			// Execute the task.
+			if (Task* task = Acquire(workerIndex))
+			{
+				Run(task);
+				continue;
+			}
 
-			// Check condition on notification
-			m_conditionVar.wait(lock, [this] { return !m_tasks.empty() || m_stopping; });
+			// Nothing to do, go to sleep until a task gets added
+			int64_t sleepStart = Now();
+			unique_lock<mutex> lock(m_tasksMutex);
+			m_sleepingThreads++;
+			m_conditionVar.wait(lock, [this] { return m_pendingTasks > 0 || m_stopping; });
+			m_sleepingThreads--;
+			GetCounters(workerIndex).sleepNs.fetch_add(Now() - sleepStart, memory_order_relaxed);
 
 			// If m_stopping is true, it's time to shut everything down
-			if (m_stopping && m_tasks.empty())
+			if (m_stopping && m_pendingTasks == 0)
 				return;
+		}
+	}
 
-			// Get next task in the queue.
-			task = m_tasks.front();
+	TaskPriority Threading::GetCallerPriority()
+	{
+		return t_taskPriority;
+	}
 
-			// Remove it from the queue.
-			m_tasks.pop();
+	void TaskHandle::Wait() const
+	{
+		if (!m_task || !m_threading)
+			return;
 
-			// Unlock the mutex
-			lock.unlock();
+		m_threading->Wait(*this);
+	}
 
-			// Execute the task.
+	void Threading::WaitAll(const vector<TaskHandle>& tasks)
+	{
+		for (const auto& task : tasks)
+		{
+			Wait(task);
+		}
+	}
+
+	void Threading::Wait(const TaskHandle& handle)
+	{
+		// Workers help with anything. Other threads (e.g. the main thread in the middle of a frame) only
+		// help with work as urgent as what they wait for, a background load could take far longer.
+		int lastLane = Priority_Count - 1;
+		if (t_workerIndex == -1 && handle.m_task)
+		{
+			lastLane = handle.m_task->m_priority;
+		}
+
+		while (!handle.IsDone())
+		{
+			// Help out instead of blocking, this also prevents workers
+			// that wait on each other from starving the pool.
+			if (Task* task = Acquire(t_workerIndex, lastLane))
+			{
+				Run(task);
+				continue;
+			}
+
+			// Nothing to help with, block until some task completes. The timeout covers
+			// tasks added after we checked, as adding a task doesn't notify waiters.
+			int64_t waitStart = Now();
+			unique_lock<mutex> lock(m_waitMutex);
+			m_waitingThreads++;
+			m_waitVar.wait_for(lock, chrono::milliseconds(1), [&handle] { return handle.IsDone(); });
+			m_waitingThreads--;
+			GetCounters(t_workerIndex).waitNs.fetch_add(Now() - waitStart, memory_order_relaxed);
+		}
+	}
+
+	void Threading::Schedule(Task* task, const vector<TaskHandle>& dependencies)
+	{
+		// The extra count keeps the task from being queued
+		// while we are still registering it with its dependencies.
+		task->m_unfinishedDependencies = (int)dependencies.size() + 1;
+
+		for (const auto& dependency : dependencies)
+		{
+			Task* prerequisite = dependency.m_task;
+			if (prerequisite)
+			{
+				lock_guard<mutex> lock(prerequisite->m_dependentsMutex);
+				if (!prerequisite->IsDone())
+				{
+					task->AddRef();
+					prerequisite->m_dependents.push_back(task);
+					continue;
+				}
+			}
+
+			// Invalid or already finished
+			task->m_unfinishedDependencies--;
+		}
+
+		if (--task->m_unfinishedDependencies == 0)
+		{
+			Enqueue(task);
+		}
+	}
+
+	void Threading::Enqueue(Task* task)
+	{
+		// The queued task holds a reference until it has run
+		task->AddRef();
+		task->m_enqueueTime = Now();
+
+		// Count the task before it becomes visible, a thief
+		// must never be able to decrement ahead of us.
+		m_pendingTasks++;
+
+		// Workers push to their own deque, no locking involved
+		int lane = task->m_priority;
+		if (t_workerIndex != -1 && GetQueue(t_workerIndex, lane)->Push(task))
+		{
+			UpdatePeak(GetCounters(t_workerIndex).peakQueueDepth, GetQueue(t_workerIndex, lane)->Size());
+			Wake();
+			return;
+		}
+
+		// Lock tasks mutex
+		unique_lock<mutex> lock(m_tasksMutex);
+
+		// Save the task
+		m_tasks[lane].push(task);
+		m_taskCounts[lane]++;
+		UpdatePeak(GetCounters(-1).peakQueueDepth, (int)m_tasks[lane].size());
+
+		// Unlock the mutex
+		lock.unlock();
+
+		// Wake up a thread
+		m_conditionVar.notify_one();
+	}
+
+	void Threading::Run(Task* task)
+	{
+		WorkerCounters& counters = GetCounters(t_workerIndex);
+		int64_t start = Now();
+		int64_t latency = start - task->m_enqueueTime;
+
+		// Cancelled before it got to run, it still completes so that dependents and waiters move on
+		if (!task->m_cancelled || !task->m_cancelled->load(memory_order_acquire))
+		{
+			PROFILE_SCOPE("Task");
+			TaskPriority callerPriority = t_taskPriority;
+			t_taskPriority = task->m_priority;
 			task->Execute();
+			t_taskPriority = callerPriority;
+		}
+		task->ResetFunction();
+
+		// Bucket by the highest set bit of the latency in microseconds
+		int bucket = 0;
+		for (int64_t us = latency / 1000; us > 0 && bucket < LATENCY_BUCKETS - 1; us >>= 1)
+		{
+			bucket++;
+		}
+		counters.tasksExecuted.fetch_add(1, memory_order_relaxed);
+		counters.busyNs.fetch_add(Now() - start, memory_order_relaxed);
+		counters.latencyNs.fetch_add(latency, memory_order_relaxed);
+		counters.latencyHistogram[bucket].fetch_add(1, memory_order_relaxed);
+
+		// Mark as done under the lock, so that Schedule() can't register a dependent
+		// that we never release. Nobody touches the list once the task is done.
+		{
+			lock_guard<mutex> lock(task->m_dependentsMutex);
+			task->m_done.store(true, memory_order_release);
+		}
+
+		for (Task* dependent : task->m_dependents)
+		{
+			if (--dependent->m_unfinishedDependencies == 0)
+			{
+				Enqueue(dependent);
+			}
+			dependent->Release();
+		}
+		task->m_dependents.clear();
+
+		// Release anybody blocked in Wait()
+		if (m_waitingThreads > 0)
+		{
+			{ lock_guard<mutex> lock(m_waitMutex); }
+			m_waitVar.notify_all();
 		}
+
+		// Drop the queue's reference
+		task->Release();
+	}
+
+	Task* Threading::Acquire(int workerIndex, int lastLane)
+	{
+		Task* task = nullptr;
+		for (int lane = 0; lane <= lastLane && !task; lane++)
+		{
+			// 1. Own deque (LIFO, the most recent task is the most likely to be in cache).
+			// Threads which are not workers (helping from Wait()) have no deque of their own.
+			task = workerIndex != -1 ? GetQueue(workerIndex, lane)->Pop() : nullptr;
+
+			// 2. Shared queue
+			if (!task)
+			{
+				task = AcquireShared(workerIndex, lane);
+			}
+
+			// 3. Other workers
+			if (!task)
+			{
+				task = Steal(workerIndex, lane);
+			}
+		}
+
+		if (task)
+		{
+			m_pendingTasks--;
+		}
+
+		return task;
+	}
+
+	Task* Threading::AcquireShared(int workerIndex, int lane)
+	{
+		if (m_taskCounts[lane] == 0)
+			return nullptr;
+
+		// Grab a batch so that other workers can steal from us
+		WorkStealingQueue<Task>* ownQueue = workerIndex != -1 ? GetQueue(workerIndex, lane) : nullptr;
+		Task* task = nullptr;
+
+		unique_lock<mutex> lock(m_tasksMutex);
+		queue<Task*>& tasks = m_tasks[lane];
+		for (int i = 0; i < SHARED_QUEUE_BATCH && !tasks.empty(); i++)
+		{
+			Task* sharedTask = tasks.front();
+			if (!task)
+			{
+				task = sharedTask;
+			}
+			else if (!ownQueue || !ownQueue->Push(sharedTask))
+			{
+				break;
+			}
+			tasks.pop();
+			m_taskCounts[lane]--;
+		}
+		lock.unlock();
+
+		if (ownQueue && !ownQueue->IsEmpty())
+		{
+			Wake();
+		}
+
+		return task;
+	}
+
+	Task* Threading::Steal(int workerIndex, int lane)
+	{
+		// Start from a different victim every time to spread the contention
+		static thread_local unsigned int seed = (unsigned int)(workerIndex + 1) * 2654435761u;
+		seed = seed * 1664525u + 1013904223u;
+		int start = (int)(seed % (unsigned int)m_threadCount);
+
+		for (int i = 0; i < m_threadCount; i++)
+		{
+			int victim = (start + i) % m_threadCount;
+			if (victim == workerIndex)
+				continue;
+
+			if (Task* task = GetQueue(victim, lane)->Steal())
+			{
+				GetCounters(workerIndex).tasksStolen.fetch_add(1, memory_order_relaxed);
+				return task;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void Threading::Wake()
+	{
+		// m_pendingTasks is incremented before checking for sleepers and a sleeping
+		// thread increments m_sleepingThreads before checking m_pendingTasks (both
+		// sequentially consistent), so at least one side always sees the other.
+		if (m_sleepingThreads == 0)
+			return;
+
+		// Taking the mutex guarantees the sleeper is actually waiting when we notify
+		{ lock_guard<mutex> lock(m_tasksMutex); }
+		m_conditionVar.notify_one();
+	}
+
+	vector<WorkerStats> Threading::GetWorkerStats()
+	{
+		double elapsedMs = (Now() - m_statsResetTime) / 1000000.0;
+
+		vector<WorkerStats> stats(m_threadCount + 1);
+		for (int i = 0; i <= m_threadCount; i++)
+		{
+			const WorkerCounters& counters = m_counters[i];
+			WorkerStats& stat = stats[i];
+
+			stat.tasksExecuted = counters.tasksExecuted.load(memory_order_relaxed);
+			stat.tasksStolen = counters.tasksStolen.load(memory_order_relaxed);
+			stat.busyMs = counters.busyNs.load(memory_order_relaxed) / 1000000.0;
+			stat.sleepMs = counters.sleepNs.load(memory_order_relaxed) / 1000000.0;
+			stat.waitMs = counters.waitNs.load(memory_order_relaxed) / 1000000.0;
+			stat.elapsedMs = elapsedMs;
+			stat.averageLatencyUs = stat.tasksExecuted ? counters.latencyNs.load(memory_order_relaxed) / 1000.0 / stat.tasksExecuted : 0.0;
+			for (int bucket = 0; bucket < LATENCY_BUCKETS; bucket++)
+			{
+				stat.latencyHistogram[bucket] = counters.latencyHistogram[bucket].load(memory_order_relaxed);
+			}
+			stat.peakQueueDepth = counters.peakQueueDepth.load(memory_order_relaxed);
+		}
+
+		return stats;
+	}
+
+	void Threading::ResetStats()
+	{
+		for (int i = 0; i <= m_threadCount; i++)
+		{
+			WorkerCounters& counters = m_counters[i];
+			counters.tasksExecuted = 0;
+			counters.tasksStolen = 0;
+			counters.busyNs = 0;
+			counters.sleepNs = 0;
+			counters.waitNs = 0;
+			counters.latencyNs = 0;
+			for (auto& bucket : counters.latencyHistogram)
+			{
+				bucket = 0;
+			}
+			counters.peakQueueDepth = 0;
+		}
+		m_statsResetTime = Now();
+	}
+
+	bool Threading::SaveStats(const string& filePath)
+	{
+		ofstream out(filePath, ios::out | ios::trunc);
+		if (!out.is_open())
+		{
+			LOG_ERROR("Threading: Failed to save stats to \"" + filePath + "\"");
+			return false;
+		}
+
+		vector<WorkerStats> stats = GetWorkerStats();
+		bool json = FileSystem::GetExtensionFromFilePath(filePath) == ".json";
+		out << fixed << setprecision(3);
+
+		if (json)
+		{
+			out << "{\n\t\"workers\": [\n";
+		}
+		else
+		{
+			out << "worker,tasks_executed,tasks_stolen,busy_ms,sleep_ms,wait_ms,elapsed_ms,utilization,avg_latency_us,peak_queue_depth";
+			for (int bucket = 0; bucket < LATENCY_BUCKETS - 1; bucket++)
+			{
+				out << ",latency_lt_" << (1 << bucket) << "us";
+			}
+			out << ",latency_ge_" << (1 << (LATENCY_BUCKETS - 2)) << "us";
+			out << "\n";
+		}
+
+		for (size_t i = 0; i < stats.size(); i++)
+		{
+			const WorkerStats& stat = stats[i];
+			string name = i < (size_t)m_threadCount ? to_string(i) : "external";
+
+			if (json)
+			{
+				out << "\t\t{ \"worker\": \"" << name << "\""
+					<< ", \"tasks_executed\": " << stat.tasksExecuted
+					<< ", \"tasks_stolen\": " << stat.tasksStolen
+					<< ", \"busy_ms\": " << stat.busyMs
+					<< ", \"sleep_ms\": " << stat.sleepMs
+					<< ", \"wait_ms\": " << stat.waitMs
+					<< ", \"elapsed_ms\": " << stat.elapsedMs
+					<< ", \"utilization\": " << stat.GetUtilization()
+					<< ", \"avg_latency_us\": " << stat.averageLatencyUs
+					<< ", \"peak_queue_depth\": " << stat.peakQueueDepth
+					<< ", \"latency_histogram\": [";
+				for (int bucket = 0; bucket < LATENCY_BUCKETS; bucket++)
+				{
+					out << (bucket ? ", " : "") << stat.latencyHistogram[bucket];
+				}
+				out << "] }" << (i + 1 < stats.size() ? "," : "") << "\n";
+			}
+			else
+			{
+				out << name << "," << stat.tasksExecuted << "," << stat.tasksStolen << "," << stat.busyMs << "," << stat.sleepMs << ","
+					<< stat.waitMs << "," << stat.elapsedMs << "," << stat.GetUtilization() << "," << stat.averageLatencyUs << "," << stat.peakQueueDepth;
+				for (int bucket = 0; bucket < LATENCY_BUCKETS; bucket++)
+				{
+					out << "," << stat.latencyHistogram[bucket];
+				}
+				out << "\n";
+			}
+		}
+
+		if (json)
+		{
+			out << "\t]\n}\n";
+		}
+
+		return true;
+	}
+
+	void Threading::UpdatePeak(atomic<int>& peak, int value)
+	{
+		int current = peak.load(memory_order_relaxed);
+		while (value > current && !peak.compare_exchange_weak(current, value, memory_order_relaxed)) {}
 	}
 }
\ No newline at end of file
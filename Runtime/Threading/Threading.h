@@ -21,34 +21,232 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
-//= INCLUDES =================
+//= INCLUDES =====================
 #include <vector>
+#include <algorithm>
 #include <thread>
 #include <mutex>
 #include <queue>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <condition_variable>
+#include "WorkStealingQueue.h"
 #include "../Core/Subsystem.h"
-//============================
+//================================
 
 namespace Directus
 {
+	class Threading;
+
+	// Workers always pick the most urgent task available, anything
+	// that isn't latency sensitive (e.g. streaming) should go last.
+	enum TaskPriority
+	{
+		Priority_Critical,
+		Priority_Normal,
+		Priority_Background,
+		Priority_Count
+	};
+
+	//= CANCELLATION TOKEN ====================================================================
+	// Shared by everybody that copies it. A task whose token is cancelled before it starts
+	// is skipped, a running task has to poll IsCancelled() and bail out on its own.
+	class DLL_API CancellationToken
+	{
+	public:
+		CancellationToken() { m_cancelled = std::make_shared<std::atomic<bool>>(false); }
+
+		void Cancel() { m_cancelled->store(true, std::memory_order_release); }
+		bool IsCancelled() const { return m_cancelled->load(std::memory_order_acquire); }
+		bool operator==(const CancellationToken& other) const { return m_cancelled == other.m_cancelled; }
+
+	private:
+		friend class Threading;
+		std::shared_ptr<std::atomic<bool>> m_cancelled;
+	};
+	//=========================================================================================
+
 	//= TASK ==================================================================================
-	class Task
+	// Tasks are recycled through a pool and reference counted by hand, so adding one
+	// doesn't touch the heap. Callables up to INLINE_SIZE bytes (a lambda capturing a few
+	// pointers or a string) are stored in place, larger ones fall back to the heap.
+	class DLL_API Task
+	{
+	public:
+		static const size_t INLINE_SIZE = 64;
+
+		Task();
+		~Task();
+
+		void Execute() { m_invoke(&m_storage); }
+		bool IsDone() { return m_done.load(std::memory_order_acquire); }
+
+	private:
+		friend class Threading;
+		friend class TaskHandle;
+
+		// Takes a task from the calling thread's pool and gives it back
+		static Task* Allocate();
+		static void Free(Task* task);
+
+		template <typename Function>
+		void SetFunction(Function&& function)
+		{
+			typedef typename std::decay<Function>::type functionType;
+			SetFunction(std::forward<Function>(function), std::integral_constant<bool,
+				sizeof(functionType) <= INLINE_SIZE && alignof(functionType) <= alignof(storageType)>());
+		}
+
+		template <typename Function>
+		void SetFunction(Function&& function, std::true_type /*fits inline*/)
+		{
+			typedef typename std::decay<Function>::type functionType;
+			new (&m_storage) functionType(std::forward<Function>(function));
+			m_invoke = [](void* storage) { (*static_cast<functionType*>(storage))(); };
+			m_destroy = [](void* storage) { static_cast<functionType*>(storage)->~functionType(); };
+		}
+
+		template <typename Function>
+		void SetFunction(Function&& function, std::false_type /*fits inline*/)
+		{
+			typedef typename std::decay<Function>::type functionType;
+			*reinterpret_cast<functionType**>(&m_storage) = new functionType(std::forward<Function>(function));
+			m_invoke = [](void* storage) { (**static_cast<functionType**>(storage))(); };
+			m_destroy = [](void* storage) { delete *static_cast<functionType**>(storage); };
+		}
+
+		// Destroys the callable, captures are released as soon as the task has run
+		void ResetFunction()
+		{
+			if (m_destroy)
+			{
+				m_destroy(&m_storage);
+				m_destroy = nullptr;
+			}
+			m_invoke = nullptr;
+		}
+
+		void AddRef() { m_refCount.fetch_add(1, std::memory_order_relaxed); }
+		void Release()
+		{
+			if (m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				Free(this);
+			}
+		}
+
+		typedef std::aligned_storage<INLINE_SIZE, alignof(std::max_align_t)>::type storageType;
+		storageType m_storage;
+		void(*m_invoke)(void*);
+		void(*m_destroy)(void*);
+
+		// Held by handles, queues and the dependents list of other tasks
+		std::atomic<int> m_refCount;
+
+		// Prerequisites which haven't finished yet, the task gets queued when this hits zero
+		std::atomic<int> m_unfinishedDependencies;
+		std::atomic<bool> m_done;
+
+		// Tasks waiting for this one to finish (each holds a reference).
+		// The vector keeps its capacity when the task gets recycled.
+		std::vector<Task*> m_dependents;
+		std::mutex m_dependentsMutex;
+
+		// When the task was queued, for the latency stats
+		int64_t m_enqueueTime;
+
+		TaskPriority m_priority;
+		// Empty unless the task was given a cancellation token
+		std::shared_ptr<std::atomic<bool>> m_cancelled;
+	};
+	//=========================================================================================
+
+	//= WORKER STATS ==========================================================================
+	// A snapshot of what a worker has been doing since the stats were last reset.
+	// Latency is the time between a task being queued and it starting to run,
+	// bucket i of the histogram counts tasks which waited less than 2^i microseconds
+	// (the last bucket takes everything above).
+	static const int LATENCY_BUCKETS = 16;
+
+	struct WorkerStats
+	{
+		uint64_t tasksExecuted;
+		uint64_t tasksStolen;
+		double busyMs;		// Running tasks
+		double sleepMs;		// Blocked on the condition variable, nothing to do
+		double waitMs;		// Blocked in Wait(), nothing to help with
+		double elapsedMs;	// Since the stats were reset
+		double averageLatencyUs;
+		uint64_t latencyHistogram[LATENCY_BUCKETS];
+		int peakQueueDepth;
+
+		double GetUtilization() const { return elapsedMs > 0.0 ? busyMs / elapsedMs : 0.0; }
+	};
+	//=========================================================================================
+
+	//= TASK HANDLE ===========================================================================
+	// A lightweight reference to a task that was added to the Threading subsystem.
+	// It can be waited on, polled, or used to chain or gate other tasks.
+	class DLL_API TaskHandle
 	{
 	public:
-		typedef std::function<void()> functionType;
+		TaskHandle() { m_task = nullptr; m_threading = nullptr; }
+		TaskHandle(Task* task, Threading* threading)
+		{
+			m_task = task;
+			m_threading = threading;
+			if (m_task) m_task->AddRef();
+		}
+		TaskHandle(const TaskHandle& other)
+		{
+			m_task = other.m_task;
+			m_threading = other.m_threading;
+			if (m_task) m_task->AddRef();
+		}
+		TaskHandle(TaskHandle&& other)
+		{
+			m_task = other.m_task;
+			m_threading = other.m_threading;
+			other.m_task = nullptr;
+		}
+		~TaskHandle() { if (m_task) m_task->Release(); }
+
+		TaskHandle& operator=(TaskHandle other)
+		{
+			std::swap(m_task, other.m_task);
+			std::swap(m_threading, other.m_threading);
+			return *this;
+		}
+
+		// An invalid handle behaves like a task that has already finished
+		bool IsValid() const { return m_task != nullptr; }
+		bool IsDone() const { return !m_task || m_task->IsDone(); }
 
-		Task(functionType&& function) { m_function = std::forward<functionType>(function); }
-		void Execute() { m_function(); }
+		// Blocks until the task has finished (the calling thread helps with other tasks meanwhile)
+		void Wait() const;
+
+		// Adds a task that will run once this one has finished (does nothing on an invalid handle)
+		template <typename Function>
+		TaskHandle Then(Function&& function) const;
 
 	private:
-		functionType m_function;
+		friend class Threading;
+
+		Task* m_task;
+		Threading* m_threading;
 	};
 	//=========================================================================================
 
-	class Threading : public Subsystem
+	class DLL_API Threading : public Subsystem
 	{
 	public:
-		Threading(Context* context);
+		// A thread count of zero leaves a core for the main thread and uses the rest
+		Threading(Context* context, int threadCount = 0);
 		~Threading();
 
 		//= Subsystem ============
@@ -56,31 +254,246 @@ namespace Directus
 		//========================
 
 		// This function is invoked by the threads
-		void Invoke();
+		void Invoke(int workerIndex);
 
 		// Add a task
 		template <typename Function>
-		void AddTask(Function&& function)
+		TaskHandle AddTask(Function&& function)
+		{
+			return AddTask(std::forward<Function>(function), std::vector<TaskHandle>());
+		}
+
+		// Add a task which will only run after all of its dependencies have finished
+		template <typename Function>
+		TaskHandle AddTask(Function&& function, const std::vector<TaskHandle>& dependencies)
+		{
+			return AddTask(std::forward<Function>(function), dependencies, Priority_Normal, nullptr);
+		}
+
+		// Add a task with a priority, which will be skipped if the token gets cancelled before it starts
+		template <typename Function>
+		TaskHandle AddTask(Function&& function, TaskPriority priority, const CancellationToken& token)
+		{
+			return AddTask(std::forward<Function>(function), std::vector<TaskHandle>(), priority, &token);
+		}
+
+		template <typename Function>
+		TaskHandle AddTask(Function&& function, const std::vector<TaskHandle>& dependencies, TaskPriority priority, const CancellationToken* token)
 		{
-			// Lock tasks mutex
-			std::unique_lock<std::mutex> lock(m_tasksMutex);
+			Task* task = Task::Allocate();
+			task->SetFunction(std::forward<Function>(function));
+			task->m_priority = priority;
+			if (token)
+			{
+				task->m_cancelled = token->m_cancelled;
+			}
+
+			// The handle takes its reference before the task can run and be released
+			TaskHandle handle(task, this);
+			Schedule(task, dependencies);
+			return handle;
+		}
 
-			// Save the task
-			m_tasks.push(std::make_shared<Task>(std::bind(std::forward<Function>(function))));
+		// Blocks until all the given tasks have finished
+		void WaitAll(const std::vector<TaskHandle>& tasks);
 
-			// Unlock the mutex
-			lock.unlock();
+		// Blocks until the task has finished, executing other tasks in the meantime
+		void Wait(const TaskHandle& task);
 
-			// Wake up a thread
-			m_conditionVar.notify_one();
+		// Calls function(i) for every i in [begin, end), spread across the workers.
+		// Ranges that fit in a single grain run inline on the calling thread.
+		template <typename Function>
+		void ParallelFor(size_t begin, size_t end, size_t grainSize, Function&& function)
+		{
+			ParallelChunks(begin, end, grainSize, [&function](size_t chunkBegin, size_t chunkEnd, size_t)
+			{
+				for (size_t i = chunkBegin; i < chunkEnd; i++)
+				{
+					function(i);
+				}
+			});
 		}
 
+		// Splits [begin, end) into chunks, calls function(chunkBegin, chunkEnd) -> T for each of
+		// them in parallel and folds the results with combine(T, T), in chunk order so that
+		// the result is deterministic.
+		template <typename T, typename Function, typename Combine>
+		T ParallelReduce(size_t begin, size_t end, size_t grainSize, T identity, Function&& function, Combine&& combine)
+		{
+			// Wrapped so that a vector<bool> specialization can't make neighbouring chunks share bytes
+			struct Partial { T value; };
+			std::vector<Partial> partials(ChunkCount(begin, end, grainSize), Partial{ identity });
+			ParallelChunks(begin, end, grainSize, [&function, &partials](size_t chunkBegin, size_t chunkEnd, size_t chunkIndex)
+			{
+				partials[chunkIndex].value = function(chunkBegin, chunkEnd);
+			});
+
+			T result = identity;
+			for (const auto& partial : partials)
+			{
+				result = combine(result, partial.value);
+			}
+
+			return result;
+		}
+
+		// Returns the number of worker threads
+		int GetThreadCount() { return m_threadCount; }
+		// True on the thread which created the subsystem, the engine's main thread
+		bool IsMainThread() const { return std::this_thread::get_id() == m_mainThreadID; }
+
+		//= STATS ===========================================================================
+		// One entry per worker plus a last one for the threads which are not workers (e.g. the
+		// main thread helping from Wait()), its queue depth is the one of the shared queue.
+		std::vector<WorkerStats> GetWorkerStats();
+		void ResetStats();
+		// Writes the stats as JSON if the extension is .json, as CSV otherwise
+		bool SaveStats(const std::string& filePath);
+		// The stats get saved here on shutdown, nothing gets saved if empty
+		void SetStatsFilePath(const std::string& filePath) { m_statsFilePath = filePath; }
+		//===================================================================================
+
 	private:
-		int m_threadCount = 5;
+		// Number of chunks ParallelChunks() will split a range into
+		size_t ChunkCount(size_t begin, size_t end, size_t grainSize)
+		{
+			if (end <= begin)
+				return 0;
+
+			size_t count = end - begin;
+			size_t chunkSize = ChunkSize(count, grainSize);
+			return (count + chunkSize - 1) / chunkSize;
+		}
+
+		// Aims for a few chunks per thread so that uneven work still balances,
+		// but never goes below the grain size the caller asked for.
+		size_t ChunkSize(size_t count, size_t grainSize)
+		{
+			size_t targetChunks = (size_t)(m_threadCount + 1) * 4;
+			size_t chunkSize = (count + targetChunks - 1) / targetChunks;
+			return chunkSize > grainSize ? chunkSize : (grainSize > 0 ? grainSize : 1);
+		}
+
+		// Calls function(chunkBegin, chunkEnd, chunkIndex) for every chunk. Chunks are claimed
+		// dynamically by the helper tasks and by the calling thread, which also waits for them.
+		template <typename Function>
+		void ParallelChunks(size_t begin, size_t end, size_t grainSize, const Function& function)
+		{
+			size_t chunkCount = ChunkCount(begin, end, grainSize);
+			if (chunkCount == 0)
+				return;
+
+			size_t chunkSize = ChunkSize(end - begin, grainSize);
+
+			// Small enough, don't bother with the workers
+			if (chunkCount == 1 || m_threads.empty())
+			{
+				for (size_t chunk = 0; chunk < chunkCount; chunk++)
+				{
+					size_t chunkBegin = begin + chunk * chunkSize;
+					function(chunkBegin, (std::min)(chunkBegin + chunkSize, end), chunk);
+				}
+				return;
+			}
+
+			std::atomic<size_t> nextChunk(0);
+			auto worker = [&]()
+			{
+				for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+				{
+					size_t chunkBegin = begin + chunk * chunkSize;
+					function(chunkBegin, (std::min)(chunkBegin + chunkSize, end), chunk);
+				}
+			};
+
+			// The calling thread takes part too, so one helper less. The helpers are as urgent as the caller:
+			// critical for the main thread and frame jobs, while a background load's loops stay in the background.
+			size_t helperCount = (std::min)(chunkCount - 1, (size_t)m_threadCount);
+			TaskPriority priority = GetCallerPriority();
+			std::vector<TaskHandle> helpers;
+			helpers.reserve(helperCount);
+			for (size_t i = 0; i < helperCount; i++)
+			{
+				helpers.emplace_back(AddTask(worker, std::vector<TaskHandle>(), priority, nullptr));
+			}
+
+			worker();
+			WaitAll(helpers);
+		}
+
+
+		// The priority of the task running on the calling thread, critical outside of any task
+		TaskPriority GetCallerPriority();
+
+		// Hooks the task to its dependencies, queues it if there are none left
+		void Schedule(Task* task, const std::vector<TaskHandle>& dependencies);
+
+		// Pushes a task to the calling worker's deque, or to the
+		// shared queue if the caller is not one of our workers.
+		void Enqueue(Task* task);
+
+		// Executes a task and releases any tasks that depend on it
+		void Run(Task* task);
+
+		// Looks for work, most urgent lane first: own deque, then the shared queue, then other workers.
+		// Lanes less urgent than lastLane are left alone.
+		Task* Acquire(int workerIndex, int lastLane = Priority_Count - 1);
+		Task* AcquireShared(int workerIndex, int lane);
+		Task* Steal(int workerIndex, int lane);
+		void Wake();
+		WorkStealingQueue<Task>* GetQueue(int workerIndex, int lane) { return m_workerQueues[workerIndex * Priority_Count + lane].get(); }
+
+		// Counters are only ever incremented, relaxed and mostly by a single thread, so
+		// they stay cheap enough to leave on. The padding keeps slots off each other's cache lines.
+		struct WorkerCounters
+		{
+			std::atomic<uint64_t> tasksExecuted;
+			std::atomic<uint64_t> tasksStolen;
+			std::atomic<int64_t> busyNs;
+			std::atomic<int64_t> sleepNs;
+			std::atomic<int64_t> waitNs;
+			std::atomic<int64_t> latencyNs;
+			std::atomic<uint64_t> latencyHistogram[LATENCY_BUCKETS];
+			std::atomic<int> peakQueueDepth;
+			char padding[64];
+		};
+		WorkerCounters& GetCounters(int workerIndex) { return m_counters[workerIndex != -1 ? workerIndex : m_threadCount]; }
+		static void UpdatePeak(std::atomic<int>& peak, int value);
+
+		int m_threadCount;
+		std::thread::id m_mainThreadID;
 		std::vector<std::thread> m_threads;
-		std::queue<std::shared_ptr<Task>> m_tasks;
+
+		// One deque per worker and priority, only the owner pushes/pops, everybody can steal
+		std::vector<std::unique_ptr<WorkStealingQueue<Task>>> m_workerQueues;
+
+		// Tasks added by threads which are not workers (e.g. the main thread), one queue
+		// per priority. The sizes can be peeked at without taking the mutex.
+		std::queue<Task*> m_tasks[Priority_Count];
+		std::atomic<int> m_taskCounts[Priority_Count];
 		std::mutex m_tasksMutex;
 		std::condition_variable m_conditionVar;
-		bool m_stopping;
+
+		// Used by threads blocked in Wait()
+		std::mutex m_waitMutex;
+		std::condition_variable m_waitVar;
+		std::atomic<int> m_waitingThreads;
+
+		std::atomic<int> m_pendingTasks;
+		std::atomic<int> m_sleepingThreads;
+		std::atomic<bool> m_stopping;
+
+		std::unique_ptr<WorkerCounters[]> m_counters;
+		int64_t m_statsResetTime;
+		std::string m_statsFilePath;
 	};
+
+	template <typename Function>
+	TaskHandle TaskHandle::Then(Function&& function) const
+	{
+		if (!m_threading)
+			return TaskHandle();
+
+		return m_threading->AddTask(std::forward<Function>(function), { *this });
+	}
 }
\ No newline at end of file
@@ -0,0 +1,137 @@
+/*
+Copyright(c) 2016-2017 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==========
+#include <atomic>
+#include <cstdint>
+//=====================
+
+namespace Directus
+{
+	// A fixed capacity Chase-Lev deque. The owning thread pushes and pops
+	// at the bottom, any other thread may steal from the top. Push, pop
+	// and steal are lock-free, only a pop that races a steal for the last
+	// element resolves with a single CAS.
+	template <typename T, int Capacity = 4096>
+	class WorkStealingQueue
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	public:
+		WorkStealingQueue()
+		{
+			m_top = 0;
+			m_bottom = 0;
+			for (auto& item : m_items)
+			{
+				item.store(nullptr, std::memory_order_relaxed);
+			}
+		}
+
+		// Owner thread only. Returns false if the queue is full.
+		bool Push(T* item)
+		{
+			int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+			int64_t top = m_top.load(std::memory_order_acquire);
+
+			if (bottom - top >= Capacity)
+				return false;
+
+			m_items[bottom & m_mask].store(item, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+			return true;
+		}
+
+		// Owner thread only. Returns nullptr if the queue is empty.
+		T* Pop()
+		{
+			int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			m_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = m_top.load(std::memory_order_relaxed);
+
+			// Empty, restore the bottom
+			if (top > bottom)
+			{
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T* item = m_items[bottom & m_mask].load(std::memory_order_relaxed);
+
+			// More than one item left, no thief can reach this one
+			if (top != bottom)
+				return item;
+
+			// Last item, race any thief for it
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				item = nullptr;
+			}
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+			return item;
+		}
+
+		// Any thread. Returns nullptr if the queue is empty or the steal lost a race.
+		T* Steal()
+		{
+			int64_t top = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+				return nullptr;
+
+			T* item = m_items[top & m_mask].load(std::memory_order_relaxed);
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return item;
+		}
+
+		// Approximate, only meant for heuristics
+		bool IsEmpty()
+		{
+			return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+		}
+
+		// Approximate, only meant for heuristics and stats
+		int Size()
+		{
+			int64_t size = m_bottom.load(std::memory_order_relaxed) - m_top.load(std::memory_order_relaxed);
+			return size > 0 ? (int)size : 0;
+		}
+
+	private:
+		static const int64_t m_mask = Capacity - 1;
+
+		// Top and bottom live on separate cache lines as they
+		// are written by different threads.
+		alignas(64) std::atomic<int64_t> m_top;
+		alignas(64) std::atomic<int64_t> m_bottom;
+		alignas(64) std::atomic<T*> m_items[Capacity];
+	};
+}
@@ -41,6 +41,25 @@ filter "configurations:Debug"
 	defines { "DEBUG" }
 	symbols "On"
 		 
+filter "configurations:Release"
+	defines { "NDEBUG" }
+	optimize "Full"
+
+-- Benchmarks, a console application which links against the runtime
+filter {}
+project "Benchmarks"
+	kind "ConsoleApp"
+	language "C++"
+	files { "../Benchmarks/**.h", "../Benchmarks/**.cpp" }
+	includedirs { "." }
+	links { PROJECT_NAME }
+	targetdir "../Binaries/%{cfg.buildcfg}"
+	objdir "../Binaries/VS_Obj/Benchmarks/%{cfg.buildcfg}"
+
+filter "configurations:Debug"
+	defines { "DEBUG" }
+	symbols "On"
+
 filter "configurations:Release"
 	defines { "NDEBUG" }
 	optimize "Full"
\ No newline at end of file